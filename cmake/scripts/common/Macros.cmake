@@ -117,6 +117,25 @@ function(core_add_test_library name)
   endforeach()
 endfunction()
 
+# Add a benchmark library, and add sources to list for the benchmark executable
+function(core_add_bench_library name)
+  if(ENABLE_STATIC_LIBS)
+    add_library(${name} STATIC ${SOURCES} ${HEADERS} ${OTHERS})
+    set_target_properties(${name} PROPERTIES PREFIX ""
+                                             EXCLUDE_FROM_ALL 1
+                                             FOLDER "Build Utilities/benchmarks")
+
+    if(NOT MSVC)
+      target_compile_options(${name} PUBLIC ${CORE_COMPILE_OPTIONS})
+    endif()
+
+  endif()
+  foreach(src IN LISTS SOURCES HEADERS OTHERS)
+    get_filename_component(src_path "${src}" ABSOLUTE)
+    set(bench_sources "${src_path}" ${bench_sources} CACHE STRING "" FORCE)
+  endforeach()
+endfunction()
+
 # Add addon dev kit headers to main application
 # Arguments:
 #   name name of the header part to add
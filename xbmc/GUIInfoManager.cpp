@@ -17,6 +17,8 @@
 #include "cores/DataCacheCore.h"
 #include "filesystem/File.h"
 #include "games/tags/GameInfoTag.h"
+#include "guilib/GUIComponent.h"
+#include "guilib/GUIWindowManager.h"
 #include "guilib/guiinfo/GUIInfo.h"
 #include "guilib/guiinfo/GUIInfoHelper.h"
 #include "guilib/guiinfo/GUIInfoLabels.h"
@@ -11474,6 +11476,106 @@ bool CGUIInfoManager::EvaluateBool(const std::string& expression,
   return false;
 }
 
+INFO::InfoSource CGUIInfoManager::GetInfoSource(int condition) const
+{
+  condition = std::abs(condition);
+  if (condition == SYSTEM_ALWAYS_TRUE || condition == SYSTEM_ALWAYS_FALSE)
+    return InfoSource::CONSTANT;
+
+  if (condition >= MULTI_INFO_START && condition <= MULTI_INFO_END)
+    condition = m_multiInfo[condition - MULTI_INFO_START].GetInfo();
+
+  switch (condition)
+  {
+    case SKIN_BOOL:
+    case SKIN_STRING:
+    case SKIN_STRING_IS_EQUAL:
+      return InfoSource::SKIN_SETTINGS;
+    case PLAYER_HAS_MEDIA:
+    case PLAYER_HAS_AUDIO:
+    case PLAYER_HAS_VIDEO:
+    case PLAYER_HAS_GAME:
+    case PLAYER_PLAYING:
+    case PLAYER_PAUSED:
+    case PLAYER_REWINDING:
+    case PLAYER_FORWARDING:
+    case PLAYER_REWINDING_2x:
+    case PLAYER_REWINDING_4x:
+    case PLAYER_REWINDING_8x:
+    case PLAYER_REWINDING_16x:
+    case PLAYER_REWINDING_32x:
+    case PLAYER_FORWARDING_2x:
+    case PLAYER_FORWARDING_4x:
+    case PLAYER_FORWARDING_8x:
+    case PLAYER_FORWARDING_16x:
+    case PLAYER_FORWARDING_32x:
+      return InfoSource::PLAYER_STATE;
+    case WINDOW_IS_MEDIA:
+    case WINDOW_IS_VISIBLE:
+    case WINDOW_IS_ACTIVE:
+    case WINDOW_IS_DIALOG_TOPMOST:
+    case WINDOW_IS_MODAL_DIALOG_TOPMOST:
+    case SYSTEM_HAS_ACTIVE_MODAL_DIALOG:
+    case SYSTEM_HAS_VISIBLE_MODAL_DIALOG:
+      return InfoSource::ACTIVE_WINDOWS;
+    default:
+      break;
+  }
+
+  return InfoSource::DYNAMIC;
+}
+
+unsigned int CGUIInfoManager::GetSourceCounter(InfoSource source)
+{
+  switch (source)
+  {
+    case InfoSource::SKIN_SETTINGS:
+      return m_skinSettingsCounter;
+    case InfoSource::PLAYER_STATE:
+      UpdateSourceCounters();
+      return m_playerStateCounter;
+    case InfoSource::ACTIVE_WINDOWS:
+      UpdateSourceCounters();
+      return m_activeWindowsCounter;
+    default:
+      return 0;
+  }
+}
+
+void CGUIInfoManager::UpdateSourceCounters()
+{
+  std::unique_lock lock(m_critInfo);
+  if (m_sourcesCompared && m_sourcesRefreshCounter == m_refreshCounter)
+    return;
+
+  m_sourcesCompared = true;
+  m_sourcesRefreshCounter = m_refreshCounter;
+
+  const auto appPlayer = CServiceBroker::GetAppComponents().GetComponent<CApplicationPlayer>();
+  PlayerState playerState;
+  playerState.playing = appPlayer->IsPlaying();
+  if (playerState.playing)
+  {
+    playerState.playingAudio = appPlayer->IsPlayingAudio();
+    playerState.playingVideo = appPlayer->IsPlayingVideo();
+    playerState.playingGame = appPlayer->IsPlayingGame();
+    playerState.paused = appPlayer->IsPausedPlayback();
+  }
+  playerState.speed = appPlayer->GetPlaySpeed();
+  if (playerState != m_playerState)
+  {
+    m_playerState = playerState;
+    ++m_playerStateCounter;
+  }
+
+  CServiceBroker::GetGUI()->GetWindowManager().GetActiveWindowsState(m_newActiveWindowsState);
+  if (m_newActiveWindowsState != m_activeWindowsState)
+  {
+    m_activeWindowsState.swap(m_newActiveWindowsState);
+    ++m_activeWindowsCounter;
+  }
+}
+
 bool CGUIInfoManager::GetBool(int condition1, int contextWindow, const CGUIListItem *item)
 {
   bool bReturn = false;
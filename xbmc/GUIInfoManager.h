@@ -14,6 +14,7 @@
 #include "messaging/IMessageTarget.h"
 #include "threads/CriticalSection.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -59,6 +60,19 @@ public:
   void Clear();
   void ResetCache();
 
+  /*! \brief Mark conditions depending on skin settings as dirty, to be called whenever a skin setting changes
+   \sa GetSourceCounter
+   */
+  void SkinSettingsChanged() { ++m_skinSettingsCounter; }
+
+  /*! \brief Get a counter that changes whenever the given source of conditions changes
+   Skin settings report their changes, player state and active windows are compared with their
+   state in the previous frame the first time they are asked for in a frame.
+   \param source the source, anything but DYNAMIC and CONSTANT
+   \sa GetInfoSource
+   */
+  unsigned int GetSourceCounter(INFO::InfoSource source);
+
   // KODI::MESSAGING::IMessageTarget implementation
   int GetMessageMask() override;
   void OnApplicationMessage(KODI::MESSAGING::ThreadMessage* pMsg) override;
@@ -98,6 +112,12 @@ public:
   int TranslateString(const std::string &strCondition);
   int TranslateSingleString(const std::string &strCondition, bool &listItemDependent);
 
+  /*! \brief Find out what a translated condition depends on
+   \param condition the condition as returned by TranslateSingleString
+   \return the source of the condition, DYNAMIC unless it is known to change less often
+   */
+  INFO::InfoSource GetInfoSource(int condition) const;
+
   std::string GetLabel(int info, int contextWindow, std::string* fallback = nullptr) const;
   std::string GetImage(int info, int contextWindow, std::string *fallback = nullptr);
   bool GetInt(int& value, int info, int contextWindow, const CGUIListItem* item = nullptr) const;
@@ -225,6 +245,29 @@ private:
 
   INFOBOOLTYPE m_bools{&CGUIInfoManager::InfoBoolComparator};
   unsigned int m_refreshCounter = 0;
+  std::atomic<unsigned int> m_skinSettingsCounter{0};
+
+  void UpdateSourceCounters();
+
+  struct PlayerState
+  {
+    bool playing = false;
+    bool playingAudio = false;
+    bool playingVideo = false;
+    bool playingGame = false;
+    bool paused = false;
+    float speed = 1.0f;
+
+    bool operator==(const PlayerState& right) const = default;
+  };
+
+  unsigned int m_sourcesRefreshCounter = 0; ///< m_refreshCounter when the sources were compared
+  bool m_sourcesCompared = false;
+  PlayerState m_playerState;
+  unsigned int m_playerStateCounter = 0;
+  std::vector<int> m_activeWindowsState;
+  std::vector<int> m_newActiveWindowsState; ///< kept to avoid reallocating it every frame
+  unsigned int m_activeWindowsCounter = 0;
   std::vector<INFO::CSkinVariableString> m_skinVariableStrings;
 
   CCriticalSection m_critInfo;
@@ -10,6 +10,7 @@
 
 #include "FileItem.h"
 #include "FileItemList.h"
+#include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "Util.h"
 #include "addons/addoninfo/AddonType.h"
@@ -61,6 +62,14 @@ constexpr const char* XML_ATTR_ID = "id";
 
 constexpr auto DELAY = 500ms;
 
+// conditions on skin settings are only re-evaluated after they changed
+void NotifySkinSettingsChanged()
+{
+  CGUIComponent* gui = CServiceBroker::GetGUI();
+  if (gui)
+    gui->GetInfoManager().SkinSettingsChanged();
+}
+
 } // unnamed namespace
 
 namespace ADDON
@@ -688,6 +697,7 @@ void CSkinInfo::SetString(int setting, std::string_view label)
   if (it != m_strings.end())
   {
     it->second->value = label;
+    NotifySkinSettingsChanged();
     m_settingsUpdateHandler->TriggerSave();
     return;
   }
@@ -732,6 +742,7 @@ void CSkinInfo::SetBool(int setting, bool set)
   if (it != m_bools.end())
   {
     it->second->value = set;
+    NotifySkinSettingsChanged();
     m_settingsUpdateHandler->TriggerSave();
     return;
   }
@@ -776,6 +787,7 @@ void CSkinInfo::Reset(const std::string &setting)
     if (StringUtils::EqualsNoCase(setting, settingstring->name))
     {
       settingstring->value.clear();
+      NotifySkinSettingsChanged();
       m_settingsUpdateHandler->TriggerSave();
       return;
     }
@@ -787,6 +799,7 @@ void CSkinInfo::Reset(const std::string &setting)
     if (StringUtils::EqualsNoCase(setting, settingbool->name))
     {
       settingbool->value = false;
+      NotifySkinSettingsChanged();
       m_settingsUpdateHandler->TriggerSave();
       return;
     }
@@ -802,6 +815,7 @@ void CSkinInfo::Reset()
   for (const auto& [_, settingstring] : m_strings)
     settingstring->value.clear();
 
+  NotifySkinSettingsChanged();
   m_settingsUpdateHandler->TriggerSave();
 }
 
@@ -886,6 +900,7 @@ bool CSkinInfo::SettingsFromXML(const CXBMCTinyXML& doc,
                 setting->GetType());
   }
 
+  NotifySkinSettingsChanged();
   return true;
 }
 
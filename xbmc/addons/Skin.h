@@ -157,6 +157,11 @@ public:
   void ResolveIncludes(TiXmlElement* node,
                        std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = nullptr);
 
+  /*! \brief Get the include files that have been loaded for this skin
+   \return the paths of the loaded include files
+   */
+  const std::vector<std::string>& GetIncludeFiles() const { return m_includes.GetFiles(); }
+
   float GetEffectsSlowdown() const { return m_effectsSlowDown; }
 
   const std::vector<CStartupWindow>& GetStartupWindows() const { return m_startupWindows; }
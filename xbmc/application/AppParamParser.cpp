@@ -43,6 +43,10 @@ Arguments:
   --test                Enable test mode. [FILE] required.
   --settings=<filename> Loads specified file after advancedsettings.xml replacing any settings specified
                         specified file must exist in special://xbmc/system/
+  --gui-benchmark=<filename>
+                        Runs the GUI benchmark script in the specified file once the
+                        GUI is up, writes the report to special://logpath/guibenchmark.json
+                        and exits
 )""";
 
 } // namespace
@@ -110,6 +114,8 @@ void CAppParamParser::ParseArg(const std::string &arg)
     m_params->SetTestMode(true);
   else if (arg.substr(0, 11) == "--settings=")
     m_params->SetSettingsFile(arg.substr(11));
+  else if (arg.substr(0, 16) == "--gui-benchmark=")
+    m_params->SetGuiBenchmark(arg.substr(16));
   else if (!arg.empty() && arg[0] != '-')
   {
     const CFileItemPtr item = std::make_shared<CFileItem>(arg);
@@ -56,6 +56,9 @@ public:
   const std::string& GetGlInterface() const { return m_glInterface; }
   void SetGlInterface(const std::string& glInterface) { m_glInterface = glInterface; }
 
+  const std::string& GetGuiBenchmark() const { return m_guiBenchmark; }
+  void SetGuiBenchmark(const std::string& guiBenchmark) { m_guiBenchmark = guiBenchmark; }
+
   CFileItemList& GetPlaylist() const { return *m_playlist; }
 
   /*!
@@ -90,6 +93,7 @@ private:
   std::string m_logTarget;
   std::string m_audioBackend;
   std::string m_glInterface;
+  std::string m_guiBenchmark;
 
   std::unique_ptr<CFileItemList> m_playlist;
 
@@ -75,6 +75,7 @@
 #include "filesystem/SpecialProtocol.h"
 #include "guilib/GUIAudioManager.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/GUIBenchmark.h"
 #include "guilib/GUIControlProfiler.h"
 #include "guilib/GUIFontManager.h"
 #include "guilib/GUIWindowManager.h"
@@ -843,6 +844,7 @@ void CApplication::Render()
     appPower->ResetScreenSaver();
   }
 
+  const auto renderStart = CGUIControlProfiler::BeginFrameStage();
   if (!CServiceBroker::GetRenderSystem()->BeginRender())
     return;
 
@@ -867,6 +869,7 @@ void CApplication::Render()
     }
     // execute post rendering actions (finalize window closing)
     CServiceBroker::GetGUI()->GetWindowManager().AfterRender();
+    CServiceBroker::GetGUI()->GetTextureManager().EndFrame();
 
     m_lastRenderTime = std::chrono::steady_clock::now();
   }
@@ -875,6 +878,7 @@ void CApplication::Render()
   CServiceBroker::GetGUI()->GetWindowManager().RenderEx();
 
   CServiceBroker::GetRenderSystem()->EndRender();
+  GUIPROFILER_FRAME_STAGE(CGUIControlProfiler::FrameStage::RENDER, renderStart);
 
   // reset our info cache - we do this at the end of Render so that it is
   // fresh for the next process(), or after a windowclose animation (where process()
@@ -888,8 +892,13 @@ void CApplication::Render()
     infoMgr.GetInfoProviders().GetSystemInfoProvider().UpdateFPS();
   }
 
+  const auto presentStart = CGUIControlProfiler::BeginFrameStage();
   CServiceBroker::GetWinSystem()->GetGfxContext().Flip(hasRendered,
                                                        appPlayer->IsRenderingVideoLayer());
+  GUIPROFILER_FRAME_STAGE(CGUIControlProfiler::FrameStage::PRESENT, presentStart);
+
+  if (CGUIBenchmark::IsRunning())
+    CGUIBenchmark::Instance().EndFrame();
 
   CTimeUtils::UpdateFrameTime(hasRendered);
 }
@@ -1776,6 +1785,7 @@ void CApplication::UnlockFrameMoveGuard()
 
 void CApplication::FrameMove(bool processEvents, bool processGUI)
 {
+  const auto frameMoveStart = CGUIControlProfiler::BeginFrameStage();
   const auto appPlayer = GetComponent<CApplicationPlayer>();
   bool renderGUI = GetComponent<CApplicationPowerHandling>()->GetRenderGUI();
   if (processEvents)
@@ -1859,7 +1869,11 @@ void CApplication::FrameMove(bool processEvents, bool processGUI)
     if (!m_bStop)
     {
       if (!m_skipGuiRender)
+      {
+        const auto processStart = CGUIControlProfiler::BeginFrameStage();
         CServiceBroker::GetGUI()->GetWindowManager().Process(CTimeUtils::GetFrameTime());
+        GUIPROFILER_FRAME_STAGE(CGUIControlProfiler::FrameStage::PROCESS, processStart);
+      }
     }
     CServiceBroker::GetGUI()->GetWindowManager().FrameMove();
   }
@@ -1868,6 +1882,8 @@ void CApplication::FrameMove(bool processEvents, bool processGUI)
 
   // this will go away when render systems gets its own thread
   CServiceBroker::GetWinSystem()->DriveRenderLoop();
+
+  GUIPROFILER_FRAME_STAGE(CGUIControlProfiler::FrameStage::FRAMEMOVE, frameMoveStart);
 }
 
 
@@ -2528,6 +2544,14 @@ bool CApplication::OnMessage(CGUIMessage& message)
         // e.g. os package manager installation on linux
         ConfigureAndEnableAddons();
 
+        const std::string& benchmark = CServiceBroker::GetAppParams()->GetGuiBenchmark();
+        if (m_bInitializing && !benchmark.empty())
+        {
+          if (!CGUIBenchmark::Instance().Start(
+                  benchmark, CSpecialProtocol::TranslatePath("special://logpath/guibenchmark.json")))
+            CServiceBroker::GetAppMessenger()->PostMsg(TMSG_QUIT);
+        }
+
         m_bInitializing = false;
 
         if (message.GetSenderId() == WINDOW_SETTINGS_PROFILES)
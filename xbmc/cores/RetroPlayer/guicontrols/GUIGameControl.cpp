@@ -13,6 +13,7 @@
 #include "cores/RetroPlayer/RetroPlayerUtils.h"
 #include "cores/RetroPlayer/guibridge/GUIGameRenderManager.h"
 #include "cores/RetroPlayer/guibridge/GUIRenderHandle.h"
+#include "guilib/GUITexture.h"
 #include "settings/GameSettings.h"
 #include "settings/MediaSettings.h"
 #include "utils/Geometry.h"
@@ -95,6 +96,9 @@ void CGUIGameControl::Process(unsigned int currentTime, CDirtyRegionList& dirtyr
 
 void CGUIGameControl::Render()
 {
+  // The game renderer doesn't know about quads the GUI still has queued
+  CGUITexture::FlushBatch();
+
   m_renderHandle->Render();
 
   CGUIControl::Render();
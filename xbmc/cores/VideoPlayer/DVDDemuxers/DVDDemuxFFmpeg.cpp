@@ -8,6 +8,7 @@
 
 #include "DVDDemuxFFmpeg.h"
 
+#include "DVDDemuxPacketPool.h"
 #include "DVDDemuxUtils.h"
 #include "DVDInputStreams/DVDInputStream.h"
 #ifdef HAVE_LIBBLURAY
@@ -214,6 +215,7 @@ CDVDDemuxFFmpeg::CDVDDemuxFFmpeg() : CDVDDemux()
   m_streaminfo = true; /* set to true if we want to look for streams before playback */
   m_checkTransportStream = false;
   m_dtsAtDisplayTime = DVD_NOPTS_VALUE;
+  m_packetPool = std::make_shared<CDVDDemuxPacketPool>();
 }
 
 CDVDDemuxFFmpeg::~CDVDDemuxFFmpeg()
@@ -638,6 +640,10 @@ void CDVDDemuxFFmpeg::Dispose()
 
   DisposeStreams();
 
+  if (m_packetPool->GetHits() + m_packetPool->GetMisses() > 0)
+    CLog::Log(LOGDEBUG, "CDVDDemuxFFmpeg::Dispose - packet pool hits: {}, misses: {}",
+              m_packetPool->GetHits(), m_packetPool->GetMisses());
+
   m_pInput = NULL;
 }
 
@@ -1050,7 +1056,7 @@ DemuxPacket* CDVDDemuxFFmpeg::ReadInternal(bool keep)
               if (m_pkt.pkt.stream_index ==
                   (int)m_pFormatContext->programs[m_program]->stream_index[i])
               {
-                pPacket = CDVDDemuxUtils::AllocateDemuxPacket(m_pkt.pkt.size);
+                pPacket = m_packetPool->Allocate(m_pkt.pkt.size);
                 break;
               }
             }
@@ -1059,7 +1065,7 @@ DemuxPacket* CDVDDemuxFFmpeg::ReadInternal(bool keep)
               bReturnEmpty = true;
           }
           else
-            pPacket = CDVDDemuxUtils::AllocateDemuxPacket(m_pkt.pkt.size);
+            pPacket = m_packetPool->Allocate(m_pkt.pkt.size);
         }
         else
           bReturnEmpty = true;
@@ -20,6 +20,7 @@ extern "C" {
 }
 
 class CDVDDemuxFFmpeg;
+class CDVDDemuxPacketPool;
 class CDVDInputStream;
 class CURL;
 
@@ -178,5 +179,7 @@ protected:
   double m_dtsAtDisplayTime;
   bool m_seekToKeyFrame = false;
   double m_startTime = 0;
+
+  std::shared_ptr<CDVDDemuxPacketPool> m_packetPool;
 };
 
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DVDDemuxPacketPool.h"
+
+#include "DVDDemuxUtils.h"
+#include "cores/VideoPlayer/Interface/DemuxPacket.h"
+#include "utils/MemUtils.h"
+
+#include <bit>
+#include <cstring>
+#include <mutex>
+
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+}
+
+CDVDDemuxPacketPool::~CDVDDemuxPacketPool()
+{
+  for (auto& packets : m_free)
+  {
+    for (DemuxPacket* packet : packets)
+      FreePacket(packet);
+  }
+}
+
+int CDVDDemuxPacketPool::GetSizeClass(size_t size)
+{
+  const int sizeClass = std::bit_width(size - 1);
+  return sizeClass < MIN_SIZE_CLASS ? MIN_SIZE_CLASS : sizeClass;
+}
+
+void CDVDDemuxPacketPool::FreePacket(DemuxPacket* packet)
+{
+  KODI::MEMORY::AlignedFree(packet->pData);
+  delete packet;
+}
+
+DemuxPacket* CDVDDemuxPacketPool::Allocate(int dataSize)
+{
+  if (dataSize <= 0)
+    return CDVDDemuxUtils::AllocateDemuxPacket(dataSize);
+
+  const int sizeClass = GetSizeClass(static_cast<size_t>(dataSize) + AV_INPUT_BUFFER_PADDING_SIZE);
+  if (sizeClass > MAX_SIZE_CLASS)
+  {
+    m_misses++;
+    return CDVDDemuxUtils::AllocateDemuxPacket(dataSize);
+  }
+
+  DemuxPacket* packet = nullptr;
+  {
+    std::unique_lock lock(m_section);
+    auto& packets = m_free[sizeClass - MIN_SIZE_CLASS];
+    if (!packets.empty())
+    {
+      packet = packets.back();
+      packets.pop_back();
+      m_pooledBytes -= size_t{1} << sizeClass;
+    }
+  }
+
+  if (packet)
+  {
+    m_hits++;
+  }
+  else
+  {
+    m_misses++;
+    packet = new DemuxPacket();
+    packet->pData =
+        static_cast<uint8_t*>(KODI::MEMORY::AlignedMalloc(size_t{1} << sizeClass, 16));
+    if (!packet->pData)
+    {
+      delete packet;
+      return nullptr;
+    }
+    packet->m_poolSizeClass = sizeClass;
+  }
+
+  packet->m_pool = shared_from_this();
+
+  // reset the padding behind the data, see AllocateDemuxPacket
+  memset(packet->pData + dataSize, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+
+  return packet;
+}
+
+void CDVDDemuxPacketPool::Release(DemuxPacket* packet)
+{
+  const int sizeClass = packet->m_poolSizeClass;
+  uint8_t* data = packet->pData;
+
+  // restore a pristine packet that still owns its data buffer
+  *packet = DemuxPacket();
+  packet->pData = data;
+  packet->m_poolSizeClass = sizeClass;
+
+  {
+    std::unique_lock lock(m_section);
+    const size_t size = size_t{1} << sizeClass;
+    if (m_pooledBytes + size <= MAX_POOLED_BYTES)
+    {
+      m_free[sizeClass - MIN_SIZE_CLASS].push_back(packet);
+      m_pooledBytes += size;
+      return;
+    }
+  }
+
+  FreePacket(packet);
+}
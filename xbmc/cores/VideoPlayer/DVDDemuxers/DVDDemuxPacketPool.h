@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct DemuxPacket;
+
+/*!
+ * \brief Size-classed pool of demux packets and their data buffers.
+ *
+ * Owned by a demuxer to avoid a heap allocation per packet read. Packets taken from the pool keep
+ * a reference to it and are handed back by CDVDDemuxUtils::FreeDemuxPacket, so they may safely
+ * outlive the demuxer that allocated them.
+ */
+class CDVDDemuxPacketPool : public std::enable_shared_from_this<CDVDDemuxPacketPool>
+{
+public:
+  CDVDDemuxPacketPool() = default;
+  ~CDVDDemuxPacketPool();
+
+  /*!
+   * \brief Get a packet with room for at least dataSize bytes of data plus the input padding
+   * required by ffmpeg, reusing a previously released packet if possible.
+   * \return the packet, nullptr if out of memory
+   */
+  DemuxPacket* Allocate(int dataSize);
+
+  /*!
+   * \brief Take back a packet allocated by this pool. Side data and crypto info must already have
+   * been freed.
+   */
+  void Release(DemuxPacket* packet);
+
+  uint64_t GetHits() const { return m_hits; }
+  uint64_t GetMisses() const { return m_misses; }
+
+private:
+  CDVDDemuxPacketPool(const CDVDDemuxPacketPool&) = delete;
+  CDVDDemuxPacketPool& operator=(const CDVDDemuxPacketPool&) = delete;
+
+  static constexpr int MIN_SIZE_CLASS = 10; // 1 KiB
+  static constexpr int MAX_SIZE_CLASS = 23; // 8 MiB
+  static constexpr size_t MAX_POOLED_BYTES = 64 * 1024 * 1024;
+
+  static int GetSizeClass(size_t size);
+  static void FreePacket(DemuxPacket* packet);
+
+  CCriticalSection m_section;
+  std::array<std::vector<DemuxPacket*>, MAX_SIZE_CLASS - MIN_SIZE_CLASS + 1> m_free;
+  size_t m_pooledBytes = 0;
+
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+};
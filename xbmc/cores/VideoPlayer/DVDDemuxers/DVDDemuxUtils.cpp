@@ -8,6 +8,7 @@
 
 #include "DVDDemuxUtils.h"
 
+#include "DVDDemuxPacketPool.h"
 #include "cores/VideoPlayer/Interface/DemuxCrypto.h"
 #include "utils/MemUtils.h"
 #include "utils/log.h"
@@ -20,8 +21,6 @@ void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
 {
   if (pPacket)
   {
-    if (pPacket->pData)
-      KODI::MEMORY::AlignedFree(pPacket->pData);
     if (pPacket->iSideDataElems)
     {
       AVPacket* avPkt = av_packet_alloc();
@@ -45,6 +44,17 @@ void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
     }
     if (pPacket->cryptoInfo)
       delete pPacket->cryptoInfo;
+
+    if (pPacket->m_pool)
+    {
+      // hand the packet and its data back, keeping the pool alive until it's done
+      const std::shared_ptr<CDVDDemuxPacketPool> pool = std::move(pPacket->m_pool);
+      pool->Release(pPacket);
+      return;
+    }
+
+    if (pPacket->pData)
+      KODI::MEMORY::AlignedFree(pPacket->pData);
     delete pPacket;
   }
 }
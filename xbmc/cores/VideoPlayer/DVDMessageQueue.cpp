@@ -17,6 +17,59 @@
 
 using namespace std::chrono_literals;
 
+namespace
+{
+constexpr size_t MIN_MESSAGE_SLOTS = 64;
+}
+
+void CDVDMessageList::emplace_front(std::shared_ptr<CDVDMsg> msg, int priority)
+{
+  if (m_size == m_slots.size())
+    Grow();
+
+  m_head = (m_head + m_slots.size() - 1) & (m_slots.size() - 1);
+  m_slots[m_head] = DVDMessageListItem(std::move(msg), priority);
+  m_size++;
+}
+
+void CDVDMessageList::emplace_back(std::shared_ptr<CDVDMsg> msg, int priority)
+{
+  if (m_size == m_slots.size())
+    Grow();
+
+  m_slots[Slot(m_size)] = DVDMessageListItem(std::move(msg), priority);
+  m_size++;
+}
+
+void CDVDMessageList::emplace(size_t index, std::shared_ptr<CDVDMsg> msg, int priority)
+{
+  if (m_size == m_slots.size())
+    Grow();
+
+  // shift everything behind index one slot towards the back
+  for (size_t i = m_size; i > index; --i)
+    (*this)[i] = std::move((*this)[i - 1]);
+
+  (*this)[index] = DVDMessageListItem(std::move(msg), priority);
+  m_size++;
+}
+
+void CDVDMessageList::pop_back()
+{
+  back().message.reset();
+  m_size--;
+}
+
+void CDVDMessageList::Grow()
+{
+  std::vector<DVDMessageListItem> slots(std::max(MIN_MESSAGE_SLOTS, m_slots.size() * 2));
+  for (size_t i = 0; i < m_size; ++i)
+    slots[i] = std::move((*this)[i]);
+
+  m_slots = std::move(slots);
+  m_head = 0;
+}
+
 CDVDMessageQueue::CDVDMessageQueue(const std::string &owner) : m_hEvent(true), m_owner(owner)
 {
   m_iDataSize     = 0;
@@ -85,19 +138,17 @@ void CDVDMessageQueue::End()
   m_bAbortRequest = false;
 }
 
-MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg, int priority)
+MsgQueueReturnCode CDVDMessageQueue::Put(std::shared_ptr<CDVDMsg> pMsg, int priority)
 {
-  return Put(pMsg, priority, true);
+  return Put(std::move(pMsg), priority, true);
 }
 
-MsgQueueReturnCode CDVDMessageQueue::PutBack(const std::shared_ptr<CDVDMsg>& pMsg, int priority)
+MsgQueueReturnCode CDVDMessageQueue::PutBack(std::shared_ptr<CDVDMsg> pMsg, int priority)
 {
-  return Put(pMsg, priority, false);
+  return Put(std::move(pMsg), priority, false);
 }
 
-MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg,
-                                         int priority,
-                                         bool front)
+MsgQueueReturnCode CDVDMessageQueue::Put(std::shared_ptr<CDVDMsg> pMsg, int priority, bool front)
 {
   std::unique_lock lock(m_section);
 
@@ -112,17 +163,21 @@ MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg,
     return MSGQ_INVALID_MSG;
   }
 
+  // account for the packet before the message is moved into the queue
+  DemuxPacket* packet = nullptr;
+  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET) && priority == 0)
+    packet = static_cast<CDVDMsgDemuxerPacket*>(pMsg.get())->GetPacket();
+
   if (priority > 0)
   {
     int prio = priority;
     if (!front)
       prio++;
 
-    auto it = std::find_if(m_prioMessages.begin(), m_prioMessages.end(),
-                           [prio](const DVDMessageListItem &item){
-                             return prio <= item.priority;
-                           });
-    m_prioMessages.emplace(it, pMsg, priority);
+    size_t index = 0;
+    while (index < m_prioMessages.size() && prio > m_prioMessages[index].priority)
+      index++;
+    m_prioMessages.emplace(index, std::move(pMsg), priority);
   }
   else
   {
@@ -134,26 +189,23 @@ MsgQueueReturnCode CDVDMessageQueue::Put(const std::shared_ptr<CDVDMsg>& pMsg,
     }
 
     if (front)
-      m_messages.emplace_front(pMsg, priority);
+      m_messages.emplace_front(std::move(pMsg), priority);
     else
-      m_messages.emplace_back(pMsg, priority);
+      m_messages.emplace_back(std::move(pMsg), priority);
   }
 
-  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET) && priority == 0)
+  if (packet)
   {
-    DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(pMsg.get())->GetPacket();
-    if (packet)
-    {
-      m_iDataSize += packet->iSize;
-      if (front)
-        UpdateTimeFront();
-      else
-        UpdateTimeBack();
-    }
+    m_iDataSize += packet->iSize;
+    if (front)
+      UpdateTimeFront();
+    else
+      UpdateTimeBack();
   }
 
-  // inform waiter for new packet
-  m_hEvent.Set();
+  // inform waiter for new packet, nobody needs to be woken if Get() isn't waiting
+  if (m_waiters > 0)
+    m_hEvent.Set();
 
   return MSGQ_OK;
 }
@@ -174,7 +226,8 @@ MsgQueueReturnCode CDVDMessageQueue::Get(std::shared_ptr<CDVDMsg>& pMsg,
 
   while (!m_bAbortRequest)
   {
-    std::list<DVDMessageListItem> &msgs = (priority > 0 || !m_prioMessages.empty()) ? m_prioMessages : m_messages;
+    CDVDMessageList& msgs =
+        (priority > 0 || !m_prioMessages.empty()) ? m_prioMessages : m_messages;
 
     if (!msgs.empty() && (msgs.back().priority >= priority || m_drain))
     {
@@ -205,13 +258,16 @@ MsgQueueReturnCode CDVDMessageQueue::Get(std::shared_ptr<CDVDMsg>& pMsg,
     else
     {
       m_hEvent.Reset();
+      m_waiters++;
       lock.unlock();
 
       // wait for a new message
-      if (!m_hEvent.Wait(timeout))
-        return MSGQ_TIMEOUT;
+      const bool signaled = m_hEvent.Wait(timeout);
 
       lock.lock();
+      m_waiters--;
+      if (!signaled)
+        return MSGQ_TIMEOUT;
     }
   }
 
@@ -275,16 +331,13 @@ unsigned CDVDMessageQueue::GetPacketCount(CDVDMsg::Message type)
     return 0;
 
   unsigned count = 0;
-  for (const auto &item : m_messages)
+  const auto countType = [type, &count](const DVDMessageListItem& item)
   {
-    if(item.message->IsType(type))
+    if (item.message->IsType(type))
       count++;
-  }
-  for (const auto &item : m_prioMessages)
-  {
-    if(item.message->IsType(type))
-      count++;
-  }
+  };
+  m_messages.for_each(countType);
+  m_prioMessages.for_each(countType);
 
   return count;
 }
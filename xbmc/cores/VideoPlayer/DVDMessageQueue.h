@@ -14,8 +14,9 @@
 
 #include <algorithm>
 #include <atomic>
-#include <list>
+#include <memory>
 #include <string>
+#include <vector>
 
 struct DVDMessageListItem
 {
@@ -25,14 +26,73 @@ struct DVDMessageListItem
   }
   DVDMessageListItem() { priority = 0; }
   DVDMessageListItem(const DVDMessageListItem&) = delete;
+  DVDMessageListItem(DVDMessageListItem&&) noexcept = default;
   ~DVDMessageListItem() = default;
 
   DVDMessageListItem& operator=(const DVDMessageListItem&) = delete;
+  DVDMessageListItem& operator=(DVDMessageListItem&&) noexcept = default;
 
   std::shared_ptr<CDVDMsg> message;
   int priority;
 };
 
+/*!
+ * \brief Double ended queue of messages stored in a ring of preallocated slots.
+ *
+ * Unlike a std::list no node is allocated per message: the slots grow (by doubling) to the
+ * largest number of messages queued at once and are reused afterwards. Index 0 is the front,
+ * i.e. the most recently put message, the back is the next message to be read.
+ */
+class CDVDMessageList
+{
+public:
+  bool empty() const { return m_size == 0; }
+  size_t size() const { return m_size; }
+
+  DVDMessageListItem& operator[](size_t index) { return m_slots[Slot(index)]; }
+  const DVDMessageListItem& operator[](size_t index) const { return m_slots[Slot(index)]; }
+  DVDMessageListItem& front() { return m_slots[m_head]; }
+  DVDMessageListItem& back() { return m_slots[Slot(m_size - 1)]; }
+
+  void emplace_front(std::shared_ptr<CDVDMsg> msg, int priority);
+  void emplace_back(std::shared_ptr<CDVDMsg> msg, int priority);
+  void emplace(size_t index, std::shared_ptr<CDVDMsg> msg, int priority);
+  void pop_back();
+
+  template<typename Predicate>
+  void remove_if(Predicate predicate)
+  {
+    size_t kept = 0;
+    for (size_t i = 0; i < m_size; ++i)
+    {
+      DVDMessageListItem& item = (*this)[i];
+      if (predicate(item))
+        continue;
+      if (kept != i)
+        (*this)[kept] = std::move(item);
+      kept++;
+    }
+    for (size_t i = kept; i < m_size; ++i)
+      (*this)[i].message.reset();
+    m_size = kept;
+  }
+
+  template<typename Function>
+  void for_each(Function function) const
+  {
+    for (size_t i = 0; i < m_size; ++i)
+      function((*this)[i]);
+  }
+
+private:
+  size_t Slot(size_t index) const { return (m_head + index) & (m_slots.size() - 1); }
+  void Grow();
+
+  std::vector<DVDMessageListItem> m_slots;
+  size_t m_head = 0;
+  size_t m_size = 0;
+};
+
 enum MsgQueueReturnCode
 {
   MSGQ_OK = 1,
@@ -56,8 +116,8 @@ public:
   void Abort();
   void End();
 
-  MsgQueueReturnCode Put(const std::shared_ptr<CDVDMsg>& pMsg, int priority = 0);
-  MsgQueueReturnCode PutBack(const std::shared_ptr<CDVDMsg>& pMsg, int priority = 0);
+  MsgQueueReturnCode Put(std::shared_ptr<CDVDMsg> pMsg, int priority = 0);
+  MsgQueueReturnCode PutBack(std::shared_ptr<CDVDMsg> pMsg, int priority = 0);
 
   /**
    * msg,       message type from DVDMessage.h
@@ -91,7 +151,7 @@ public:
   bool IsDataBased() const;
 
 private:
-  MsgQueueReturnCode Put(const std::shared_ptr<CDVDMsg>& pMsg, int priority, bool front);
+  MsgQueueReturnCode Put(std::shared_ptr<CDVDMsg> pMsg, int priority, bool front);
   void UpdateTimeFront();
   void UpdateTimeBack();
 
@@ -101,6 +161,7 @@ private:
   std::atomic<bool> m_bAbortRequest = false;
   bool m_bInitialized;
   bool m_drain = false;
+  int m_waiters = 0;
 
   int m_iDataSize;
   double m_TimeFront;
@@ -110,7 +171,7 @@ private:
   int m_iMaxDataSize;
   std::string m_owner;
 
-  std::list<DVDMessageListItem> m_messages;
-  std::list<DVDMessageListItem> m_prioMessages;
+  CDVDMessageList m_messages;
+  CDVDMessageList m_prioMessages;
 };
 
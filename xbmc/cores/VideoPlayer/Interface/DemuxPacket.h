@@ -11,9 +11,13 @@
 #include "TimingConstants.h"
 #include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/inputstream/demux_packet.h"
 
+#include <memory>
+
 #define DMX_SPECIALID_STREAMINFO DEMUX_SPECIALID_STREAMINFO
 #define DMX_SPECIALID_STREAMCHANGE DEMUX_SPECIALID_STREAMCHANGE
 
+class CDVDDemuxPacketPool;
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -43,6 +47,12 @@ extern "C"
 
     //! @brief PTS offset correction applied to the PTS and DTS.
     double m_ptsOffsetCorrection{0};
+
+    //! @brief Pool the packet was allocated from, nullptr if allocated on its own.
+    std::shared_ptr<CDVDDemuxPacketPool> m_pool;
+
+    //! @brief Size class of the pooled data buffer, capacity is 1 << m_poolSizeClass.
+    int m_poolSizeClass{0};
   };
 
 #ifdef __cplusplus
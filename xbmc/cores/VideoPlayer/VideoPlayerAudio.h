@@ -49,7 +49,7 @@ public:
   bool IsInited() const override { return m_messageQueue.IsInited(); }
   void SendMessage(std::shared_ptr<CDVDMsg> pMsg, int priority = 0) override
   {
-    m_messageQueue.Put(pMsg, priority);
+    m_messageQueue.Put(std::move(pMsg), priority);
   }
   void FlushMessages() override { m_messageQueue.Flush(); }
 
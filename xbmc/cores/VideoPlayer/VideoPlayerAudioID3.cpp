@@ -89,7 +89,7 @@ void CVideoPlayerAudioID3::CloseStream(bool bWaitForBuffers)
 void CVideoPlayerAudioID3::SendMessage(std::shared_ptr<CDVDMsg> pMsg, int priority)
 {
   if (m_messageQueue.IsInited())
-    m_messageQueue.Put(pMsg, priority);
+    m_messageQueue.Put(std::move(pMsg), priority);
 }
 
 void CVideoPlayerAudioID3::FlushMessages()
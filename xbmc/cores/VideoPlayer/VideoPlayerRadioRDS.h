@@ -49,7 +49,7 @@ public:
   void SendMessage(std::shared_ptr<CDVDMsg> pMsg, int priority = 0) override
   {
     if (m_messageQueue.IsInited())
-      m_messageQueue.Put(pMsg, priority);
+      m_messageQueue.Put(std::move(pMsg), priority);
   }
   void FlushMessages() override { m_messageQueue.Flush(); }
   bool IsInited() const override { return true; }
@@ -285,7 +285,7 @@ bool CVideoPlayerVideo::IsInited() const
 
 inline void CVideoPlayerVideo::SendMessage(std::shared_ptr<CDVDMsg> pMsg, int priority)
 {
-  m_messageQueue.Put(pMsg, priority);
+  m_messageQueue.Put(std::move(pMsg), priority);
   m_processInfo.SetLevelVQ(m_messageQueue.GetLevel());
 }
 
@@ -17,6 +17,7 @@
 #include "cores/VideoPlayer/DVDCodecs/Overlay/DVDOverlayImage.h"
 #include "cores/VideoPlayer/DVDCodecs/Overlay/DVDOverlaySSA.h"
 #include "cores/VideoPlayer/DVDCodecs/Overlay/DVDOverlaySpu.h"
+#include "guilib/GUITextureGL.h"
 #include "rendering/MatrixGL.h"
 #include "rendering/gl/RenderSystemGL.h"
 #include "utils/GLUtils.h"
@@ -273,6 +274,9 @@ void COverlayGlyphGL::Render(SRenderState& state)
   if ((m_texture == 0) || (m_vertex.empty()))
     return;
 
+  // Draw queued GUI quads before the texture and blend state below are set
+  CGUITextureGL::FlushBatch();
+
   glEnable(GL_BLEND);
 
   glBindTexture(GL_TEXTURE_2D, m_texture);
@@ -359,6 +363,9 @@ COverlayTextureGL::~COverlayTextureGL()
 
 void COverlayTextureGL::Render(SRenderState& state)
 {
+  // Draw queued GUI quads before the texture and blend state below are set
+  CGUITextureGL::FlushBatch();
+
   glEnable(GL_BLEND);
 
   glBindTexture(GL_TEXTURE_2D, m_texture);
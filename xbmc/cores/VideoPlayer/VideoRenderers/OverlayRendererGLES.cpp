@@ -17,6 +17,7 @@
 #include "cores/VideoPlayer/DVDCodecs/Overlay/DVDOverlayImage.h"
 #include "cores/VideoPlayer/DVDCodecs/Overlay/DVDOverlaySSA.h"
 #include "cores/VideoPlayer/DVDCodecs/Overlay/DVDOverlaySpu.h"
+#include "guilib/GUITextureGLES.h"
 #include "rendering/GLExtensions.h"
 #include "rendering/MatrixGL.h"
 #include "rendering/gles/RenderSystemGLES.h"
@@ -330,6 +331,9 @@ void COverlayGlyphGLES::Render(SRenderState& state)
   if ((m_texture == 0) || (m_vertex.empty()))
     return;
 
+  // Draw queued GUI quads before the texture and blend state below are set
+  CGUITextureGLES::FlushBatch();
+
   glEnable(GL_BLEND);
 
   glBindTexture(GL_TEXTURE_2D, m_texture);
@@ -410,6 +414,9 @@ COverlayTextureGLES::~COverlayTextureGLES()
 
 void COverlayTextureGLES::Render(SRenderState& state)
 {
+  // Draw queued GUI quads before the texture and blend state below are set
+  CGUITextureGLES::FlushBatch();
+
   glEnable(GL_BLEND);
 
   glBindTexture(GL_TEXTURE_2D, m_texture);
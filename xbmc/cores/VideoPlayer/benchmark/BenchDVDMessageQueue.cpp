@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDMessageQueue.h"
+#include "cores/VideoPlayer/Interface/DemuxPacket.h"
+#include "cores/VideoPlayer/Interface/TimingConstants.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+std::shared_ptr<CDVDMsg> CreatePacketMessage(int index)
+{
+  DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(0);
+  packet->iSize = 4096;
+  packet->dts = index * DVD_TIME_BASE / 25.0;
+  packet->pts = packet->dts;
+  return std::make_shared<CDVDMsgDemuxerPacket>(packet);
+}
+} // namespace
+
+/*!
+ \brief Demux thread putting packets while the player thread gets them, like VideoPlayer does.
+ Reports packets/second.
+ */
+static void BM_DVDMessageQueue_PutGet(benchmark::State& state)
+{
+  const int packets = static_cast<int>(state.range(0));
+
+  for (auto _ : state)
+  {
+    CDVDMessageQueue queue("bench");
+    queue.Init();
+    queue.SetMaxDataSize(64 * 1024 * 1024);
+
+    std::thread demuxer(
+        [&queue, packets]()
+        {
+          for (int i = 0; i < packets; ++i)
+            queue.Put(CreatePacketMessage(i));
+        });
+
+    std::shared_ptr<CDVDMsg> msg;
+    for (int received = 0; received < packets;)
+    {
+      if (queue.Get(msg, 1000ms) != MSGQ_OK)
+      {
+        state.SkipWithError("Get() timed out");
+        break;
+      }
+      msg.reset();
+      received++;
+    }
+
+    demuxer.join();
+    queue.End();
+  }
+  state.SetItemsProcessed(state.iterations() * packets);
+}
+BENCHMARK(BM_DVDMessageQueue_PutGet)->Arg(10000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/*!
+ \brief Put and Get without contention, the cost the queue adds per packet.
+ */
+static void BM_DVDMessageQueue_PutGetSingleThread(benchmark::State& state)
+{
+  CDVDMessageQueue queue("bench");
+  queue.Init();
+  queue.SetMaxDataSize(64 * 1024 * 1024);
+
+  std::shared_ptr<CDVDMsg> msg;
+  int index = 0;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    for (int i = 0; i < state.range(0); ++i)
+      queue.Put(CreatePacketMessage(index++));
+    state.ResumeTiming();
+
+    for (int i = 0; i < state.range(0); ++i)
+      queue.Get(msg, 0ms);
+  }
+  msg.reset();
+  queue.End();
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DVDMessageQueue_PutGetSingleThread)->Range(16, 1024);
+
+/*!
+ \brief Time from Put() until a player thread blocked in Get() returns with the message.
+ */
+static void BM_DVDMessageQueue_GetWakeLatency(benchmark::State& state)
+{
+  CDVDMessageQueue queue("bench");
+  queue.Init();
+
+  std::atomic<bool> stop{false};
+  std::atomic<bool> waiting{false};
+  std::atomic<std::chrono::steady_clock::time_point::rep> woken{0};
+
+  std::thread player(
+      [&]()
+      {
+        std::shared_ptr<CDVDMsg> msg;
+        while (!stop)
+        {
+          waiting = true;
+          if (queue.Get(msg, 100ms) == MSGQ_OK)
+          {
+            woken = std::chrono::steady_clock::now().time_since_epoch().count();
+            msg.reset();
+          }
+        }
+      });
+
+  for (auto _ : state)
+  {
+    // give the player thread time to block in Get()
+    while (!waiting)
+      std::this_thread::yield();
+    std::this_thread::sleep_for(1ms);
+    waiting = false;
+    woken = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    queue.Put(std::make_shared<CDVDMsg>(CDVDMsg::GENERAL_RESET));
+    while (woken == 0)
+      std::this_thread::yield();
+
+    const std::chrono::steady_clock::duration latency{woken - start.time_since_epoch().count()};
+    state.SetIterationTime(std::chrono::duration<double>(latency).count());
+  }
+
+  stop = true;
+  queue.Abort();
+  player.join();
+  queue.End();
+}
+BENCHMARK(BM_DVDMessageQueue_GetWakeLatency)->UseManualTime()->Unit(benchmark::kMicrosecond);
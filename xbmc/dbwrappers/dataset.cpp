@@ -166,6 +166,42 @@ void Dataset::parse_sql(std::string& sqlcmd) const
   } //for
 }
 
+bool Dataset::query(const std::string& sql, const std::vector<field_value>& params)
+{
+  std::string bound;
+  bound.reserve(sql.size());
+  size_t param = 0;
+  bool quoted = false;
+  for (const char c : sql)
+  {
+    if (c == '\'')
+      quoted = !quoted;
+    if (c != '?' || quoted)
+    {
+      bound += c;
+      continue;
+    }
+    if (param >= params.size())
+      throw DbErrors("Missing value for parameter %u of query: %s",
+                     static_cast<unsigned int>(param + 1), sql.c_str());
+
+    const field_value& value = params[param++];
+    const fType type = value.get_fType();
+    if (value.get_isNull())
+      bound += "NULL";
+    else if (type == fType::ft_String || type == fType::ft_WideString)
+      bound += db->prepare("'%s'", value.get_asString().c_str());
+    else if (type == fType::ft_Float || type == fType::ft_Double || type == fType::ft_LongDouble)
+      bound += std::to_string(value.get_asDouble());
+    else
+      bound += std::to_string(value.get_asInt64());
+  }
+  if (param != params.size())
+    throw DbErrors("Too many parameters for query: %s", sql.c_str());
+
+  return query(bound);
+}
+
 void Dataset::close()
 {
   haveError = false;
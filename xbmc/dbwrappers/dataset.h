@@ -20,6 +20,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace dbiplus
 {
@@ -312,6 +313,23 @@ public:
   virtual const void* getExecRes() = 0;
   /* as open, but with our query exec Sql */
   virtual bool query(const std::string& sql) = 0;
+  /*! \brief Run a query with bound parameters.
+   Each '?' placeholder in sql is replaced by the next value of params. Backends that
+   support prepared statements bind the values natively, the default implementation
+   substitutes them as escaped literals.
+   \param sql the query with '?' placeholders
+   \param params the values to bind, in placeholder order
+   \return true on success
+   */
+  virtual bool query(const std::string& sql, const std::vector<field_value>& params);
+  /*! \brief Run a query and fetch its rows one at a time while iterating with next().
+   Only the current row is held in memory, so the result set can only be walked forward
+   once: num_rows() is the number of rows read so far and seeking is not supported.
+   Backends without a cursor mode fall back to query().
+   \param sql the query to run
+   \return true on success
+   */
+  virtual bool query_stream(const std::string& sql) { return query(sql); }
   /* Close SQL Query*/
   virtual void close();
   /* Refresh dataset (reopen it and set the same cursor position) */
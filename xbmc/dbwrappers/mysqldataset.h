@@ -131,6 +131,7 @@ or insert() operations default = false) */
   int exec(const std::string& sql) override;
   const void* getExecRes() override;
   /* as open, but with our query exec Sql */
+  using Dataset::query;
   bool query(const std::string& query) override;
   /* func. closes a query */
   void close() override;
@@ -400,10 +400,68 @@ void SqliteDatabase::disconnect()
 {
   if (!active)
     return;
+  if (stmt_hits + stmt_misses > 0)
+    CLog::LogFC(LOGDEBUG, LOGDATABASE,
+                "{}: statement cache {} hits, {} misses ({:.1f}% hit rate)", db, stmt_hits,
+                stmt_misses, 100.0 * stmt_hits / (stmt_hits + stmt_misses));
+  clear_statements();
   sqlite3_close(conn);
   active = false;
 }
 
+void SqliteDatabase::clear_statements()
+{
+  for (const auto& [sql, stmt] : stmt_cache)
+    sqlite3_finalize(stmt);
+  stmt_index.clear();
+  stmt_cache.clear();
+  stmt_hits = 0;
+  stmt_misses = 0;
+}
+
+sqlite3_stmt* SqliteDatabase::acquire_statement(const std::string& sql)
+{
+  if (const auto it = stmt_index.find(sql); it != stmt_index.end())
+  {
+    // the index key points into the list node, so it has to go first
+    const auto node = it->second;
+    sqlite3_stmt* stmt = node->second;
+    stmt_index.erase(it);
+    stmt_cache.erase(node);
+    stmt_hits++;
+    return stmt;
+  }
+
+  stmt_misses++;
+  sqlite3_stmt* stmt = nullptr;
+  if (setErr(sqlite3_prepare_v3(conn, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr),
+             sql.c_str()) != SQLITE_OK)
+    return nullptr;
+  return stmt;
+}
+
+void SqliteDatabase::release_statement(const std::string& sql, sqlite3_stmt* stmt)
+{
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+
+  // the same statement may have been checked out twice by nested datasets
+  if (stmt_index.contains(sql))
+  {
+    sqlite3_finalize(stmt);
+    return;
+  }
+
+  stmt_cache.emplace_front(sql, stmt);
+  stmt_index.emplace(stmt_cache.front().first, stmt_cache.begin());
+  if (stmt_cache.size() > STATEMENT_CACHE_SIZE)
+  {
+    stmt_index.erase(stmt_cache.back().first);
+    sqlite3_finalize(stmt_cache.back().second);
+    stmt_cache.pop_back();
+  }
+}
+
 int SqliteDatabase::postconnect()
 {
   if (!active)
@@ -707,7 +765,11 @@ std::string SqliteDatabase::vprepare(std::string_view format, va_list args)
 
 //************* SqliteDataset implementation ***************
 
-SqliteDataset::~SqliteDataset() = default;
+SqliteDataset::~SqliteDataset()
+{
+  if (stream_stmt)
+    sqlite3_finalize(stream_stmt);
+}
 
 void SqliteDataset::set_autorefresh(bool val)
 {
@@ -726,6 +788,11 @@ sqlite3* SqliteDataset::handle()
     return nullptr;
 }
 
+SqliteDatabase* SqliteDataset::sqlite_db()
+{
+  return static_cast<SqliteDatabase*>(db);
+}
+
 void SqliteDataset::make_query(StringList& _sql)
 {
   std::string query;
@@ -941,6 +1008,93 @@ bool SqliteDataset::query(const std::string& query)
       SQLITE_OK)
     throw DbErrors("%s", db->getErrorMsg());
 
+  read_results(stmt);
+
+  if (db->setErr(sqlite3_finalize(stmt), query.c_str()) == SQLITE_OK)
+  {
+    active = true;
+    ds_state = dsSelect;
+    this->first();
+    return true;
+  }
+  else
+  {
+    throw DbErrors("%s", db->getErrorMsg());
+  }
+}
+
+bool SqliteDataset::query(const std::string& sql, const std::vector<field_value>& params)
+{
+  if (!handle())
+    throw DbErrors("No Database Connection");
+
+  // Must be a SELECT SQL query
+  assert(sql.find("SELECT") != std::string::npos || sql.find("select") != std::string::npos);
+
+  close();
+
+  // parametrized queries are reused with different values, keep them compiled
+  SqliteDatabase* database = sqlite_db();
+  sqlite3_stmt* stmt = database->acquire_statement(sql);
+  if (!stmt)
+    throw DbErrors("%s", db->getErrorMsg());
+
+  if (static_cast<size_t>(sqlite3_bind_parameter_count(stmt)) != params.size())
+  {
+    database->release_statement(sql, stmt);
+    throw DbErrors("Wrong number of parameters for query: %s", sql.c_str());
+  }
+
+  int rc = SQLITE_OK;
+  for (size_t i = 0; i < params.size() && rc == SQLITE_OK; i++)
+  {
+    const field_value& value = params[i];
+    const int index = static_cast<int>(i + 1);
+    switch (value.get_isNull() ? fType::ft_Object : value.get_fType())
+    {
+      case fType::ft_String:
+      case fType::ft_WideString:
+      {
+        const std::string str = value.get_asString();
+        rc = sqlite3_bind_text(stmt, index, str.c_str(), static_cast<int>(str.size()),
+                               SQLITE_TRANSIENT);
+        break;
+      }
+      case fType::ft_Float:
+      case fType::ft_Double:
+      case fType::ft_LongDouble:
+        rc = sqlite3_bind_double(stmt, index, value.get_asDouble());
+        break;
+      case fType::ft_Object:
+        rc = sqlite3_bind_null(stmt, index);
+        break;
+      default:
+        rc = sqlite3_bind_int64(stmt, index, value.get_asInt64());
+        break;
+    }
+  }
+  if (db->setErr(rc, sql.c_str()) != SQLITE_OK)
+  {
+    database->release_statement(sql, stmt);
+    throw DbErrors("%s", db->getErrorMsg());
+  }
+
+  rc = read_results(stmt);
+  database->release_statement(sql, stmt);
+  if (rc != SQLITE_DONE)
+  {
+    db->setErr(rc, sql.c_str());
+    throw DbErrors("%s", db->getErrorMsg());
+  }
+
+  active = true;
+  ds_state = dsSelect;
+  this->first();
+  return true;
+}
+
+int SqliteDataset::read_results(sqlite3_stmt* stmt)
+{
   // column headers
   const unsigned int numColumns = sqlite3_column_count(stmt);
   result.record_header.resize(numColumns);
@@ -948,49 +1102,106 @@ bool SqliteDataset::query(const std::string& query)
     result.record_header[i].name = sqlite3_column_name(stmt, i);
 
   // returned rows
-  while (sqlite3_step(stmt) == SQLITE_ROW)
+  int rc;
+  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
   { // have a row of data
     auto* res = new sql_record;
     res->resize(numColumns);
-    for (unsigned int i = 0; i < numColumns; i++)
+    read_row(stmt, *res);
+    result.records.push_back(res);
+  }
+  return rc;
+}
+
+void SqliteDataset::read_row(sqlite3_stmt* stmt, sql_record& row)
+{
+  for (unsigned int i = 0; i < row.size(); i++)
+  {
+    field_value& v = row[i];
+    switch (sqlite3_column_type(stmt, i))
     {
-      field_value& v = res->at(i);
-      switch (sqlite3_column_type(stmt, i))
-      {
-        case SQLITE_INTEGER:
-          v.set_asInt64(sqlite3_column_int64(stmt, i));
-          break;
-        case SQLITE_FLOAT:
-          v.set_asDouble(sqlite3_column_double(stmt, i));
-          break;
-        case SQLITE_TEXT:
-          v.set_asString(reinterpret_cast<const char*>(sqlite3_column_text(stmt, i)),
-                         sqlite3_column_bytes(stmt, i));
-          break;
-        case SQLITE_BLOB:
-          v.set_asString(reinterpret_cast<const char*>(sqlite3_column_text(stmt, i)),
-                         sqlite3_column_bytes(stmt, i));
-          break;
-        case SQLITE_NULL:
-        default:
-          v.set_asString("", 0);
-          v.set_isNull();
-          break;
-      }
+      case SQLITE_INTEGER:
+        v.set_asInt64(sqlite3_column_int64(stmt, i));
+        break;
+      case SQLITE_FLOAT:
+        v.set_asDouble(sqlite3_column_double(stmt, i));
+        break;
+      case SQLITE_TEXT:
+        v.set_asString(reinterpret_cast<const char*>(sqlite3_column_text(stmt, i)),
+                       sqlite3_column_bytes(stmt, i));
+        break;
+      case SQLITE_BLOB:
+        v.set_asString(reinterpret_cast<const char*>(sqlite3_column_text(stmt, i)),
+                       sqlite3_column_bytes(stmt, i));
+        break;
+      case SQLITE_NULL:
+      default:
+        v.set_asString("", 0);
+        v.set_isNull();
+        break;
     }
-    result.records.push_back(res);
   }
-  if (db->setErr(sqlite3_finalize(stmt), query.c_str()) == SQLITE_OK)
+}
+
+bool SqliteDataset::query_stream(const std::string& sql)
+{
+  if (!handle())
+    throw DbErrors("No Database Connection");
+
+  // Must be a SELECT SQL query
+  assert(sql.find("SELECT") != std::string::npos || sql.find("select") != std::string::npos);
+
+  close();
+
+  if (db->setErr(sqlite3_prepare_v2(handle(), sql.c_str(), -1, &stream_stmt, nullptr),
+                 sql.c_str()) != SQLITE_OK)
+    throw DbErrors("%s", db->getErrorMsg());
+
+  const unsigned int numColumns = sqlite3_column_count(stream_stmt);
+  result.record_header.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+    result.record_header[i].name = sqlite3_column_name(stream_stmt, i);
+
+  // a single record is reused for all rows
+  auto* row = new sql_record;
+  row->resize(numColumns);
+  result.records.push_back(row);
+
+  active = true;
+  streaming = true;
+  ds_state = dsSelect;
+  frecno = 0;
+  fbof = true;
+  step_stream();
+  return true;
+}
+
+void SqliteDataset::step_stream()
+{
+  const int rc = sqlite3_step(stream_stmt);
+  if (rc != SQLITE_ROW)
   {
-    active = true;
-    ds_state = dsSelect;
-    this->first();
-    return true;
+    feof = true;
+    if (db->setErr(sqlite3_finalize(stream_stmt), "") != SQLITE_OK)
+    {
+      stream_stmt = nullptr;
+      throw DbErrors("%s", db->getErrorMsg());
+    }
+    stream_stmt = nullptr;
+    return;
   }
-  else
+
+  sql_record& row = *result.records[0];
+  if (stream_rows > 0)
   {
-    throw DbErrors("%s", db->getErrorMsg());
+    // values of the previous row may carry a null flag
+    for (auto& value : row)
+      value = field_value();
   }
+  read_row(stream_stmt, row);
+  stream_rows++;
+  feof = false;
+  fill_fields();
 }
 
 void SqliteDataset::open(const std::string& sql)
@@ -1013,6 +1224,13 @@ void SqliteDataset::open()
 
 void SqliteDataset::close()
 {
+  if (stream_stmt)
+  {
+    sqlite3_finalize(stream_stmt);
+    stream_stmt = nullptr;
+  }
+  streaming = false;
+  stream_rows = 0;
   Dataset::close();
   result.clear();
   edit_object->clear();
@@ -1034,6 +1252,8 @@ void SqliteDataset::cancel()
 
 int SqliteDataset::num_rows()
 {
+  if (streaming)
+    return stream_rows;
   return static_cast<int>(result.records.size());
 }
 
@@ -1067,6 +1287,15 @@ void SqliteDataset::prev()
 
 void SqliteDataset::next()
 {
+  if (streaming)
+  {
+    fbof = false;
+    if (stream_stmt)
+      step_stream();
+    else
+      feof = true;
+    return;
+  }
   Dataset::next();
   if (!eof())
     fill_fields();
@@ -1087,7 +1316,7 @@ void SqliteDataset::free_row()
 
 bool SqliteDataset::seek(int pos)
 {
-  if (ds_state == dsSelect)
+  if (ds_state == dsSelect && !streaming)
   {
     Dataset::seek(pos);
     fill_fields();
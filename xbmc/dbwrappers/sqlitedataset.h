@@ -14,9 +14,15 @@
 
 #include "dataset.h"
 
+#include <list>
+#include <stdint.h>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace dbiplus
 {
@@ -33,6 +39,14 @@ protected:
   bool _in_transaction{false};
   int last_err;
 
+  /* prepared statements keyed by their SQL, most recently used first */
+  std::list<std::pair<std::string, sqlite3_stmt*>> stmt_cache;
+  std::unordered_map<std::string_view, decltype(stmt_cache)::iterator> stmt_index;
+  uint64_t stmt_hits{0};
+  uint64_t stmt_misses{0};
+
+  void clear_statements();
+
 public:
   /* default constructor */
   SqliteDatabase();
@@ -84,6 +98,20 @@ public:
   std::string vprepare(std::string_view format, va_list args) override;
 
   bool in_transaction() override { return _in_transaction; }
+
+  /*! \brief Take a prepared statement for sql out of the statement cache.
+   Compiles the statement if it isn't cached. The statement must be handed back
+   with release_statement() once it is no longer used.
+   \param sql the statement to prepare
+   \return the prepared statement, nullptr on error (see getErrorMsg())
+   */
+  sqlite3_stmt* acquire_statement(const std::string& sql);
+  /*! \brief Reset a statement obtained from acquire_statement() and put it back into the cache.
+   The least recently used statement is finalized if the cache is full.
+   */
+  void release_statement(const std::string& sql, sqlite3_stmt* stmt);
+
+  static constexpr size_t STATEMENT_CACHE_SIZE = 64;
 };
 
 /***************** Class SqliteDataset definition *******************
@@ -96,6 +124,18 @@ class SqliteDataset : public Dataset
 {
 protected:
   sqlite3* handle();
+  SqliteDatabase* sqlite_db();
+  /* reads the column headers and all rows of stmt, returns the result of the last step */
+  int read_results(sqlite3_stmt* stmt);
+  /* copies the current row of stmt into row */
+  static void read_row(sqlite3_stmt* stmt, sql_record& row);
+  /* moves the streaming cursor to the next row */
+  void step_stream();
+
+  /* state of query_stream(), the cursor is finalized once the last row was read */
+  bool streaming{false};
+  sqlite3_stmt* stream_stmt{nullptr};
+  int stream_rows{0};
 
   /* Makes direct queries to database */
   virtual void make_query(StringList& _sql);
@@ -134,6 +174,8 @@ or insert() operations default = false) */
   const void* getExecRes() override;
   /* as open, but with our query exec Sql */
   bool query(const std::string& query) override;
+  bool query(const std::string& sql, const std::vector<field_value>& params) override;
+  bool query_stream(const std::string& sql) override;
   /* func. closes a query */
   void close() override;
   /* Cancel changes, made in insert or edit states of dataset */
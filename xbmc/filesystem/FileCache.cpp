@@ -11,6 +11,7 @@
 #include "CircularCache.h"
 #include "ServiceBroker.h"
 #include "URL.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/Thread.h"
@@ -19,6 +20,7 @@
 #include <mutex>
 
 #if !defined(TARGET_WINDOWS)
+#include "SparseFileCache.h"
 #include "platform/posix/ConvUtils.h"
 #endif
 
@@ -33,6 +35,12 @@
 
 using namespace XFILE;
 
+namespace
+{
+// the sparse disk cache maps all of its file at once, a 32-bit process can't spare more than this
+constexpr int64_t SPARSE_CACHE_MAX_SIZE_32BIT = 256 * 1024 * 1024;
+} // namespace
+
 class CWriteRate
 {
 public:
@@ -135,8 +143,36 @@ bool CFileCache::Open(const CURL& url)
 
   m_fileSize = m_source.GetLength();
 
+  bool sparseCache = false;
   if (!m_pCache)
   {
+#if !defined(TARGET_WINDOWS)
+    int64_t sparseCacheSize = static_cast<int64_t>(CServiceBroker::GetSettingsComponent()
+                                                       ->GetAdvancedSettings()
+                                                       ->m_sparseFileCacheSize) *
+                              1024 * 1024;
+    // all of it is mapped at once, leave the address space of 32-bit systems to everything else
+    if constexpr (sizeof(void*) < 8)
+      sparseCacheSize = std::min<int64_t>(sparseCacheSize, SPARSE_CACHE_MAX_SIZE_32BIT);
+
+    if (cacheMemSize == 0 && sparseCacheSize > 0 && m_seekPossible > 0 && m_fileSize > 0)
+    {
+      // Use sparse cache on disk, it keeps everything read so far (up to its size)
+      int64_t cacheSize = sparseCacheSize;
+      if (m_flags & READ_MULTI_STREAM)
+        cacheSize /= 2;
+
+      CLog::Log(LOGDEBUG, "CFileCache::{} - <{}> using sparse disk cache sized {} bytes",
+                __FUNCTION__, m_sourcePath, cacheSize);
+
+      auto cache = std::make_unique<CSparseFileCache>(m_fileSize, m_chunkSize, cacheSize);
+      m_forwardCacheSize = cache->GetMaxForward();
+      m_maxForward = m_forwardCacheSize;
+      m_pCache = std::move(cache);
+      sparseCache = true;
+    }
+    else
+#endif
     if (cacheMemSize == 0)
     {
       // Use cache on disk
@@ -196,7 +232,21 @@ bool CFileCache::Open(const CURL& url)
   }
 
   // open cache strategy
-  if (!m_pCache || m_pCache->Open() != CACHE_RC_OK)
+  int result = m_pCache ? m_pCache->Open() : CACHE_RC_ERROR;
+  if (result != CACHE_RC_OK && sparseCache)
+  {
+    // e.g. temp is full or doesn't support mapping files, the plain disk cache may still work
+    CLog::Log(LOGWARNING, "CFileCache::{} - <{}> failed to open sparse disk cache, using disk cache",
+              __FUNCTION__, m_sourcePath);
+    m_pCache = std::make_unique<CSimpleFileCache>();
+    m_forwardCacheSize = 0;
+    m_maxForward = m_fileSize;
+    if (m_flags & READ_MULTI_STREAM)
+      m_pCache = std::make_unique<CDoubleCache>(m_pCache.release());
+    result = m_pCache->Open();
+  }
+
+  if (result != CACHE_RC_OK)
   {
     CLog::Log(LOGERROR, "CFileCache::{} - <{}> failed to open cache", __FUNCTION__, m_sourcePath);
     Close();
@@ -491,6 +541,23 @@ retry:
 
   if (iRc == CACHE_RC_WOULD_BLOCK)
   {
+    // a sparse cache can run into a hole the source isn't filling, restart the source there
+    if (m_seekPossible != 0 && !m_pCache->IsCachedPosition(m_readPos))
+    {
+      CLog::Log(LOGDEBUG, "CFileCache::{} - <{}> position {} not cached, refilling from source",
+                __FUNCTION__, m_sourcePath, m_readPos);
+      const int64_t readPos = m_readPos;
+      if (!SeekSource(readPos))
+        return -1;
+      if (m_seekPos < readPos)
+      {
+        m_pCache->WaitForData(static_cast<uint32_t>(readPos - m_seekPos), 10s);
+        m_pCache->Seek(readPos);
+      }
+      m_readPos = readPos;
+      m_seekEvent.Reset();
+    }
+
     // just wait for some data to show up
     iRc = m_pCache->WaitForData(1, 10s);
     if (iRc > 0)
@@ -541,16 +608,8 @@ int64_t CFileCache::Seek(int64_t iFilePosition, int iWhence)
     if (m_seekPossible == 0)
       return m_nSeekResult;
 
-    // Never request closer to end than one chunk. Speeds up tag reading
-    m_seekPos = std::min(iTarget, std::max((int64_t)0, m_fileSize - m_chunkSize));
-
-    m_seekEvent.Set();
-    while (!m_seekEnded.Wait(100ms))
-    {
-      // SeekEnded will never be set if FileCache thread is not running
-      if (!CThread::IsRunning())
-        return -1;
-    }
+    if (!SeekSource(iTarget))
+      return -1;
 
     /* wait for any remaining data */
     if(m_seekPos < iTarget)
@@ -575,6 +634,21 @@ int64_t CFileCache::Seek(int64_t iFilePosition, int iWhence)
   return iTarget;
 }
 
+bool CFileCache::SeekSource(int64_t iTarget)
+{
+  // Never request closer to end than one chunk. Speeds up tag reading
+  m_seekPos = std::min(iTarget, std::max((int64_t)0, m_fileSize - m_chunkSize));
+
+  m_seekEvent.Set();
+  while (!m_seekEnded.Wait(100ms))
+  {
+    // SeekEnded will never be set if FileCache thread is not running
+    if (!CThread::IsRunning())
+      return false;
+  }
+  return true;
+}
+
 void CFileCache::Close()
 {
   StopThread();
@@ -58,6 +58,8 @@ namespace XFILE
     }
 
   private:
+    bool SeekSource(int64_t iTarget);
+
     std::unique_ptr<CCacheStrategy> m_pCache;
     int m_seekPossible = 0;
     CFile m_source;
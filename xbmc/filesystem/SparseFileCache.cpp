@@ -0,0 +1,438 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SparseFileCache.h"
+
+#include "SpecialProtocol.h"
+#include "Util.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+CSparseFileCache::CSparseFileCache(int64_t fileSize, size_t chunkSize, int64_t maxSize)
+  : m_maxSize(maxSize),
+    m_chunkSize(chunkSize),
+    m_blockSize(std::max(MIN_BLOCK_SIZE, chunkSize)),
+    m_fileSize(fileSize)
+{
+}
+
+CSparseFileCache::~CSparseFileCache()
+{
+  Close();
+}
+
+int CSparseFileCache::Open()
+{
+  Close();
+
+  std::unique_lock lock(m_sync);
+
+  // we need at least the blocks for reading and writing plus one to evict
+  const size_t slots = std::max<size_t>(4, static_cast<size_t>(m_maxSize / m_blockSize));
+
+  m_filename = CSpecialProtocol::TranslatePath(
+      CUtil::GetNextFilename("special://temp/filecache{:03}.cache", 999));
+  if (m_filename.empty())
+  {
+    CLog::Log(LOGERROR, "CSparseFileCache::{} - Unable to generate a new filename", __FUNCTION__);
+    return CACHE_RC_ERROR;
+  }
+
+  m_fd = open(m_filename.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+  if (m_fd < 0)
+  {
+    CLog::Log(LOGERROR, "CSparseFileCache::{} - Failed to create file \"{}\" ({})", __FUNCTION__,
+              m_filename, strerror(errno));
+    m_filename.clear();
+    return CACHE_RC_ERROR;
+  }
+
+  // the file is only reachable through our descriptor from now on, so it's gone on a crash too
+  unlink(m_filename.c_str());
+
+  // extending the file doesn't allocate any disk space, blocks are only backed once written
+  m_mapSize = slots * m_blockSize;
+  if (ftruncate(m_fd, static_cast<off_t>(m_mapSize)) != 0)
+  {
+    CLog::Log(LOGERROR, "CSparseFileCache::{} - Failed to size \"{}\" to {} bytes ({})",
+              __FUNCTION__, m_filename, m_mapSize, strerror(errno));
+    lock.unlock();
+    Close();
+    return CACHE_RC_ERROR;
+  }
+
+  void* map = mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (map == MAP_FAILED)
+  {
+    CLog::Log(LOGERROR, "CSparseFileCache::{} - Failed to map \"{}\" ({})", __FUNCTION__,
+              m_filename, strerror(errno));
+    lock.unlock();
+    Close();
+    return CACHE_RC_ERROR;
+  }
+  m_map = static_cast<uint8_t*>(map);
+
+  const size_t blocks = static_cast<size_t>(std::max<int64_t>(m_fileSize, 0) / m_blockSize + 1);
+  m_cached.assign(blocks, false);
+  m_blockSlot.assign(blocks, -1);
+  m_slotBlock.assign(slots, -1);
+  m_slotUsed.assign(slots, 0);
+  m_useCounter = 0;
+  m_readPos = 0;
+  m_writePos = 0;
+
+  CLog::Log(LOGDEBUG, "CSparseFileCache::{} - using {} blocks of {} bytes in \"{}\"", __FUNCTION__,
+            slots, m_blockSize, m_filename);
+
+  return CACHE_RC_OK;
+}
+
+void CSparseFileCache::Close()
+{
+  std::unique_lock lock(m_sync);
+
+  if (m_map)
+    munmap(m_map, m_mapSize);
+  m_map = nullptr;
+  m_mapSize = 0;
+
+  if (m_fd >= 0)
+    close(m_fd);
+  m_fd = -1;
+
+  m_filename.clear();
+  m_cached.clear();
+  m_blockSlot.clear();
+  m_slotBlock.clear();
+  m_slotUsed.clear();
+}
+
+int64_t CSparseFileCache::GetContiguousEnd(int64_t position, int64_t limit) const
+{
+  int64_t end = position;
+  while (end < m_fileSize && end < limit)
+  {
+    const int64_t block = end / m_blockSize;
+    if (IsBlockCached(block))
+    {
+      end = std::min(static_cast<int64_t>((block + 1) * m_blockSize), m_fileSize);
+      continue;
+    }
+
+    // the block being written is valid from its start up to the write position
+    if (m_writePos > end && m_writePos / static_cast<int64_t>(m_blockSize) == block)
+      end = m_writePos;
+    break;
+  }
+  return end;
+}
+
+int64_t CSparseFileCache::GetRefillPos(int64_t position) const
+{
+  const int64_t end = GetContiguousEnd(position);
+  if (end > position)
+    return end;
+
+  // the writer is already on its way through this block
+  const int64_t blockStart = GetBlockStart(position);
+  if (m_writePos >= blockStart && m_writePos <= position)
+    return m_writePos;
+
+  // blocks are always filled from their start
+  return blockStart;
+}
+
+int CSparseFileCache::FindFreeSlot() const
+{
+  const int64_t readBlock = m_readPos / m_blockSize;
+  const int64_t writeBlock = m_writePos / m_blockSize;
+
+  int slot = -1;
+  for (size_t i = 0; i < m_slotBlock.size(); i++)
+  {
+    const int64_t block = m_slotBlock[i];
+    if (block < 0)
+      return static_cast<int>(i);
+
+    // never evict what lies between the reader and the writer, that's the forward buffer
+    if (block >= std::min(readBlock, writeBlock) && block <= std::max(readBlock, writeBlock))
+      continue;
+
+    if (slot < 0 || m_slotUsed[i] < m_slotUsed[slot])
+      slot = static_cast<int>(i);
+  }
+  return slot;
+}
+
+void CSparseFileCache::ReleaseSlot(int slot)
+{
+  const int64_t block = m_slotBlock[slot];
+  if (block < 0)
+    return;
+
+  m_cached[block] = false;
+  m_blockSlot[block] = -1;
+  m_slotBlock[slot] = -1;
+}
+
+int CSparseFileCache::GetSlot(int64_t block)
+{
+  if (block >= static_cast<int64_t>(m_blockSlot.size()))
+  {
+    // source grew while reading
+    m_cached.resize(block + 1, false);
+    m_blockSlot.resize(block + 1, -1);
+  }
+
+  int slot = m_blockSlot[block];
+  if (slot >= 0)
+    return slot;
+
+  slot = FindFreeSlot();
+  if (slot < 0)
+    return -1;
+
+  ReleaseSlot(slot);
+  m_slotBlock[slot] = block;
+  m_blockSlot[block] = slot;
+  return slot;
+}
+
+size_t CSparseFileCache::GetMaxWriteSize(const size_t& iRequestSize)
+{
+  std::unique_lock lock(m_sync);
+
+  // a single write never spans more than the current and the next block
+  const int64_t block = m_writePos / m_blockSize;
+  const size_t leftInBlock = m_blockSize - static_cast<size_t>(m_writePos % m_blockSize);
+  if (block < static_cast<int64_t>(m_blockSlot.size()) && m_blockSlot[block] >= 0 &&
+      iRequestSize <= leftInBlock)
+    return iRequestSize;
+
+  if (FindFreeSlot() < 0)
+    return 0;
+
+  return std::min(iRequestSize, m_chunkSize);
+}
+
+int CSparseFileCache::WriteToCache(const char* pBuffer, size_t iSize)
+{
+  std::unique_lock lock(m_sync);
+
+  if (!m_map)
+    return CACHE_RC_ERROR;
+
+  size_t written = 0;
+  while (written < iSize)
+  {
+    const int64_t block = m_writePos / m_blockSize;
+    const int slot = GetSlot(block);
+    if (slot < 0)
+      break;
+
+    const size_t offset = static_cast<size_t>(m_writePos % m_blockSize);
+    const size_t size = std::min(iSize - written, m_blockSize - offset);
+    memcpy(m_map + static_cast<size_t>(slot) * m_blockSize + offset, pBuffer + written, size);
+
+    m_slotUsed[slot] = ++m_useCounter;
+    m_writePos += size;
+    written += size;
+
+    if (m_writePos % m_blockSize == 0)
+      m_cached[block] = true;
+  }
+
+  if (m_writePos > m_fileSize)
+    m_fileSize = m_writePos;
+
+  // when reader waits for data it will wait on the event.
+  if (written > 0)
+    m_written.Set();
+
+  return static_cast<int>(written);
+}
+
+int CSparseFileCache::ReadFromCache(char* pBuffer, size_t iMaxSize)
+{
+  std::unique_lock lock(m_sync);
+
+  if (!m_map)
+    return CACHE_RC_ERROR;
+
+  const int64_t available =
+      GetContiguousEnd(m_readPos, m_readPos + static_cast<int64_t>(iMaxSize)) - m_readPos;
+  if (available <= 0)
+  {
+    // a hole before the end of the file is refilled, even once the source hit its end
+    return IsEndOfFile(m_readPos) ? 0 : CACHE_RC_WOULD_BLOCK;
+  }
+
+  size_t toRead = std::min(iMaxSize, static_cast<size_t>(available));
+  size_t read = 0;
+  while (toRead > 0)
+  {
+    const int slot = m_blockSlot[m_readPos / m_blockSize];
+    const size_t offset = static_cast<size_t>(m_readPos % m_blockSize);
+    const size_t size = std::min(toRead, m_blockSize - offset);
+    memcpy(pBuffer + read, m_map + static_cast<size_t>(slot) * m_blockSize + offset, size);
+
+    m_slotUsed[slot] = ++m_useCounter;
+    m_readPos += size;
+    read += size;
+    toRead -= size;
+  }
+
+  m_space.Set();
+
+  return static_cast<int>(read);
+}
+
+int64_t CSparseFileCache::WaitForData(uint32_t iMinAvail, std::chrono::milliseconds timeout)
+{
+  XbmcThreads::EndTime<> endTime{timeout};
+  std::unique_lock lock(m_sync);
+  while (true)
+  {
+    const int64_t end = GetContiguousEnd(m_readPos);
+    const int64_t available = end - m_readPos;
+    if (available >= iMinAvail || IsEndOfFile(end))
+      return available;
+
+    if (endTime.IsTimePast())
+      return timeout == 0ms ? available : CACHE_RC_TIMEOUT;
+
+    lock.unlock();
+    const bool signaled = m_written.Wait(endTime.GetTimeLeft());
+    lock.lock();
+
+    if (!signaled)
+    {
+      const int64_t left = GetContiguousEnd(m_readPos) - m_readPos;
+      return left >= iMinAvail ? left : CACHE_RC_TIMEOUT;
+    }
+  }
+}
+
+int64_t CSparseFileCache::Seek(int64_t iFilePosition)
+{
+  std::unique_lock lock(m_sync);
+
+  // if seek is a bit over what we have, try to wait a few seconds for the data to be available.
+  // we try to avoid a (heavy) seek on the source
+  if (iFilePosition > m_writePos && iFilePosition < m_writePos + 100000 &&
+      GetContiguousEnd(m_readPos) == m_writePos)
+  {
+    m_readPos = m_writePos;
+
+    lock.unlock();
+    WaitForData(static_cast<uint32_t>(iFilePosition - m_writePos), 5s);
+    lock.lock();
+  }
+
+  if (GetContiguousEnd(iFilePosition) > iFilePosition || iFilePosition == m_writePos)
+  {
+    m_readPos = iFilePosition;
+    m_space.Set();
+    return iFilePosition;
+  }
+
+  return CACHE_RC_ERROR;
+}
+
+bool CSparseFileCache::Reset(int64_t iSourcePosition)
+{
+  std::unique_lock lock(m_sync);
+
+  // continue at the end of what we already have, everything else is kept for later
+  const bool cached = GetContiguousEnd(iSourcePosition) > iSourcePosition;
+  m_writePos = GetRefillPos(iSourcePosition);
+  m_readPos = iSourcePosition;
+
+  return !cached;
+}
+
+void CSparseFileCache::EndOfInput()
+{
+  std::unique_lock lock(m_sync);
+
+  CCacheStrategy::EndOfInput();
+
+  // the last block of the file is complete even though it's shorter
+  if (m_writePos >= m_fileSize && m_writePos % m_blockSize != 0)
+  {
+    const int64_t block = m_writePos / m_blockSize;
+    if (block < static_cast<int64_t>(m_blockSlot.size()) && m_blockSlot[block] >= 0)
+    {
+      m_fileSize = m_writePos;
+      m_cached[block] = true;
+    }
+  }
+
+  m_written.Set();
+}
+
+int64_t CSparseFileCache::CachedDataEndPosIfSeekTo(int64_t iFilePosition)
+{
+  std::unique_lock lock(m_sync);
+
+  return GetRefillPos(iFilePosition);
+}
+
+int64_t CSparseFileCache::CachedDataStartPos()
+{
+  std::unique_lock lock(m_sync);
+
+  // start of the run of cached blocks that is being extended by the writer
+  int64_t block = m_writePos / m_blockSize;
+  while (block > 0 && IsBlockCached(block - 1))
+    block--;
+
+  return std::min(block * static_cast<int64_t>(m_blockSize), m_writePos);
+}
+
+int64_t CSparseFileCache::CachedDataEndPos()
+{
+  std::unique_lock lock(m_sync);
+
+  return m_writePos;
+}
+
+bool CSparseFileCache::IsCachedPosition(int64_t iFilePosition)
+{
+  std::unique_lock lock(m_sync);
+
+  if (GetContiguousEnd(iFilePosition) > iFilePosition)
+    return true;
+
+  // the writer is about to fill it
+  return iFilePosition >= m_writePos &&
+         iFilePosition < GetBlockStart(m_writePos) + static_cast<int64_t>(m_blockSize);
+}
+
+CCacheStrategy* CSparseFileCache::CreateNew()
+{
+  return new CSparseFileCache(m_fileSize, m_chunkSize, m_maxSize);
+}
+
+int64_t CSparseFileCache::GetMaxForward() const
+{
+  // the reader's block and the next write may take up two slots
+  const int64_t slots = std::max<int64_t>(4, m_maxSize / static_cast<int64_t>(m_blockSize));
+  return (slots - 2) * static_cast<int64_t>(m_blockSize);
+}
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "CacheStrategy.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace XFILE
+{
+
+/*!
+ \brief Disk cache that keeps every downloaded range of a file.
+
+ The source file is split in fixed size blocks which are stored in the slots of a
+ memory mapped (sparse) temp file. A bitmap records which blocks are complete, so
+ seeking back into data that was already fetched never hits the source again. Once
+ all slots are in use the least recently used block outside of the current read/write
+ window is evicted.
+ \sa CCacheStrategy
+ */
+class CSparseFileCache : public CCacheStrategy
+{
+public:
+  /*!
+   \param fileSize size of the source file
+   \param chunkSize maximum size of a single write, the block size is at least as large
+   \param maxSize maximum size of the cache file in bytes
+   */
+  CSparseFileCache(int64_t fileSize, size_t chunkSize, int64_t maxSize);
+  ~CSparseFileCache() override;
+
+  int Open() override;
+  void Close() override;
+
+  size_t GetMaxWriteSize(const size_t& iRequestSize) override;
+  int WriteToCache(const char* pBuffer, size_t iSize) override;
+  int ReadFromCache(char* pBuffer, size_t iMaxSize) override;
+  int64_t WaitForData(uint32_t iMinAvail, std::chrono::milliseconds timeout) override;
+
+  int64_t Seek(int64_t iFilePosition) override;
+  bool Reset(int64_t iSourcePosition) override;
+  void EndOfInput() override;
+
+  int64_t CachedDataEndPosIfSeekTo(int64_t iFilePosition) override;
+  int64_t CachedDataStartPos() override;
+  int64_t CachedDataEndPos() override;
+  bool IsCachedPosition(int64_t iFilePosition) override;
+
+  CCacheStrategy* CreateNew() override;
+
+  /*!
+   \brief Get the number of bytes the cache can hold ahead of the read position
+   */
+  int64_t GetMaxForward() const;
+
+private:
+  int64_t GetBlockStart(int64_t position) const
+  {
+    return position - position % static_cast<int64_t>(m_blockSize);
+  }
+  bool IsBlockCached(int64_t block) const
+  {
+    return block < static_cast<int64_t>(m_cached.size()) && m_cached[block];
+  }
+  /*!
+   \brief Check if nothing follows the position, not even after refilling from the source.
+   */
+  bool IsEndOfFile(int64_t position) const
+  {
+    return m_bEndOfInput && position >= std::min(m_writePos, m_fileSize);
+  }
+  int64_t GetContiguousEnd(int64_t position,
+                           int64_t limit = std::numeric_limits<int64_t>::max()) const;
+  int64_t GetRefillPos(int64_t position) const;
+  int GetSlot(int64_t block);
+  int FindFreeSlot() const;
+  void ReleaseSlot(int slot);
+
+  static constexpr size_t MIN_BLOCK_SIZE = 1024 * 1024;
+
+  const int64_t m_maxSize;
+  const size_t m_chunkSize;
+  const size_t m_blockSize;
+  int64_t m_fileSize;
+
+  std::string m_filename;
+  int m_fd = -1;
+  uint8_t* m_map = nullptr;
+  size_t m_mapSize = 0;
+
+  std::vector<bool> m_cached; //!< block bitmap, true if the whole block is in the cache
+  std::vector<int> m_blockSlot; //!< slot holding the block or -1
+  std::vector<int64_t> m_slotBlock; //!< block stored in the slot or -1
+  std::vector<uint64_t> m_slotUsed; //!< last use of the slot, for LRU eviction
+  uint64_t m_useCounter = 0;
+
+  int64_t m_readPos = 0;
+  int64_t m_writePos = 0;
+
+  CCriticalSection m_sync;
+  CEvent m_written;
+};
+
+} // namespace XFILE
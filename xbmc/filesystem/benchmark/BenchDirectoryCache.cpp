@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "FileItemList.h"
+#include "URL.h"
+#include "filesystem/DirectoryCache.h"
+
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+using namespace XFILE;
+
+namespace
+{
+void CreateListing(const std::string& path, int count, CFileItemList& items)
+{
+  items.SetPath(path);
+  for (int i = 0; i < count; ++i)
+    items.Add(std::make_shared<CFileItem>(path + "file" + std::to_string(i) + ".mkv", false));
+}
+} // namespace
+
+static void BM_DirectoryCache_GetDirectory(benchmark::State& state)
+{
+  CDirectoryCache cache;
+  const CURL url("smb://nas/media/Movies/");
+  CFileItemList listing;
+  CreateListing(url.Get(), static_cast<int>(state.range(0)), listing);
+  cache.SetDirectory(url, listing, CacheType::ALWAYS);
+  for (auto _ : state)
+  {
+    CFileItemList items;
+    benchmark::DoNotOptimize(cache.GetDirectory(url, items));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DirectoryCache_GetDirectory)->Range(16, 4096);
+
+static void BM_DirectoryCache_FileExists(benchmark::State& state)
+{
+  CDirectoryCache cache;
+  const CURL url("smb://nas/media/Movies/");
+  const int count = static_cast<int>(state.range(0));
+  CFileItemList listing;
+  CreateListing(url.Get(), count, listing);
+  cache.SetDirectory(url, listing, CacheType::ALWAYS);
+  const CURL file("smb://nas/media/Movies/file" + std::to_string(count - 1) + ".mkv");
+  for (auto _ : state)
+  {
+    bool foundInCache = false;
+    benchmark::DoNotOptimize(cache.FileExists(file, foundInCache));
+  }
+}
+BENCHMARK(BM_DirectoryCache_FileExists)->Range(16, 4096);
+
+static void BM_DirectoryCache_SetDirectory(benchmark::State& state)
+{
+  const CURL url("smb://nas/media/Movies/");
+  CFileItemList listing;
+  CreateListing(url.Get(), static_cast<int>(state.range(0)), listing);
+  CDirectoryCache cache;
+  for (auto _ : state)
+    cache.SetDirectory(url, listing, CacheType::ALWAYS);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DirectoryCache_SetDirectory)->Range(16, 4096);
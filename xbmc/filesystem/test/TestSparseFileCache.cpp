@@ -0,0 +1,157 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/SparseFileCache.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr int64_t MB = 1024 * 1024;
+constexpr int64_t FILE_SIZE = 20 * MB + 12345;
+constexpr size_t CHUNK_SIZE = 128 * 1024;
+
+char GetByte(int64_t position)
+{
+  return static_cast<char>(position * 7 + (position >> 12));
+}
+} // namespace
+
+class TestSparseFileCache : public ::testing::Test
+{
+protected:
+  void SetUp() override { ASSERT_EQ(CACHE_RC_OK, m_cache.Open()); }
+
+  void TearDown() override { m_cache.Close(); }
+
+  // emulate CFileCache: move the source to where the cache wants to continue
+  bool SeekSource(int64_t position)
+  {
+    m_source = m_cache.CachedDataEndPosIfSeekTo(position);
+    return m_cache.Reset(position);
+  }
+
+  void Fill(int64_t end)
+  {
+    std::vector<char> buffer(CHUNK_SIZE);
+    end = std::min(end, FILE_SIZE);
+    while (m_source < end)
+    {
+      const size_t size = static_cast<size_t>(std::min<int64_t>(CHUNK_SIZE, end - m_source));
+      ASSERT_GE(m_cache.GetMaxWriteSize(size), size);
+      for (size_t i = 0; i < size; i++)
+        buffer[i] = GetByte(m_source + i);
+      ASSERT_EQ(static_cast<int>(size), m_cache.WriteToCache(buffer.data(), size));
+      m_source += size;
+    }
+    if (m_source == FILE_SIZE)
+      m_cache.EndOfInput();
+  }
+
+  void Verify(int64_t position, int64_t size)
+  {
+    std::vector<char> buffer(static_cast<size_t>(size));
+    int64_t read = 0;
+    while (read < size)
+    {
+      const int rc = m_cache.ReadFromCache(buffer.data() + read, size - read);
+      ASSERT_GT(rc, 0);
+      read += rc;
+    }
+    for (int64_t i = 0; i < size; i++)
+      ASSERT_EQ(GetByte(position + i), buffer[i]);
+  }
+
+  CSparseFileCache m_cache{FILE_SIZE, CHUNK_SIZE, 8 * MB};
+  int64_t m_source = 0;
+};
+
+TEST_F(TestSparseFileCache, KeepsRangesAcrossSeeks)
+{
+  SeekSource(0);
+  Fill(3 * MB);
+  Verify(0, 3 * MB);
+
+  // a seek outside of the cached data restarts the source at a block boundary
+  const int64_t target = 10 * MB + 777;
+  EXPECT_EQ(CACHE_RC_ERROR, m_cache.Seek(target));
+  EXPECT_TRUE(SeekSource(target));
+  EXPECT_EQ(10 * MB, m_source);
+  Fill(12 * MB);
+  Verify(target, MB);
+  EXPECT_EQ(10 * MB, m_cache.CachedDataStartPos());
+  EXPECT_EQ(12 * MB, m_cache.CachedDataEndPos());
+
+  // going back never needs the source
+  EXPECT_EQ(1000, m_cache.Seek(1000));
+  Verify(1000, 2 * MB);
+  EXPECT_FALSE(m_cache.IsCachedPosition(5 * MB));
+}
+
+TEST_F(TestSparseFileCache, ResumesAtEndOfCachedRange)
+{
+  SeekSource(0);
+  Fill(4 * MB);
+  Verify(0, MB);
+
+  // data after the seek position is already there, so no full reset
+  EXPECT_FALSE(SeekSource(2 * MB));
+  EXPECT_EQ(4 * MB, m_source);
+  EXPECT_EQ(2 * MB, m_cache.WaitForData(0, 0ms));
+}
+
+TEST_F(TestSparseFileCache, RefillsHoleAfterEndOfInput)
+{
+  SeekSource(0);
+  Fill(2 * MB);
+  Verify(0, 2 * MB);
+
+  EXPECT_TRUE(SeekSource(16 * MB));
+  Fill(FILE_SIZE);
+  Verify(16 * MB, FILE_SIZE - 16 * MB);
+  char byte;
+  EXPECT_EQ(0, m_cache.ReadFromCache(&byte, 1));
+
+  // reading on from cached data into a hole must not end the file
+  EXPECT_EQ(MB, m_cache.Seek(MB));
+  Verify(MB, MB);
+  EXPECT_EQ(CACHE_RC_WOULD_BLOCK, m_cache.ReadFromCache(&byte, 1));
+  EXPECT_EQ(CACHE_RC_TIMEOUT, m_cache.WaitForData(1, 10ms));
+
+  // the source restarts at the hole
+  EXPECT_TRUE(SeekSource(2 * MB));
+  EXPECT_EQ(2 * MB, m_source);
+  m_cache.ClearEndOfInput();
+  Fill(4 * MB);
+  Verify(2 * MB, 2 * MB);
+}
+
+TEST_F(TestSparseFileCache, EvictsLeastRecentlyUsed)
+{
+  SeekSource(0);
+
+  int64_t position = 0;
+  while (position < FILE_SIZE)
+  {
+    Fill(m_source + MB);
+    const int64_t available = m_cache.WaitForData(0, 0ms);
+    Verify(position, available);
+    position += available;
+  }
+  EXPECT_EQ(0, m_cache.ReadFromCache(nullptr, 0));
+
+  // the start of the file didn't fit, the end is still there
+  EXPECT_FALSE(m_cache.IsCachedPosition(0));
+  EXPECT_EQ(FILE_SIZE - 10, m_cache.Seek(FILE_SIZE - 10));
+  Verify(FILE_SIZE - 10, 10);
+}
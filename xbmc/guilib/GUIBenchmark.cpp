@@ -0,0 +1,218 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIBenchmark.h"
+
+#include "GUIComponent.h"
+#include "GUIWindowManager.h"
+#include "ServiceBroker.h"
+#include "addons/AddonVersion.h"
+#include "addons/Skin.h"
+#include "filesystem/File.h"
+#include "input/WindowTranslator.h"
+#include "messaging/ApplicationMessenger.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/SystemInfo.h"
+#include "utils/Variant.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+bool CGUIBenchmark::m_bIsRunning = false;
+
+CGUIBenchmark& CGUIBenchmark::Instance()
+{
+  static CGUIBenchmark _instance;
+  return _instance;
+}
+
+bool CGUIBenchmark::Start(const std::string& scriptFile, const std::string& reportFile)
+{
+  if (m_bIsRunning)
+    return false;
+
+  if (!LoadScript(scriptFile))
+    return false;
+
+  CLog::Log(LOGINFO, "GUI benchmark: running {} ({} steps)", scriptFile, m_steps.size());
+
+  m_reportFile = reportFile;
+  m_results.clear();
+  m_currentStep = 0;
+  m_bIsRunning = true;
+  CGUIControlProfiler::SetCounting(true);
+  m_lastCounters = CGUIControlProfiler::Instance().GetCounters();
+  BeginStep();
+  return true;
+}
+
+bool CGUIBenchmark::LoadScript(const std::string& scriptFile)
+{
+  CXBMCTinyXML doc;
+  if (!doc.LoadFile(scriptFile))
+  {
+    CLog::Log(LOGERROR, "GUI benchmark: unable to load {} (line {}: {})", scriptFile,
+              doc.ErrorRow(), doc.ErrorDesc());
+    return false;
+  }
+
+  const TiXmlElement* root = doc.RootElement();
+  if (!root || root->ValueStr() != "benchmark")
+  {
+    CLog::Log(LOGERROR, "GUI benchmark: {} has no <benchmark> tag", scriptFile);
+    return false;
+  }
+
+  m_steps.clear();
+  for (const TiXmlElement* step = root->FirstChildElement("step"); step;
+       step = step->NextSiblingElement("step"))
+  {
+    int frames = 0;
+    if (!step->FirstChild() || step->QueryIntAttribute("frames", &frames) != TIXML_SUCCESS ||
+        frames <= 0)
+    {
+      CLog::Log(LOGERROR, "GUI benchmark: ignoring step without command or frame count in {}",
+                scriptFile);
+      continue;
+    }
+    m_steps.push_back({step->FirstChild()->ValueStr(), static_cast<unsigned int>(frames)});
+  }
+
+  if (m_steps.empty())
+  {
+    CLog::Log(LOGERROR, "GUI benchmark: {} has no steps", scriptFile);
+    return false;
+  }
+  return true;
+}
+
+void CGUIBenchmark::BeginStep()
+{
+  const Step& step = m_steps[m_currentStep];
+  m_results.push_back({step.command, "", {}});
+  m_results.back().frames.reserve(step.frames);
+
+  // executed with the next frame, as if the command came from any other client
+  CServiceBroker::GetAppMessenger()->PostMsg(TMSG_EXECUTE_BUILT_IN, -1, -1, nullptr,
+                                             step.command);
+}
+
+void CGUIBenchmark::EndFrame()
+{
+  const CGUIControlProfiler::FrameCounters& counters =
+      CGUIControlProfiler::Instance().GetCounters();
+
+  StepResult& result = m_results.back();
+  result.frames.emplace_back(counters - m_lastCounters);
+  m_lastCounters = counters;
+
+  if (result.frames.size() < m_steps[m_currentStep].frames)
+    return;
+
+  result.window = CWindowTranslator::TranslateWindow(
+      CServiceBroker::GetGUI()->GetWindowManager().GetActiveWindowOrDialog());
+
+  if (++m_currentStep < m_steps.size())
+    BeginStep();
+  else
+    Finish();
+}
+
+void CGUIBenchmark::Finish()
+{
+  m_bIsRunning = false;
+  CGUIControlProfiler::SetCounting(false);
+
+  if (WriteReport())
+    CLog::Log(LOGINFO, "GUI benchmark: report written to {}", m_reportFile);
+  else
+    CLog::Log(LOGERROR, "GUI benchmark: unable to write report to {}", m_reportFile);
+
+  CServiceBroker::GetAppMessenger()->PostMsg(TMSG_QUIT);
+}
+
+CVariant CGUIBenchmark::Summarize(const std::vector<CGUIControlProfiler::FrameCounters>& frames)
+{
+  using FrameCounters = CGUIControlProfiler::FrameCounters;
+
+  CVariant summary(CVariant::VariantTypeObject);
+  summary["frames"] = static_cast<unsigned int>(frames.size());
+  if (frames.empty())
+    return summary;
+
+  const double count = static_cast<double>(frames.size());
+
+  // times are recorded in units of 10us, report them in ms
+  const auto addTime = [&](const char* name, const char* type,
+                           unsigned int FrameCounters::*member) {
+    unsigned int total = 0;
+    unsigned int max = 0;
+    for (const auto& frame : frames)
+    {
+      total += frame.*member;
+      max = std::max(max, frame.*member);
+    }
+    summary[name][type]["average"] = total / 100.0 / count;
+    summary[name][type]["max"] = max / 100.0;
+  };
+  const auto addAverage = [&](const char* name, unsigned int FrameCounters::*member) {
+    unsigned int total = 0;
+    for (const auto& frame : frames)
+      total += frame.*member;
+    summary[name] = total / count;
+  };
+
+  addTime("framemove", "wall", &FrameCounters::frameMoveTime);
+  addTime("framemove", "cpu", &FrameCounters::frameMoveCpuTime);
+  addTime("process", "wall", &FrameCounters::processTime);
+  addTime("process", "cpu", &FrameCounters::processCpuTime);
+  addTime("render", "wall", &FrameCounters::renderTime);
+  addTime("render", "cpu", &FrameCounters::renderCpuTime);
+  addTime("present", "wall", &FrameCounters::presentTime);
+  addTime("present", "cpu", &FrameCounters::presentCpuTime);
+  addAverage("texturedrawcalls", &FrameCounters::textureDrawCalls);
+  addAverage("textures", &FrameCounters::textures);
+  addAverage("textdrawcalls", &FrameCounters::textDrawCalls);
+  addAverage("textureuploads", &FrameCounters::textureUploads);
+  addAverage("infoevaluations", &FrameCounters::infoEvaluations);
+  return summary;
+}
+
+bool CGUIBenchmark::WriteReport() const
+{
+  CVariant report(CVariant::VariantTypeObject);
+  report["version"] = CSysInfo::GetVersion();
+  if (g_SkinInfo)
+  {
+    report["skin"] = g_SkinInfo->ID();
+    report["skinversion"] = g_SkinInfo->Version().asString();
+  }
+
+  std::vector<CGUIControlProfiler::FrameCounters> allFrames;
+  report["steps"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto& result : m_results)
+  {
+    CVariant step = Summarize(result.frames);
+    step["command"] = result.command;
+    step["window"] = result.window;
+    report["steps"].push_back(step);
+    allFrames.insert(allFrames.end(), result.frames.begin(), result.frames.end());
+  }
+  report["total"] = Summarize(allFrames);
+
+  std::string json;
+  if (!CJSONVariantWriter::Write(report, json, false))
+    return false;
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(m_reportFile, true))
+    return false;
+
+  return file.Write(json.c_str(), json.size()) == static_cast<ssize_t>(json.size());
+}
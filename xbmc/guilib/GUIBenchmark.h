@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+/*!
+\file GUIBenchmark.h
+\brief
+*/
+
+#include "GUIControlProfiler.h"
+
+#include <string>
+#include <vector>
+
+class CVariant;
+
+/*!
+ \ingroup winman
+ \brief Scripted, repeatable measurement of the GUI render loop.
+
+ A benchmark script is an XML file listing builtin commands, each followed by the
+ number of frames to record afterwards:
+
+ \code{.xml}
+ <benchmark>
+   <step frames="300">ActivateWindow(Home)</step>
+   <step frames="60">Action(Down)</step>
+ </benchmark>
+ \endcode
+
+ For every frame the time spent in FrameMove, Process, Render and presenting is recorded
+ along with the draw calls, texture uploads and info evaluations. Times are reported both as
+ wall clock ("wall") and as CPU time of the render thread ("cpu"), so time spent waiting for
+ the GPU or vsync shows up as the difference. When the script is done a JSON report is written
+ and the application quits.
+
+ The off-screen mode of the GBM windowing avoids the need for a connected display, but it still
+ renders through a DRM device, so this is not a fully headless mode: CI machines need a GPU (or
+ a virtual DRM driver such as vkms) to run it.
+ */
+class CGUIBenchmark
+{
+public:
+  static CGUIBenchmark& Instance();
+  static bool IsRunning() { return m_bIsRunning; }
+
+  /*!
+   \brief Load a benchmark script and start running it with the next frame.
+
+   \param scriptFile path of the benchmark script
+   \param reportFile path the JSON report is written to
+   \return true if the script was loaded
+   */
+  bool Start(const std::string& scriptFile, const std::string& reportFile);
+
+  /*! \brief Record the frame that was just presented and advance the script
+   */
+  void EndFrame();
+
+private:
+  CGUIBenchmark() = default;
+  ~CGUIBenchmark() = default;
+  CGUIBenchmark(const CGUIBenchmark&) = delete;
+  CGUIBenchmark& operator=(const CGUIBenchmark&) = delete;
+
+  struct Step
+  {
+    std::string command;
+    unsigned int frames;
+  };
+
+  struct StepResult
+  {
+    std::string command;
+    std::string window;
+    std::vector<CGUIControlProfiler::FrameCounters> frames;
+  };
+
+  bool LoadScript(const std::string& scriptFile);
+  void BeginStep();
+  void Finish();
+  bool WriteReport() const;
+  static CVariant Summarize(const std::vector<CGUIControlProfiler::FrameCounters>& frames);
+
+  static bool m_bIsRunning;
+  std::string m_reportFile;
+  std::vector<Step> m_steps;
+  std::vector<StepResult> m_results;
+  size_t m_currentStep = 0;
+  CGUIControlProfiler::FrameCounters m_lastCounters;
+};
@@ -12,7 +12,57 @@
 #include "utils/TimeUtils.h"
 #include "utils/XBMCTinyXML.h"
 
+#if defined(TARGET_WINDOWS)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace
+{
+// CPU time consumed by the calling thread in ns, 0 if unavailable
+int64_t GetThreadCpuTime()
+{
+#if defined(TARGET_WINDOWS)
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+    return 0;
+  const auto toInt = [](const FILETIME& time) {
+    return (static_cast<int64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+  };
+  // 100ns units
+  return (toInt(kernelTime) + toInt(userTime)) * 100;
+#else
+  timespec time;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+    return 0;
+  return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+#endif
+}
+} // namespace
+
 bool CGUIControlProfiler::m_bIsRunning = false;
+bool CGUIControlProfiler::m_bIsCounting = false;
+
+CGUIControlProfiler::FrameCounters CGUIControlProfiler::FrameCounters::operator-(
+    const FrameCounters& right) const
+{
+  FrameCounters result;
+  result.textDrawCalls = textDrawCalls - right.textDrawCalls;
+  result.textureDrawCalls = textureDrawCalls - right.textureDrawCalls;
+  result.textures = textures - right.textures;
+  result.textureUploads = textureUploads - right.textureUploads;
+  result.infoEvaluations = infoEvaluations - right.infoEvaluations;
+  result.frameMoveTime = frameMoveTime - right.frameMoveTime;
+  result.processTime = processTime - right.processTime;
+  result.renderTime = renderTime - right.renderTime;
+  result.presentTime = presentTime - right.presentTime;
+  result.frameMoveCpuTime = frameMoveCpuTime - right.frameMoveCpuTime;
+  result.processCpuTime = processCpuTime - right.processCpuTime;
+  result.renderCpuTime = renderCpuTime - right.renderCpuTime;
+  result.presentCpuTime = presentCpuTime - right.presentCpuTime;
+  return result;
+}
 
 CGUIControlProfilerItem::CGUIControlProfilerItem(CGUIControlProfiler* pProfiler,
                                                  CGUIControlProfilerItem* pParent,
@@ -243,6 +293,7 @@ bool CGUIControlProfiler::IsRunning(void)
 void CGUIControlProfiler::Start(void)
 {
   m_iFrameCount = 0;
+  m_startCounters = m_counters;
   m_bIsRunning = true;
   m_pLastItem = NULL;
   m_ItemHead.Reset(this);
@@ -300,6 +351,43 @@ CGUIControlProfilerItem *CGUIControlProfiler::FindOrAddControl(CGUIControl *pCon
   return m_pLastItem;
 }
 
+CGUIControlProfiler::FrameStageStart CGUIControlProfiler::BeginFrameStage()
+{
+  if (!IsCounting())
+    return {};
+  return {CurrentHostCounter(), GetThreadCpuTime()};
+}
+
+void CGUIControlProfiler::AddFrameStageTime(FrameStage stage, const FrameStageStart& start)
+{
+  // counting may have started during the stage
+  if (!start.wallTime)
+    return;
+
+  const auto time =
+      static_cast<unsigned int>(m_fPerfScale * (CurrentHostCounter() - start.wallTime));
+  const auto cpuTime = static_cast<unsigned int>((GetThreadCpuTime() - start.cpuTime) / 10000);
+  switch (stage)
+  {
+    case FrameStage::FRAMEMOVE:
+      m_counters.frameMoveTime += time;
+      m_counters.frameMoveCpuTime += cpuTime;
+      break;
+    case FrameStage::PROCESS:
+      m_counters.processTime += time;
+      m_counters.processCpuTime += cpuTime;
+      break;
+    case FrameStage::RENDER:
+      m_counters.renderTime += time;
+      m_counters.renderCpuTime += cpuTime;
+      break;
+    case FrameStage::PRESENT:
+      m_counters.presentTime += time;
+      m_counters.presentCpuTime += cpuTime;
+      break;
+  }
+}
+
 void CGUIControlProfiler::EndFrame(void)
 {
   m_iFrameCount++;
@@ -332,6 +420,20 @@ bool CGUIControlProfiler::SaveResults(void)
   std::string str = std::to_string(m_iFrameCount);
   root->SetAttribute("framecount", str.c_str());
   root->SetAttribute("timeunit", "ms");
+  if (m_iFrameCount > 0)
+  {
+    const FrameCounters counters = m_counters - m_startCounters;
+    str = StringUtils::Format("{:.1f}", static_cast<float>(counters.textDrawCalls) / m_iFrameCount);
+    root->SetAttribute("textdrawcallsperframe", str.c_str());
+    str = StringUtils::Format("{:.1f}", static_cast<float>(counters.textureDrawCalls) / m_iFrameCount);
+    root->SetAttribute("texturedrawcallsperframe", str.c_str());
+    str = StringUtils::Format("{:.1f}", static_cast<float>(counters.textures) / m_iFrameCount);
+    root->SetAttribute("texturesperframe", str.c_str());
+    str = StringUtils::Format("{:.1f}", static_cast<float>(counters.infoEvaluations) / m_iFrameCount);
+    root->SetAttribute("infoevaluationsperframe", str.c_str());
+    str = StringUtils::Format("{:.1f}", static_cast<float>(counters.textureUploads) / m_iFrameCount);
+    root->SetAttribute("textureuploadsperframe", str.c_str());
+  }
   doc.LinkEndChild(root);
 
   m_ItemHead.SaveToXML(root);
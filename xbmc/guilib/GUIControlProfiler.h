@@ -48,8 +48,34 @@ public:
 class CGUIControlProfiler
 {
 public:
+  /*! \brief Running totals of per-frame work, kept while the profiler or a benchmark is running
+   The totals only ever grow, so users take the difference of two snapshots.
+   Times are in units of 10us.
+   */
+  struct FrameCounters
+  {
+    unsigned int textDrawCalls = 0;
+    unsigned int textureDrawCalls = 0;
+    unsigned int textures = 0;
+    unsigned int textureUploads = 0;
+    unsigned int infoEvaluations = 0;
+    // frame stage times in units of 10us, wall clock and CPU time of the thread running them
+    unsigned int frameMoveTime = 0;
+    unsigned int processTime = 0;
+    unsigned int renderTime = 0;
+    unsigned int presentTime = 0;
+    unsigned int frameMoveCpuTime = 0;
+    unsigned int processCpuTime = 0;
+    unsigned int renderCpuTime = 0;
+    unsigned int presentCpuTime = 0;
+
+    FrameCounters operator-(const FrameCounters& right) const;
+  };
+
   static CGUIControlProfiler &Instance(void);
   static bool IsRunning(void);
+  static bool IsCounting(void) { return m_bIsRunning || m_bIsCounting; }
+  static void SetCounting(bool counting) { m_bIsCounting = counting; }
 
   void Start(void);
   void EndFrame(void);
@@ -57,6 +83,30 @@ public:
   void EndVisibility(CGUIControl *pControl);
   void BeginRender(CGUIControl *pControl);
   void EndRender(CGUIControl *pControl);
+  void AddTextDrawCalls(unsigned int count) { m_counters.textDrawCalls += count; }
+  void AddTextureDrawCalls(unsigned int count, unsigned int textures)
+  {
+    m_counters.textureDrawCalls += count;
+    m_counters.textures += textures;
+  }
+  void AddTextureUploads(unsigned int count) { m_counters.textureUploads += count; }
+  void AddInfoEvaluations(unsigned int count) { m_counters.infoEvaluations += count; }
+
+  enum class FrameStage
+  {
+    FRAMEMOVE, ///< CApplication::FrameMove(), including Process()
+    PROCESS, ///< CGUIWindowManager::Process()
+    RENDER, ///< rendering the GUI and video layers, up to EndRender()
+    PRESENT, ///< flipping the buffers
+  };
+  struct FrameStageStart
+  {
+    int64_t wallTime = 0; ///< CurrentHostCounter()
+    int64_t cpuTime = 0; ///< CPU time of the calling thread in ns
+  };
+  static FrameStageStart BeginFrameStage();
+  void AddFrameStageTime(FrameStage stage, const FrameStageStart& start);
+  const FrameCounters& GetCounters() const { return m_counters; }
   int GetMaxFrameCount(void) const { return m_iMaxFrameCount; }
   void SetMaxFrameCount(int iMaxFrameCount) { m_iMaxFrameCount = iMaxFrameCount; }
   void SetOutputFile(const std::string& strOutputFile) { m_strOutputFile = strOutputFile; }
@@ -76,13 +126,21 @@ private:
   CGUIControlProfilerItem *FindOrAddControl(CGUIControl *pControl);
 
   static bool m_bIsRunning;
+  static bool m_bIsCounting;
   std::string m_strOutputFile;
   int m_iMaxFrameCount = 200;
   int m_iFrameCount = 0;
+  FrameCounters m_counters;
+  FrameCounters m_startCounters; ///< m_counters when the profiler was started
 };
 
 #define GUIPROFILER_VISIBILITY_BEGIN(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().BeginVisibility(x); }
 #define GUIPROFILER_VISIBILITY_END(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().EndVisibility(x); }
 #define GUIPROFILER_RENDER_BEGIN(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().BeginRender(x); }
 #define GUIPROFILER_RENDER_END(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().EndRender(x); }
+#define GUIPROFILER_TEXT_DRAWCALLS(x) { if (CGUIControlProfiler::IsCounting()) CGUIControlProfiler::Instance().AddTextDrawCalls(x); }
+#define GUIPROFILER_TEXTURE_DRAWCALLS(x, y) { if (CGUIControlProfiler::IsCounting()) CGUIControlProfiler::Instance().AddTextureDrawCalls(x, y); }
+#define GUIPROFILER_FRAME_STAGE(x, y) { if (CGUIControlProfiler::IsCounting()) CGUIControlProfiler::Instance().AddFrameStageTime(x, y); }
+#define GUIPROFILER_TEXTURE_UPLOADS(x) { if (CGUIControlProfiler::IsCounting()) CGUIControlProfiler::Instance().AddTextureUploads(x); }
+#define GUIPROFILER_INFO_EVALUATIONS(x) { if (CGUIControlProfiler::IsCounting()) CGUIControlProfiler::Instance().AddInfoEvaluations(x); }
 
@@ -221,6 +221,7 @@ CGUIFont* GUIFontManager::LoadTTF(const std::string& strFontName,
   CGUIFont* pNewFont = new CGUIFont(strFontName, iStyle, textColor, shadowColor, lineSpacing,
                                     static_cast<float>(iSize), pFontFile);
   m_vecFonts.emplace_back(pNewFont);
+  pFontFile->PrecacheCharacters(iStyle);
 
   // Store the original TTF font info in case we need to reload it in a different resolution
   OrigFontInfo fontInfo;
@@ -307,6 +308,7 @@ void GUIFontManager::ReloadTTFFonts(void)
     }
 
     font->SetFont(pFontFile);
+    pFontFile->PrecacheCharacters(font->GetStyle());
   }
 }
 
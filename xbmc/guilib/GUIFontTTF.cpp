@@ -14,15 +14,21 @@
 #include "URL.h"
 #include "filesystem/File.h"
 #include "filesystem/SpecialProtocol.h"
+#include "jobs/Job.h"
+#include "jobs/JobManager.h"
 #include "rendering/RenderSystem.h"
+#include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
 #include "utils/MathUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
 
+#include <algorithm>
+#include <atomic>
 #include <math.h>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <utility>
 
@@ -60,6 +66,10 @@ constexpr int GLYPH_STRENGTH_BOLD = 24;
 constexpr int GLYPH_STRENGTH_LIGHT = -48;
 constexpr int TAB_SPACE_LENGTH = 4;
 
+// characters rasterized in the background by CGUIFontTTF::PrecacheCharacters()
+// (printable ASCII and Latin-1)
+constexpr std::pair<character_t, character_t> PRECACHE_RANGES[] = {{0x20, 0x7E}, {0xA0, 0xFF}};
+
 // \brief Check for conflicting alignments
 void ValidateAlignments(uint32_t& aligns)
 {
@@ -106,6 +116,9 @@ public:
                   float aspect,
                   std::vector<uint8_t>& memoryBuf)
   {
+    // faces are also opened by the glyph precache jobs
+    std::unique_lock lock(m_section);
+
     // don't have it yet - create it
     if (!m_library)
       FT_Init_FreeType(&m_library);
@@ -162,6 +175,7 @@ public:
 
   FT_Stroker GetStroker()
   {
+    std::unique_lock lock(m_section);
     if (!m_library)
       return nullptr;
 
@@ -172,25 +186,122 @@ public:
     return stroker;
   };
 
-  static void ReleaseFont(FT_Face face)
+  void ReleaseFont(FT_Face face)
   {
     assert(face);
+    std::unique_lock lock(m_section);
     FT_Done_Face(face);
   };
 
-  static void ReleaseStroker(FT_Stroker stroker)
+  void ReleaseStroker(FT_Stroker stroker)
   {
     assert(stroker);
+    std::unique_lock lock(m_section);
     FT_Stroker_Done(stroker);
   }
 
 private:
   FT_Library m_library{nullptr};
+  CCriticalSection m_section;
 };
 
 XBMC_GLOBAL_REF(CFreeTypeLibrary, g_freeTypeLibrary); // our freetype library
 #define g_freeTypeLibrary XBMC_GLOBAL_USE(CFreeTypeLibrary)
 
+/*!
+ \brief Glyphs rasterized by a CPrecacheJob, waiting to be copied to the glyph texture.
+ */
+struct CGUIFontTTF::CPrecache
+{
+  struct RenderedGlyph
+  {
+    FT_UInt m_glyphIndex;
+    FT_Glyph m_glyph;
+    float m_advance;
+  };
+
+  ~CPrecache()
+  {
+    for (const RenderedGlyph& glyph : m_glyphs)
+      FT_Done_Glyph(glyph.m_glyph);
+  }
+
+  uint32_t m_style{0};
+  std::atomic<bool> m_cancelled{false};
+  std::atomic<bool> m_done{false};
+  std::vector<RenderedGlyph> m_glyphs; // owned by the job until m_done is set
+};
+
+/*!
+ \brief Rasterizes the glyphs of PRECACHE_RANGES using a face of its own, as FreeType faces can't
+ be shared between threads.
+ */
+class CGUIFontTTF::CPrecacheJob : public CJob
+{
+public:
+  CPrecacheJob(std::shared_ptr<CPrecache> precache,
+               const std::string& filename,
+               float height,
+               float aspect,
+               FT_Pos borderStrength)
+    : m_precache(std::move(precache)),
+      m_filename(filename),
+      m_height(height),
+      m_aspect(aspect),
+      m_borderStrength(borderStrength)
+  {
+  }
+
+  ~CPrecacheJob() override { m_precache->m_done = true; }
+
+  bool DoWork() override
+  {
+    std::vector<uint8_t> fontFileInMemory;
+    FT_Face face = g_freeTypeLibrary.GetFont(m_filename, m_height, m_aspect, fontFileInMemory);
+    if (!face)
+      return false;
+
+    FT_Stroker stroker = nullptr;
+    if (m_borderStrength)
+    {
+      stroker = g_freeTypeLibrary.GetStroker();
+      if (stroker)
+        FT_Stroker_Set(stroker, m_borderStrength, FT_STROKER_LINECAP_ROUND,
+                       FT_STROKER_LINEJOIN_ROUND, 0);
+    }
+
+    for (const auto& [first, last] : PRECACHE_RANGES)
+    {
+      for (character_t letter = first; letter <= last && !m_precache->m_cancelled; ++letter)
+      {
+        const FT_UInt glyphIndex = FT_Get_Char_Index(face, letter);
+        if (!glyphIndex)
+          continue;
+
+        float advance = 0.0f;
+        FT_Glyph glyph = RenderGlyph(face, stroker, glyphIndex, m_precache->m_style, advance);
+        if (glyph)
+          m_precache->m_glyphs.push_back({glyphIndex, glyph, advance});
+      }
+    }
+
+    if (stroker)
+      g_freeTypeLibrary.ReleaseStroker(stroker);
+    g_freeTypeLibrary.ReleaseFont(face);
+
+    return true;
+  }
+
+  const char* GetType() const override { return "fontprecache"; }
+
+private:
+  std::shared_ptr<CPrecache> m_precache;
+  std::string m_filename;
+  float m_height;
+  float m_aspect;
+  FT_Pos m_borderStrength;
+};
+
 CGUIFontTTF::CGUIFontTTF(const std::string& fontIdent)
   : m_fontIdent(fontIdent),
     m_staticCache(*this),
@@ -236,6 +347,8 @@ void CGUIFontTTF::ClearCharacterCache()
 
 void CGUIFontTTF::Clear()
 {
+  CancelPrecache();
+
   m_texture.reset();
   m_texture = nullptr;
   memset(m_charquick, 0, sizeof(m_charquick));
@@ -268,6 +381,9 @@ bool CGUIFontTTF::Load(
   if (!m_face)
     return false;
 
+  m_strFilename = strFilename;
+  m_aspect = aspect;
+
   m_hbFont = hb_ft_font_create(m_face, 0);
   if (!m_hbFont)
     return false;
@@ -304,6 +420,7 @@ bool CGUIFontTTF::Load(
 
     cellDescender -= strength;
     cellAscender += strength;
+    m_borderStrength = strength;
 
     m_stroker = g_freeTypeLibrary.GetStroker();
     if (m_stroker)
@@ -342,6 +459,9 @@ bool CGUIFontTTF::Load(
 
 void CGUIFontTTF::Begin()
 {
+  if (m_nestedBeginCount == 0 && !m_cachingCharacter)
+    AddPrecachedCharacters();
+
   if (m_nestedBeginCount == 0 && m_texture && FirstBegin())
   {
     m_vertexTrans.clear();
@@ -362,6 +482,77 @@ void CGUIFontTTF::End()
   LastEnd();
 }
 
+void CGUIFontTTF::PrecacheCharacters(uint32_t style)
+{
+  style &= FONT_STYLE_BOLD | FONT_STYLE_ITALICS | FONT_STYLE_LIGHT;
+  if (!m_face || (m_precachedStyles & (1 << style)))
+    return;
+
+  m_precachedStyles |= 1 << style;
+
+  auto precache = std::make_shared<CPrecache>();
+  precache->m_style = style;
+  m_precaches.emplace_back(precache);
+
+  CServiceBroker::GetJobManager()->AddJob(
+      new CPrecacheJob(precache, m_strFilename, m_height, m_aspect, m_borderStrength), nullptr,
+      CJob::PRIORITY_NORMAL);
+}
+
+void CGUIFontTTF::AddPrecachedCharacters()
+{
+  if (m_precaches.empty())
+    return;
+
+  for (auto it = m_precaches.begin(); it != m_precaches.end();)
+  {
+    const CPrecache& precache = **it;
+    if (!precache.m_done)
+    {
+      ++it;
+      continue;
+    }
+
+    size_t added = 0;
+    for (const CPrecache::RenderedGlyph& glyph : precache.m_glyphs)
+    {
+      const character_t glyphAndStyle = (precache.m_style << 16) | glyph.m_glyphIndex;
+      const auto pos = std::lower_bound(m_char.begin(), m_char.end(), glyphAndStyle,
+                                        [](const Character& ch, character_t value)
+                                        { return ch.m_glyphAndStyle < value; });
+      if (pos != m_char.end() && pos->m_glyphAndStyle == glyphAndStyle)
+        continue; // cached on the render thread already
+
+      const auto ch = m_char.emplace(pos);
+      if (!CacheGlyph(glyph.m_glyph, glyph.m_glyphIndex, precache.m_style, glyph.m_advance,
+                      &*ch))
+      {
+        // texture is full, the remaining characters are cached on demand
+        m_char.erase(ch);
+        break;
+      }
+      added++;
+    }
+
+    if (added)
+    {
+      UpdateCharacterLookup(0);
+      CLog::LogF(LOGDEBUG, "Added {} precached characters to font {}", added, m_fontIdent);
+    }
+
+    it = m_precaches.erase(it);
+  }
+}
+
+void CGUIFontTTF::CancelPrecache()
+{
+  for (const auto& precache : m_precaches)
+    precache->m_cancelled = true;
+
+  m_precaches.clear();
+  m_precachedStyles = 0;
+}
+
 void CGUIFontTTF::DrawTextInternal(CGraphicContext& context,
                                    float x,
                                    float y,
@@ -963,6 +1154,9 @@ CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr, FT_UInt glyph
   if (nestedBeginCount)
     End();
 
+  // low has to stay valid, so the precached characters wait for the next Begin()
+  m_cachingCharacter = true;
+
   m_char.emplace(m_char.begin() + low);
   if (!CacheCharacter(glyphIndex, style, m_char.data() + low))
   { // unable to cache character - try clearing them all out and starting over
@@ -978,6 +1172,7 @@ CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr, FT_UInt glyph
       if (nestedBeginCount)
         Begin();
       m_nestedBeginCount = nestedBeginCount;
+      m_cachingCharacter = false;
       return nullptr;
     }
   }
@@ -985,8 +1180,16 @@ CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr, FT_UInt glyph
   if (nestedBeginCount)
     Begin();
   m_nestedBeginCount = nestedBeginCount;
+  m_cachingCharacter = false;
 
   // update the lookup table with only the m_char addresses that have changed
+  UpdateCharacterLookup(startIndex);
+
+  return m_char.data() + low;
+}
+
+void CGUIFontTTF::UpdateCharacterLookup(size_t startIndex)
+{
   for (size_t i = startIndex; i < m_char.size(); ++i)
   {
     if (m_char[i].m_glyphIndex < MAX_GLYPH_IDX)
@@ -998,43 +1201,67 @@ CGUIFontTTF::Character* CGUIFontTTF::GetCharacter(character_t chr, FT_UInt glyph
         m_charquick[ch] = m_char.data() + i;
     }
   }
-
-  return m_char.data() + low;
 }
 
 bool CGUIFontTTF::CacheCharacter(FT_UInt glyphIndex, uint32_t style, Character* ch)
+{
+  float advance = 0.0f;
+  FT_Glyph glyph = RenderGlyph(m_face, m_stroker, glyphIndex, style, advance);
+  if (!glyph)
+    return false;
+
+  const bool cached = CacheGlyph(glyph, glyphIndex, style, advance, ch);
+
+  // free the glyph
+  FT_Done_Glyph(glyph);
+
+  return cached;
+}
+
+FT_Glyph CGUIFontTTF::RenderGlyph(
+    FT_Face face, FT_Stroker stroker, FT_UInt glyphIndex, uint32_t style, float& advance)
 {
   FT_Glyph glyph = nullptr;
-  if (FT_Load_Glyph(m_face, glyphIndex, FT_LOAD_TARGET_LIGHT))
+  if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_TARGET_LIGHT))
   {
     CLog::LogF(LOGDEBUG, "Failed to load glyph {:x}", glyphIndex);
-    return false;
+    return nullptr;
   }
 
   // make bold if applicable
   if (style & FONT_STYLE_BOLD)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_BOLD);
+    SetGlyphStrength(face, face->glyph, GLYPH_STRENGTH_BOLD);
   // and italics if applicable
   if (style & FONT_STYLE_ITALICS)
-    ObliqueGlyph(m_face->glyph);
+    ObliqueGlyph(face->glyph);
   // and light if applicable
   if (style & FONT_STYLE_LIGHT)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_LIGHT);
+    SetGlyphStrength(face, face->glyph, GLYPH_STRENGTH_LIGHT);
   // grab the glyph
-  if (FT_Get_Glyph(m_face->glyph, &glyph))
+  if (FT_Get_Glyph(face->glyph, &glyph))
   {
     CLog::LogF(LOGDEBUG, "Failed to get glyph {:x}", glyphIndex);
-    return false;
+    return nullptr;
   }
-  if (m_stroker)
-    FT_Glyph_StrokeBorder(&glyph, m_stroker, 0, 1);
+  if (stroker)
+    FT_Glyph_StrokeBorder(&glyph, stroker, 0, 1);
   // render the glyph
   if (FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, nullptr, 1))
   {
     CLog::LogF(LOGDEBUG, "Failed to render glyph {:x} to a bitmap", glyphIndex);
-    return false;
+    FT_Done_Glyph(glyph);
+    return nullptr;
   }
 
+  advance =
+      static_cast<float>(MathUtils::round_int(static_cast<double>(face->glyph->advance.x) / 64));
+
+  return glyph;
+}
+
+bool CGUIFontTTF::CacheGlyph(
+    FT_Glyph glyph, FT_UInt glyphIndex, uint32_t style, float advance, Character* ch)
+{
   FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)glyph;
   FT_Bitmap bitmap = bitGlyph->bitmap;
   bool isEmptyGlyph = (bitmap.width == 0 || bitmap.rows == 0);
@@ -1063,14 +1290,12 @@ bool CGUIFontTTF::CacheCharacter(FT_UInt glyphIndex, uint32_t style, Character*
         {
           CLog::LogF(LOGDEBUG, "New cache texture is too large ({} > {} pixels long)", newHeight,
                      m_renderSystem->GetMaxTextureSize());
-          FT_Done_Glyph(glyph);
           return false;
         }
 
         std::unique_ptr<CTexture> newTexture = ReallocTexture(newHeight);
         if (!newTexture)
         {
-          FT_Done_Glyph(glyph);
           CLog::LogF(LOGDEBUG, "Failed to allocate new texture of height {}", newHeight);
           return false;
         }
@@ -1081,7 +1306,6 @@ bool CGUIFontTTF::CacheCharacter(FT_UInt glyphIndex, uint32_t style, Character*
 
     if (!m_texture)
     {
-      FT_Done_Glyph(glyph);
       CLog::LogF(LOGDEBUG, "no texture to cache character to");
       return false;
     }
@@ -1096,8 +1320,7 @@ bool CGUIFontTTF::CacheCharacter(FT_UInt glyphIndex, uint32_t style, Character*
   ch->m_top = isEmptyGlyph ? 0.0f : (static_cast<float>(m_posY));
   ch->m_right = ch->m_left + bitmap.width;
   ch->m_bottom = ch->m_top + bitmap.rows;
-  ch->m_advance =
-      static_cast<float>(MathUtils::round_int(static_cast<double>(m_face->glyph->advance.x) / 64));
+  ch->m_advance = advance;
 
   // we need only render if we actually have some pixels
   if (!isEmptyGlyph)
@@ -1114,9 +1337,6 @@ bool CGUIFontTTF::CacheCharacter(FT_UInt glyphIndex, uint32_t style, Character*
               static_cast<unsigned short>(ch->m_right - ch->m_left);
   }
 
-  // free the glyph
-  FT_Done_Glyph(glyph);
-
   return true;
 }
 
@@ -1322,13 +1542,13 @@ void CGUIFontTTF::ObliqueGlyph(FT_GlyphSlot slot)
 }
 
 // Embolden code - original taken from freetype2 (ftsynth.c)
-void CGUIFontTTF::SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength)
+void CGUIFontTTF::SetGlyphStrength(FT_Face face, FT_GlyphSlot slot, int glyphStrength)
 {
   if (slot->format != FT_GLYPH_FORMAT_OUTLINE)
     return;
 
   /* some reasonable strength */
-  FT_Pos strength = FT_MulFix(m_face->units_per_EM, m_face->size->metrics.y_scale) / glyphStrength;
+  FT_Pos strength = FT_MulFix(face->units_per_EM, face->size->metrics.y_scale) / glyphStrength;
 
   FT_BBox bbox_before, bbox_after;
   FT_Outline_Get_CBox(&slot->outline, &bbox_before);
@@ -37,12 +37,14 @@ struct FT_FaceRec_;
 struct FT_LibraryRec_;
 struct FT_GlyphSlotRec_;
 struct FT_BitmapGlyphRec_;
+struct FT_GlyphRec_;
 struct FT_StrokerRec_;
 
 typedef struct FT_FaceRec_* FT_Face;
 typedef struct FT_LibraryRec_* FT_Library;
 typedef struct FT_GlyphSlotRec_* FT_GlyphSlot;
 typedef struct FT_BitmapGlyphRec_* FT_BitmapGlyph;
+typedef struct FT_GlyphRec_* FT_Glyph;
 typedef struct FT_StrokerRec_* FT_Stroker;
 
 typedef uint32_t character_t;
@@ -73,6 +75,18 @@ struct SVertex
 #include "GUIFontCache.h"
 
 
+/*!
+ \brief A font file loaded at one size, aspect and border, with the glyph texture it draws from.
+
+ CGUIFont objects that only differ in color or style share one CGUIFontTTF, and with it the glyph
+ texture. Different sizes of the same file are separate instances with their own textures.
+
+ Text is drawn per label: each label's vertices are kept in a cached vertex buffer and drawn with
+ the label's own translation and clip rectangle, so moving or scrolling text doesn't touch the
+ vertices. That is also why text from several labels or fonts isn't merged into one vertex
+ stream, which would bake the positions into the vertices and change the order in which text
+ and textures are painted.
+ */
 class CGUIFontTTF
 {
   // use lookup table for the first 4096 glyphs (almost any letter or symbol) to
@@ -97,6 +111,17 @@ public:
 
   void Begin();
   void End();
+
+  /*!
+   \brief Rasterize the common character set of this font in the background.
+
+   The glyphs are copied to the glyph texture by the first Begin() after they are ready, so text
+   using them doesn't have to interrupt a batch to cache characters on the render thread.
+   \param style the font style, only FONT_STYLE_BOLD, FONT_STYLE_ITALICS and FONT_STYLE_LIGHT
+   change the glyphs
+   */
+  void PrecacheCharacters(uint32_t style);
+
   /* The next two should only be called if we've declared we can do hardware clipping */
   virtual CVertexBuffer CreateVertexBuffer(const std::vector<SVertex>& vertices) const
   {
@@ -134,6 +159,9 @@ protected:
     character_t m_glyphAndStyle;
   };
 
+  struct CPrecache;
+  class CPrecacheJob;
+
   struct RunInfo
   {
     unsigned int m_startOffset;
@@ -173,6 +201,10 @@ protected:
   // Stuff for pre-rendering for speed
   Character* GetCharacter(character_t letter, FT_UInt glyphIndex);
   bool CacheCharacter(FT_UInt glyphIndex, uint32_t style, Character* ch);
+  bool CacheGlyph(FT_Glyph glyph, FT_UInt glyphIndex, uint32_t style, float advance, Character* ch);
+  void UpdateCharacterLookup(size_t startIndex);
+  void AddPrecachedCharacters();
+  void CancelPrecache();
   void RenderCharacter(CGraphicContext& context,
                        float posX,
                        float posY,
@@ -191,7 +223,9 @@ protected:
   virtual void DeleteHardwareTexture() = 0;
 
   // modifying glyphs
-  void SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength);
+  static FT_Glyph RenderGlyph(
+      FT_Face face, FT_Stroker stroker, FT_UInt glyphIndex, uint32_t style, float& advance);
+  static void SetGlyphStrength(FT_Face face, FT_GlyphSlot slot, int glyphStrength);
   static void ObliqueGlyph(FT_GlyphSlot slot);
 
   std::unique_ptr<CTexture>
@@ -223,6 +257,7 @@ protected:
   unsigned int m_maxFontHeight{0};
 
   unsigned int m_nestedBeginCount{0}; // speedups
+  bool m_cachingCharacter{false}; // GetCharacter() must not have m_char change under it
 
   // freetype stuff
   FT_Face m_face{nullptr};
@@ -230,6 +265,14 @@ protected:
 
   hb_font_t* m_hbFont{nullptr};
 
+  // what Load() was called with, to open the font again for PrecacheCharacters()
+  std::string m_strFilename;
+  float m_aspect{1.0f};
+  FT_Pos m_borderStrength{0};
+
+  std::vector<std::shared_ptr<CPrecache>> m_precaches; // background rasterizations in progress
+  uint32_t m_precachedStyles{0}; // bit (1 << style) is set once a style has been requested
+
   float m_originX{0.0f};
   float m_originY{0.0f};
 
@@ -8,6 +8,7 @@
 
 #include "GUIFontTTFDX.h"
 
+#include "GUIControlProfiler.h"
 #include "GUIFontManager.h"
 #include "GUIShaderDX.h"
 #include "TextureDX.h"
@@ -119,6 +120,7 @@ void CGUIFontTTFDX::LastEnd()
 
       // 6 indices and 4 vertices per character
       pGUIShader->DrawIndexed(count * 6, 0, character * 4);
+      GUIPROFILER_TEXT_DRAWCALLS(1);
     }
   }
 
@@ -171,6 +173,7 @@ void CGUIFontTTFDX::LastEnd()
 
         // 6 indices and 4 vertices per character
         pGUIShader->DrawIndexed(count * 6, 0, character * 4);
+        GUIPROFILER_TEXT_DRAWCALLS(1);
       }
     }
 
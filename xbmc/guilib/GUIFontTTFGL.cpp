@@ -8,6 +8,7 @@
 
 #include "GUIFontTTFGL.h"
 
+#include "GUIControlProfiler.h"
 #include "GUIFont.h"
 #include "GUIFontManager.h"
 #include "ServiceBroker.h"
@@ -274,6 +275,7 @@ void CGUIFontTTFGL::LastEnd()
             reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, u)));
 
         glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
+        GUIPROFILER_TEXT_DRAWCALLS(1);
       }
     }
 
@@ -8,6 +8,7 @@
 
 #include "GUIFontTTFGLES.h"
 
+#include "GUIControlProfiler.h"
 #include "GUIFont.h"
 #include "GUIFontManager.h"
 #include "ServiceBroker.h"
@@ -269,6 +270,7 @@ void CGUIFontTTFGLES::LastEnd()
             reinterpret_cast<GLvoid*>(character * sizeof(SVertex) * 4 + offsetof(SVertex, u)));
 
         glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
+        GUIPROFILER_TEXT_DRAWCALLS(1);
       }
 
       glMatrixModview.Pop();
@@ -64,6 +64,13 @@ public:
    */
   const INFO::CSkinVariableString* CreateSkinVariable(const std::string& name, int context);
 
+  /*!
+   \brief Get the files include components have been loaded from so far.
+
+   \return the loaded files, in load order
+   */
+  const std::vector<std::string>& GetFiles() const { return m_files; }
+
 private:
   enum ResolveParamsResult
   {
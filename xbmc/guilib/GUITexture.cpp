@@ -20,6 +20,7 @@
 
 CreateGUITextureFunc CGUITexture::m_createGUITextureFunc;
 DrawQuadFunc CGUITexture::m_drawQuadFunc;
+FlushBatchFunc CGUITexture::m_flushBatchFunc;
 
 CTextureInfo::CTextureInfo()
 {
@@ -35,10 +36,12 @@ CTextureInfo::CTextureInfo(const std::string &file):
 }
 
 void CGUITexture::Register(const CreateGUITextureFunc& createFunction,
-                           const DrawQuadFunc& drawQuadFunction)
+                           const DrawQuadFunc& drawQuadFunction,
+                           const FlushBatchFunc& flushBatchFunction)
 {
   m_createGUITextureFunc = createFunction;
   m_drawQuadFunc = drawQuadFunction;
+  m_flushBatchFunc = flushBatchFunction;
 }
 
 CGUITexture* CGUITexture::CreateTexture(
@@ -70,6 +73,12 @@ void CGUITexture::DrawQuad(const CRect& coords,
   m_drawQuadFunc(coords, color, texture, texCoords, depth, blending);
 }
 
+void CGUITexture::FlushBatch()
+{
+  if (m_flushBatchFunc)
+    m_flushBatchFunc();
+}
+
 CGUITexture::CGUITexture(
     float posX, float posY, float width, float height, const CTextureInfo& texture)
   : m_height(height), m_info(texture)
@@ -392,13 +401,19 @@ bool CGUITexture::AllocResources()
   }
   else if (!IsAllocated())
   {
-    CTextureArray texture = CServiceBroker::GetGUI()->GetTextureManager().Load(m_info.filename);
-
-    // set allocated to true even if we couldn't load the image to save
-    // us hitting the disk every frame
-    m_isAllocated = texture.size() ? NORMAL : NORMAL_FAILED;
-    if (!texture.size())
+    CTextureArray texture;
+    if (!CServiceBroker::GetGUI()->GetTextureManager().LoadAsync(m_info.filename, texture))
+    {
+      // set allocated to true even if we couldn't load the image to save
+      // us hitting the disk every frame
+      m_isAllocated = NORMAL_FAILED;
       return false;
+    }
+    m_decodePending = !texture.size();
+    if (m_decodePending)
+      return false; // still decoding, we try again on the next frame
+
+    m_isAllocated = NORMAL;
     m_texture = texture;
     changed = true;
   }
@@ -531,6 +546,12 @@ void CGUITexture::FreeResources(bool immediately /* = false */)
   }
   else if (m_isAllocated == NORMAL && m_texture.size())
     CServiceBroker::GetGUI()->GetTextureManager().ReleaseTexture(m_info.filename, immediately);
+  else if (m_decodePending)
+  {
+    // nobody would pick up the decoded image otherwise
+    CServiceBroker::GetGUI()->GetTextureManager().CancelLoadAsync(m_info.filename);
+  }
+  m_decodePending = false;
 
   if (m_diffuse.size())
     CServiceBroker::GetGUI()->GetTextureManager().ReleaseTexture(m_info.diffuse, immediately);
@@ -59,6 +59,7 @@ using DrawQuadFunc = std::function<void(const CRect& coords,
                                         const CRect* texCoords,
                                         const float depth,
                                         const bool blending)>;
+using FlushBatchFunc = std::function<void()>;
 
 class CGUITexture
 {
@@ -66,7 +67,8 @@ public:
   virtual ~CGUITexture() = default;
 
   static void Register(const CreateGUITextureFunc& createFunction,
-                       const DrawQuadFunc& drawQuadFunction);
+                       const DrawQuadFunc& drawQuadFunction,
+                       const FlushBatchFunc& flushBatchFunction = {});
 
   static CGUITexture* CreateTexture(
       float posX, float posY, float width, float height, const CTextureInfo& texture);
@@ -79,6 +81,14 @@ public:
                        const float depth = 1.0,
                        const bool blending = true);
 
+  /*!
+   * \brief Draw any quads the render backend still has queued.
+   *
+   * Needed before rendering that bypasses the backend's own state tracking,
+   * e.g. video or game frames drawn with their own shaders.
+   */
+  static void FlushBatch();
+
   bool Process(unsigned int currentTime);
   void Render(int32_t depthOffset = 0, int32_t overrideDepth = -1);
 
@@ -194,6 +204,7 @@ protected:
   bool m_allocateDynamically;
   enum ALLOCATE_TYPE { NO = 0, NORMAL, LARGE, NORMAL_FAILED, LARGE_FAILED };
   ALLOCATE_TYPE m_isAllocated;
+  bool m_decodePending{false}; // m_info.filename is being decoded in the background
 
   TEXTURE_SCALING m_scalingMethod{TEXTURE_SCALING::UNKNOWN};
   TEXTURE_SCALING m_diffuseScalingMethod{TEXTURE_SCALING::UNKNOWN};
@@ -207,4 +218,5 @@ protected:
 private:
   static CreateGUITextureFunc m_createGUITextureFunc;
   static DrawQuadFunc m_drawQuadFunc;
+  static FlushBatchFunc m_flushBatchFunc;
 };
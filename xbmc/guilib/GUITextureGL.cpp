@@ -8,6 +8,7 @@
 
 #include "GUITextureGL.h"
 
+#include "GUIControlProfiler.h"
 #include "ServiceBroker.h"
 #include "Texture.h"
 #include "rendering/gl/RenderSystemGL.h"
@@ -20,9 +21,24 @@
 
 #include "PlatformDefs.h"
 
+namespace
+{
+// Quads per batch. The indices are 16 bit, so this must stay below 16384.
+constexpr size_t BATCH_MAX_QUADS = 4096;
+} // namespace
+
+CGUITextureGL::BatchState CGUITextureGL::m_batchState;
+std::vector<CGUITextureGL::PackedVertex> CGUITextureGL::m_batchVertices;
+unsigned int CGUITextureGL::m_batchTextures = 0;
+bool CGUITextureGL::m_batchFlushing = false;
+GLuint CGUITextureGL::m_vertexBufferHandle = 0;
+GLuint CGUITextureGL::m_elementArrayHandle = 0;
+bool CGUITextureGL::m_staticBuffersCreated = false;
+
 void CGUITextureGL::Register()
 {
-  CGUITexture::Register(CGUITextureGL::CreateTexture, CGUITextureGL::DrawQuad);
+  CGUITexture::Register(CGUITextureGL::CreateTexture, CGUITextureGL::DrawQuad,
+                        CGUITextureGL::FlushBatch);
 }
 
 CGUITexture* CGUITextureGL::CreateTexture(
@@ -35,7 +51,6 @@ CGUITextureGL::CGUITextureGL(
     float posX, float posY, float width, float height, const CTextureInfo& texture)
   : CGUITexture(posX, posY, width, height, texture)
 {
-  m_renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
 }
 
 CGUITextureGL* CGUITextureGL::Clone() const
@@ -45,49 +60,75 @@ CGUITextureGL* CGUITextureGL::Clone() const
 
 void CGUITextureGL::Begin(KODI::UTILS::COLOR::Color color)
 {
-  CTexture* texture = m_texture.m_textures[m_currentFrame].get();
-  texture->LoadToGPU();
+  m_state.texture = m_texture.m_textures[m_currentFrame];
+  m_state.texture->LoadToGPU();
+  m_state.diffuse.reset();
   if (m_diffuse.size())
-    m_diffuse.m_textures[0]->LoadToGPU();
-
-  texture->BindToUnit(0);
+  {
+    m_state.diffuse = m_diffuse.m_textures[0];
+    m_state.diffuse->LoadToGPU();
+  }
 
   // Setup Colors
-  m_col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
-  m_col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
-  m_col[2] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color);
-  m_col[3] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::A, color);
+  m_state.col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
+  m_state.col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
+  m_state.col[2] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color);
+  m_state.col[3] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::A, color);
 
-  bool hasAlpha = m_texture.m_textures[m_currentFrame]->HasAlpha() || m_col[3] < 255;
+  m_state.blending = m_state.texture->HasAlpha() || m_state.col[3] < 255 ||
+                     (m_state.diffuse && m_state.diffuse->HasAlpha());
+  m_state.depth = m_depth;
 
-  if (m_diffuse.size())
-  {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255 )
-    {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_MULTI);
-    }
-    else
-    {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_MULTI_BLENDCOLOR);
-    }
+  m_packedVertices.clear();
+}
+
+void CGUITextureGL::End()
+{
+  if (m_packedVertices.empty())
+    return;
+
+  // Only the previous texture's quads can be merged, so paint order is kept
+  if (!m_batchVertices.empty() &&
+      (!(m_state == m_batchState) ||
+       m_batchVertices.size() + m_packedVertices.size() > BATCH_MAX_QUADS * 4))
+    FlushBatch();
 
-    hasAlpha |= m_diffuse.m_textures[0]->HasAlpha();
+  if (m_batchVertices.empty())
+    m_batchState = m_state;
+
+  m_batchVertices.insert(m_batchVertices.end(), m_packedVertices.begin(), m_packedVertices.end());
+  m_batchTextures++;
+}
 
-    m_diffuse.m_textures[0]->BindToUnit(1);
+void CGUITextureGL::FlushBatch()
+{
+  // Enabling the shader below calls back into here
+  if (m_batchVertices.empty() || m_batchFlushing)
+    return;
+
+  m_batchFlushing = true;
+
+  CRenderSystemGL* renderSystem =
+      dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
+  const BatchState& state = m_batchState;
+  const bool noBlendColor =
+      state.col[0] == 255 && state.col[1] == 255 && state.col[2] == 255 && state.col[3] == 255;
+
+  state.texture->BindToUnit(0);
+
+  if (state.diffuse)
+  {
+    renderSystem->EnableShader(noBlendColor ? ShaderMethodGL::SM_MULTI
+                                            : ShaderMethodGL::SM_MULTI_BLENDCOLOR);
+    state.diffuse->BindToUnit(1);
   }
   else
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255)
-    {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_TEXTURE_NOBLEND);
-    }
-    else
-    {
-      m_renderSystem->EnableShader(ShaderMethodGL::SM_TEXTURE);
-    }
+    renderSystem->EnableShader(noBlendColor ? ShaderMethodGL::SM_TEXTURE_NOBLEND
+                                            : ShaderMethodGL::SM_TEXTURE);
   }
 
-  if (hasAlpha)
+  if (state.blending)
   {
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
     glEnable(GL_BLEND);
@@ -96,72 +137,108 @@ void CGUITextureGL::Begin(KODI::UTILS::COLOR::Color color)
   {
     glDisable(GL_BLEND);
   }
-  m_packedVertices.clear();
-  m_idx.clear();
-}
 
-void CGUITextureGL::End()
-{
-  if (!m_packedVertices.empty())
+  CreateStaticBuffers();
+
+  GLint posLoc = renderSystem->ShaderGetPos();
+  GLint tex0Loc = renderSystem->ShaderGetCoord0();
+  GLint tex1Loc = renderSystem->ShaderGetCoord1();
+  GLint uniColLoc = renderSystem->ShaderGetUniCol();
+  GLint depthLoc = renderSystem->ShaderGetDepth();
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferHandle);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex) * m_batchVertices.size(),
+               m_batchVertices.data(), GL_STREAM_DRAW);
+
+  glUniform1f(depthLoc, state.depth);
+
+  if (uniColLoc >= 0)
   {
-    GLint posLoc  = m_renderSystem->ShaderGetPos();
-    GLint tex0Loc = m_renderSystem->ShaderGetCoord0();
-    GLint tex1Loc = m_renderSystem->ShaderGetCoord1();
-    GLint uniColLoc = m_renderSystem->ShaderGetUniCol();
-    GLint depthLoc = m_renderSystem->ShaderGetDepth();
+    glUniform4f(uniColLoc, (state.col[0] / 255.0f), (state.col[1] / 255.0f),
+                (state.col[2] / 255.0f), (state.col[3] / 255.0f));
+  }
 
-    GLuint VertexVBO;
-    GLuint IndexVBO;
+  if (state.diffuse)
+  {
+    glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
+                          reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u2)));
+    glEnableVertexAttribArray(tex1Loc);
+  }
 
-    glGenBuffers(1, &VertexVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VertexVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex) * m_packedVertices.size(),
-                 m_packedVertices.data(), GL_STATIC_DRAW);
+  glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex),
+                        reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, x)));
+  glEnableVertexAttribArray(posLoc);
+  glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
+                        reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u1)));
+  glEnableVertexAttribArray(tex0Loc);
 
-    glUniform1f(depthLoc, m_depth);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementArrayHandle);
+  glDrawElements(GL_TRIANGLES, m_batchVertices.size() * 6 / 4, GL_UNSIGNED_SHORT, 0);
+  GUIPROFILER_TEXTURE_DRAWCALLS(1, m_batchTextures);
 
-    if (uniColLoc >= 0)
-    {
-      glUniform4f(uniColLoc,(m_col[0] / 255.0f), (m_col[1] / 255.0f), (m_col[2] / 255.0f), (m_col[3] / 255.0f));
-    }
+  if (state.diffuse)
+    glDisableVertexAttribArray(tex1Loc);
 
-    if (m_diffuse.size())
-    {
-      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
-                            reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u2)));
-      glEnableVertexAttribArray(tex1Loc);
-    }
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(tex0Loc);
 
-    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex),
-                          reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, x)));
-    glEnableVertexAttribArray(posLoc);
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
-                          reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u1)));
-    glEnableVertexAttribArray(tex0Loc);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
-    glGenBuffers(1, &IndexVBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IndexVBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(ushort)*m_idx.size(), m_idx.data(), GL_STATIC_DRAW);
+  if (state.diffuse)
+    glActiveTexture(GL_TEXTURE0);
+  glEnable(GL_BLEND);
+
+  renderSystem->DisableShader();
 
-    glDrawElements(GL_TRIANGLES, m_packedVertices.size()*6 / 4, GL_UNSIGNED_SHORT, 0);
+  m_batchVertices.clear();
+  m_batchState = {};
+  m_batchTextures = 0;
+  m_batchFlushing = false;
+}
 
-    if (m_diffuse.size())
-      glDisableVertexAttribArray(tex1Loc);
+void CGUITextureGL::CreateStaticBuffers()
+{
+  if (m_staticBuffersCreated)
+    return;
 
-    glDisableVertexAttribArray(posLoc);
-    glDisableVertexAttribArray(tex0Loc);
+  glGenBuffers(1, &m_vertexBufferHandle);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glDeleteBuffers(1, &VertexVBO);
-    glDeleteBuffers(1, &IndexVBO);
+  // Every batch draws its quads as two triangles each, so the indices never change
+  std::vector<GLushort> index(BATCH_MAX_QUADS * 6);
+  for (size_t i = 0; i < BATCH_MAX_QUADS; i++)
+  {
+    index[i * 6 + 0] = 4 * i;
+    index[i * 6 + 1] = 4 * i + 1;
+    index[i * 6 + 2] = 4 * i + 2;
+    index[i * 6 + 3] = 4 * i + 2;
+    index[i * 6 + 4] = 4 * i + 3;
+    index[i * 6 + 5] = 4 * i;
   }
 
-  if (m_diffuse.size())
-    glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_BLEND);
+  glGenBuffers(1, &m_elementArrayHandle);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementArrayHandle);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * index.size(), index.data(),
+               GL_STATIC_DRAW);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  m_staticBuffersCreated = true;
+}
 
-  m_renderSystem->DisableShader();
+void CGUITextureGL::DestroyStaticBuffers()
+{
+  // Anything still queued belongs to a context that is going away
+  m_batchVertices.clear();
+  m_batchState = {};
+  m_batchTextures = 0;
+
+  if (!m_staticBuffersCreated)
+    return;
+
+  glDeleteBuffers(1, &m_vertexBufferHandle);
+  glDeleteBuffers(1, &m_elementArrayHandle);
+  m_vertexBufferHandle = 0;
+  m_elementArrayHandle = 0;
+  m_staticBuffersCreated = false;
 }
 
 void CGUITextureGL::Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation)
@@ -243,17 +320,6 @@ void CGUITextureGL::Draw(float *x, float *y, float *z, const CRect &texture, con
     vertices[i].z = z[i];
     m_packedVertices.push_back(vertices[i]);
   }
-
-  if ((m_packedVertices.size() / 4) > (m_idx.size() / 6))
-  {
-    size_t i = m_packedVertices.size() - 4;
-    m_idx.push_back(i+0);
-    m_idx.push_back(i+1);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+3);
-    m_idx.push_back(i+0);
-  }
 }
 
 void CGUITextureGL::DrawQuad(const CRect& rect,
@@ -263,6 +329,9 @@ void CGUITextureGL::DrawQuad(const CRect& rect,
                              const float depth,
                              const bool blending)
 {
+  // The state below would otherwise be overwritten by drawing queued quads
+  FlushBatch();
+
   CRenderSystemGL *renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
   if (texture)
   {
@@ -12,11 +12,11 @@
 #include "utils/ColorUtils.h"
 
 #include <array>
+#include <memory>
+#include <vector>
 
 #include "system_gl.h"
 
-class CRenderSystemGL;
-
 class CGUITextureGL : public CGUITexture
 {
 public:
@@ -31,6 +31,14 @@ public:
                        const float depth = 1.0,
                        const bool blending = true);
 
+  /*!
+   * \brief Draw the quads queued by consecutive textures that share the same state.
+   *
+   * Called by the render system before any GL state the queued quads depend on changes.
+   */
+  static void FlushBatch();
+  static void DestroyStaticBuffers();
+
   CGUITextureGL(float posX, float posY, float width, float height, const CTextureInfo& texture);
   ~CGUITextureGL() override = default;
 
@@ -44,8 +52,6 @@ protected:
 private:
   CGUITextureGL(const CGUITextureGL& texture) = default;
 
-  std::array<GLubyte, 4> m_col;
-
   struct PackedVertex
   {
     float x, y, z;
@@ -53,8 +59,30 @@ private:
     float u2, v2;
   };
 
+  // Everything a queued quad needs besides its vertices. Quads of consecutive
+  // textures with equal state are drawn with a single call.
+  struct BatchState
+  {
+    std::shared_ptr<CTexture> texture;
+    std::shared_ptr<CTexture> diffuse;
+    std::array<GLubyte, 4> col;
+    bool blending;
+    float depth;
+
+    bool operator==(const BatchState& rhs) const = default;
+  };
+
+  static void CreateStaticBuffers();
+
+  BatchState m_state;
   std::vector<PackedVertex> m_packedVertices;
-  std::vector<GLushort> m_idx;
-  CRenderSystemGL *m_renderSystem;
+
+  static BatchState m_batchState;
+  static std::vector<PackedVertex> m_batchVertices;
+  static unsigned int m_batchTextures;
+  static bool m_batchFlushing;
+  static GLuint m_vertexBufferHandle;
+  static GLuint m_elementArrayHandle;
+  static bool m_staticBuffersCreated;
 };
 
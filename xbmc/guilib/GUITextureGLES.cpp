@@ -8,6 +8,7 @@
 
 #include "GUITextureGLES.h"
 
+#include "GUIControlProfiler.h"
 #include "ServiceBroker.h"
 #include "Texture.h"
 #include "guilib/TextureFormats.h"
@@ -20,9 +21,24 @@
 
 #include <cstddef>
 
+namespace
+{
+// Quads per batch. The indices are 16 bit, so this must stay below 16384.
+constexpr size_t BATCH_MAX_QUADS = 4096;
+} // namespace
+
+CGUITextureGLES::BatchState CGUITextureGLES::m_batchState;
+PackedVertices CGUITextureGLES::m_batchVertices;
+unsigned int CGUITextureGLES::m_batchTextures = 0;
+bool CGUITextureGLES::m_batchFlushing = false;
+GLuint CGUITextureGLES::m_vertexBufferHandle = 0;
+GLuint CGUITextureGLES::m_elementArrayHandle = 0;
+bool CGUITextureGLES::m_staticBuffersCreated = false;
+
 void CGUITextureGLES::Register()
 {
-  CGUITexture::Register(CGUITextureGLES::CreateTexture, CGUITextureGLES::DrawQuad);
+  CGUITexture::Register(CGUITextureGLES::CreateTexture, CGUITextureGLES::DrawQuad,
+                        CGUITextureGLES::FlushBatch);
 }
 
 CGUITexture* CGUITextureGLES::CreateTexture(
@@ -35,10 +51,6 @@ CGUITextureGLES::CGUITextureGLES(
     float posX, float posY, float width, float height, const CTextureInfo& texture)
   : CGUITexture(posX, posY, width, height, texture)
 {
-  m_renderSystem = dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
-  unsigned int major, minor;
-  m_renderSystem->GetRenderVersion(major, minor);
-  m_isGLES20 = major == 2;
 }
 
 CGUITextureGLES* CGUITextureGLES::Clone() const
@@ -48,141 +60,237 @@ CGUITextureGLES* CGUITextureGLES::Clone() const
 
 void CGUITextureGLES::Begin(KODI::UTILS::COLOR::Color color)
 {
-  CTexture* texture = m_texture.m_textures[m_currentFrame].get();
-  texture->LoadToGPU();
+  m_state.texture = m_texture.m_textures[m_currentFrame];
+  m_state.texture->LoadToGPU();
+  m_state.diffuse.reset();
   if (m_diffuse.size())
-    m_diffuse.m_textures[0]->LoadToGPU();
+  {
+    m_state.diffuse = m_diffuse.m_textures[0];
+    m_state.diffuse->LoadToGPU();
+  }
 
   // Setup Colors
-  m_col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
-  m_col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
-  m_col[2] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color);
-  m_col[3] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::A, color);
+  m_state.col[0] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::R, color);
+  m_state.col[1] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::G, color);
+  m_state.col[2] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::B, color);
+  m_state.col[3] = KODI::UTILS::GL::GetChannelFromARGB(KODI::UTILS::GL::ColorChannel::A, color);
 
   if (CServiceBroker::GetWinSystem()->UseLimitedColor())
   {
-    m_col[0] = (235 - 16) * m_col[0] / 255 + 16;
-    m_col[1] = (235 - 16) * m_col[1] / 255 + 16;
-    m_col[2] = (235 - 16) * m_col[2] / 255 + 16;
+    m_state.col[0] = (235 - 16) * m_state.col[0] / 255 + 16;
+    m_state.col[1] = (235 - 16) * m_state.col[1] / 255 + 16;
+    m_state.col[2] = (235 - 16) * m_state.col[2] / 255 + 16;
   }
 
-  bool hasAlpha = m_texture.m_textures[m_currentFrame]->HasAlpha() || m_col[3] < 255;
+  m_state.blending = m_state.texture->HasAlpha() || m_state.col[3] < 255 ||
+                     (m_state.diffuse && m_state.diffuse->HasAlpha());
+  m_state.depth = m_depth;
+
+  m_packedVertices.clear();
+}
+
+void CGUITextureGLES::End()
+{
+  if (m_packedVertices.empty())
+    return;
+
+  // Only the previous texture's quads can be merged, so paint order is kept
+  if (!m_batchVertices.empty() &&
+      (!(m_state == m_batchState) ||
+       m_batchVertices.size() + m_packedVertices.size() > BATCH_MAX_QUADS * 4))
+    FlushBatch();
+
+  if (m_batchVertices.empty())
+    m_batchState = m_state;
+
+  m_batchVertices.insert(m_batchVertices.end(), m_packedVertices.begin(), m_packedVertices.end());
+  m_batchTextures++;
+}
+
+void CGUITextureGLES::FlushBatch()
+{
+  // Enabling the shader below calls back into here
+  if (m_batchVertices.empty() || m_batchFlushing)
+    return;
+
+  m_batchFlushing = true;
+
+  CRenderSystemGLES* renderSystem =
+      dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+  unsigned int major, minor;
+  renderSystem->GetRenderVersion(major, minor);
+  const bool isGLES20 = major == 2;
+
+  const BatchState& state = m_batchState;
+  CTexture* texture = state.texture.get();
+  CTexture* diffuse = state.diffuse.get();
   const bool hasBlendColor =
-      m_col[0] != 255 || m_col[1] != 255 || m_col[2] != 255 || m_col[3] != 255;
+      state.col[0] != 255 || state.col[1] != 255 || state.col[2] != 255 || state.col[3] != 255;
 
-  if (m_diffuse.size())
+  if (diffuse)
   {
-    if (m_isGLES20 && (texture->GetSwizzle() == KD_TEX_SWIZ_111R ||
-                       m_diffuse.m_textures[0]->GetSwizzle() == KD_TEX_SWIZ_111R))
+    if (isGLES20 && (texture->GetSwizzle() == KD_TEX_SWIZ_111R ||
+                     diffuse->GetSwizzle() == KD_TEX_SWIZ_111R))
     {
-      if (texture->GetSwizzle() == KD_TEX_SWIZ_111R &&
-          m_diffuse.m_textures[0]->GetSwizzle() == KD_TEX_SWIZ_111R)
-        m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_111R_111R_BLENDCOLOR);
+      if (texture->GetSwizzle() == KD_TEX_SWIZ_111R && diffuse->GetSwizzle() == KD_TEX_SWIZ_111R)
+        renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_111R_111R_BLENDCOLOR);
       else if (hasBlendColor)
-        m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_RGBA_111R_BLENDCOLOR);
+        renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_RGBA_111R_BLENDCOLOR);
       else
-        m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_RGBA_111R);
+        renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_RGBA_111R);
     }
     else if (hasBlendColor)
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_BLENDCOLOR);
+      renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI_BLENDCOLOR);
     }
     else
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI);
+      renderSystem->EnableGUIShader(ShaderMethodGLES::SM_MULTI);
     }
 
-    hasAlpha |= m_diffuse.m_textures[0]->HasAlpha();
-
     // We don't need a 111R_RGBA version of the GLES 2.0 shaders, so in the
     // unlikely event of having an alpha-only texture, switch with the
     // diffuse.
     if (texture->GetSwizzle() == KD_TEX_SWIZ_111R)
     {
       texture->BindToUnit(1);
-      m_diffuse.m_textures[0]->BindToUnit(0);
+      diffuse->BindToUnit(0);
     }
     else
     {
       texture->BindToUnit(0);
-      m_diffuse.m_textures[0]->BindToUnit(1);
+      diffuse->BindToUnit(1);
     }
   }
   else
   {
-    if (m_isGLES20 && texture->GetSwizzle() == KD_TEX_SWIZ_111R)
+    if (isGLES20 && texture->GetSwizzle() == KD_TEX_SWIZ_111R)
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE_111R);
+      renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE_111R);
     }
     else if (hasBlendColor)
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE);
+      renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE);
     }
     else
     {
-      m_renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE_NOBLEND);
+      renderSystem->EnableGUIShader(ShaderMethodGLES::SM_TEXTURE_NOBLEND);
     }
 
     texture->BindToUnit(0);
   }
 
-  if ( hasAlpha )
+  if (state.blending)
   {
     glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
-    glEnable( GL_BLEND );
+    glEnable(GL_BLEND);
   }
   else
   {
     glDisable(GL_BLEND);
   }
-  m_packedVertices.clear();
-}
 
-void CGUITextureGLES::End()
-{
-  if (!m_packedVertices.empty())
+  CreateStaticBuffers();
+
+  GLint posLoc = renderSystem->GUIShaderGetPos();
+  GLint tex0Loc = renderSystem->GUIShaderGetCoord0();
+  GLint tex1Loc = renderSystem->GUIShaderGetCoord1();
+  GLint uniColLoc = renderSystem->GUIShaderGetUniCol();
+  GLint depthLoc = renderSystem->GUIShaderGetDepth();
+
+  if (uniColLoc >= 0)
   {
-    GLint posLoc  = m_renderSystem->GUIShaderGetPos();
-    GLint tex0Loc = m_renderSystem->GUIShaderGetCoord0();
-    GLint tex1Loc = m_renderSystem->GUIShaderGetCoord1();
-    GLint uniColLoc = m_renderSystem->GUIShaderGetUniCol();
-    GLint depthLoc = m_renderSystem->GUIShaderGetDepth();
+    glUniform4f(uniColLoc, (state.col[0] / 255.0f), (state.col[1] / 255.0f),
+                (state.col[2] / 255.0f), (state.col[3] / 255.0f));
+  }
 
-    if(uniColLoc >= 0)
-    {
-      glUniform4f(uniColLoc,(m_col[0] / 255.0f), (m_col[1] / 255.0f), (m_col[2] / 255.0f), (m_col[3] / 255.0f));
-    }
+  glUniform1f(depthLoc, state.depth);
 
-    glUniform1f(depthLoc, m_depth);
+  glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferHandle);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex) * m_batchVertices.size(),
+               m_batchVertices.data(), GL_STREAM_DRAW);
 
-    if(m_diffuse.size())
-    {
-      if (m_texture.m_textures[m_currentFrame]->GetSwizzle() == KD_TEX_SWIZ_111R)
-        std::swap(tex0Loc, tex1Loc);
-      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
-                            (char*)m_packedVertices.data() + offsetof(PackedVertex, u2));
-      glEnableVertexAttribArray(tex1Loc);
-    }
-    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex),
-                          (char*)m_packedVertices.data() + offsetof(PackedVertex, x));
-    glEnableVertexAttribArray(posLoc);
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
-                          (char*)m_packedVertices.data() + offsetof(PackedVertex, u1));
-    glEnableVertexAttribArray(tex0Loc);
+  if (diffuse)
+  {
+    if (texture->GetSwizzle() == KD_TEX_SWIZ_111R)
+      std::swap(tex0Loc, tex1Loc);
+    glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
+                          reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u2)));
+    glEnableVertexAttribArray(tex1Loc);
+  }
+  glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex),
+                        reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, x)));
+  glEnableVertexAttribArray(posLoc);
+  glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex),
+                        reinterpret_cast<const GLvoid*>(offsetof(PackedVertex, u1)));
+  glEnableVertexAttribArray(tex0Loc);
 
-    glDrawElements(GL_TRIANGLES, m_packedVertices.size()*6 / 4, GL_UNSIGNED_SHORT, m_idx.data());
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementArrayHandle);
+  glDrawElements(GL_TRIANGLES, m_batchVertices.size() * 6 / 4, GL_UNSIGNED_SHORT, 0);
+  GUIPROFILER_TEXTURE_DRAWCALLS(1, m_batchTextures);
 
-    if (m_diffuse.size())
-      glDisableVertexAttribArray(tex1Loc);
+  if (diffuse)
+    glDisableVertexAttribArray(tex1Loc);
 
-    glDisableVertexAttribArray(posLoc);
-    glDisableVertexAttribArray(tex0Loc);
-  }
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(tex0Loc);
 
-  if (m_diffuse.size())
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  if (diffuse)
     glActiveTexture(GL_TEXTURE0);
   glEnable(GL_BLEND);
-  m_renderSystem->DisableGUIShader();
+  renderSystem->DisableGUIShader();
+
+  m_batchVertices.clear();
+  m_batchState = {};
+  m_batchTextures = 0;
+  m_batchFlushing = false;
+}
+
+void CGUITextureGLES::CreateStaticBuffers()
+{
+  if (m_staticBuffersCreated)
+    return;
+
+  glGenBuffers(1, &m_vertexBufferHandle);
+
+  // Every batch draws its quads as two triangles each, so the indices never change
+  std::vector<GLushort> index(BATCH_MAX_QUADS * 6);
+  for (size_t i = 0; i < BATCH_MAX_QUADS; i++)
+  {
+    index[i * 6 + 0] = 4 * i;
+    index[i * 6 + 1] = 4 * i + 1;
+    index[i * 6 + 2] = 4 * i + 2;
+    index[i * 6 + 3] = 4 * i + 2;
+    index[i * 6 + 4] = 4 * i + 3;
+    index[i * 6 + 5] = 4 * i;
+  }
+
+  glGenBuffers(1, &m_elementArrayHandle);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementArrayHandle);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * index.size(), index.data(),
+               GL_STATIC_DRAW);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  m_staticBuffersCreated = true;
+}
+
+void CGUITextureGLES::DestroyStaticBuffers()
+{
+  // Anything still queued belongs to a context that is going away
+  m_batchVertices.clear();
+  m_batchState = {};
+  m_batchTextures = 0;
+
+  if (!m_staticBuffersCreated)
+    return;
+
+  glDeleteBuffers(1, &m_vertexBufferHandle);
+  glDeleteBuffers(1, &m_elementArrayHandle);
+  m_vertexBufferHandle = 0;
+  m_elementArrayHandle = 0;
+  m_staticBuffersCreated = false;
 }
 
 void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation)
@@ -258,17 +366,6 @@ void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, c
     vertices[i].z = z[i];
     m_packedVertices.push_back(vertices[i]);
   }
-
-  if ((m_packedVertices.size() / 4) > (m_idx.size() / 6))
-  {
-    size_t i = m_packedVertices.size() - 4;
-    m_idx.push_back(i+0);
-    m_idx.push_back(i+1);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+3);
-    m_idx.push_back(i+0);
-  }
 }
 
 void CGUITextureGLES::DrawQuad(const CRect& rect,
@@ -278,6 +375,9 @@ void CGUITextureGLES::DrawQuad(const CRect& rect,
                                const float depth,
                                const bool blending)
 {
+  // The state below would otherwise be overwritten by drawing queued quads
+  FlushBatch();
+
   CRenderSystemGLES *renderSystem = dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
   if (texture)
   {
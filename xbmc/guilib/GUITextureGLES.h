@@ -12,6 +12,7 @@
 #include "utils/ColorUtils.h"
 
 #include <array>
+#include <memory>
 #include <vector>
 
 #include "system_gl.h"
@@ -24,8 +25,6 @@ struct PackedVertex
 };
 typedef std::vector<PackedVertex> PackedVertices;
 
-class CRenderSystemGLES;
-
 class CGUITextureGLES : public CGUITexture
 {
 public:
@@ -40,6 +39,14 @@ public:
                        const float depth = 1.0,
                        const bool blending = true);
 
+  /*!
+   * \brief Draw the quads queued by consecutive textures that share the same state.
+   *
+   * Called by the render system before any GL state the queued quads depend on changes.
+   */
+  static void FlushBatch();
+  static void DestroyStaticBuffers();
+
   CGUITextureGLES(float posX, float posY, float width, float height, const CTextureInfo& texture);
   ~CGUITextureGLES() override = default;
 
@@ -53,11 +60,30 @@ protected:
 private:
   CGUITextureGLES(const CGUITextureGLES& texture) = default;
 
-  std::array<GLubyte, 4> m_col;
+  // Everything a queued quad needs besides its vertices. Quads of consecutive
+  // textures with equal state are drawn with a single call.
+  struct BatchState
+  {
+    std::shared_ptr<CTexture> texture;
+    std::shared_ptr<CTexture> diffuse;
+    std::array<GLubyte, 4> col;
+    bool blending;
+    float depth;
+
+    bool operator==(const BatchState& rhs) const = default;
+  };
 
+  static void CreateStaticBuffers();
+
+  BatchState m_state;
   PackedVertices m_packedVertices;
-  std::vector<GLushort> m_idx;
-  CRenderSystemGLES *m_renderSystem;
-  bool m_isGLES20{true};
+
+  static BatchState m_batchState;
+  static PackedVertices m_batchVertices;
+  static unsigned int m_batchTextures;
+  static bool m_batchFlushing;
+  static GLuint m_vertexBufferHandle;
+  static GLuint m_elementArrayHandle;
+  static bool m_staticBuffersCreated;
 };
 
@@ -57,6 +57,9 @@ void CGUIVideoControl::Render()
       appPower->ResetScreenSaver();
     }
 
+    // the video renderer doesn't know about quads the GUI still has queued
+    CGUITexture::FlushBatch();
+
     CServiceBroker::GetWinSystem()->GetGfxContext().SetViewWindow(m_posX, m_posY, m_posX + m_width, m_posY + m_height);
     TransformMatrix mat;
     CServiceBroker::GetWinSystem()->GetGfxContext().SetTransform(mat, 1.0, 1.0);
@@ -14,6 +14,7 @@
 #include "GUIControlGroup.h"
 #include "GUIControlProfiler.h"
 #include "GUIInfoManager.h"
+#include "GUIWindowCache.h"
 #include "GUIWindowManager.h"
 #include "ServiceBroker.h"
 #include "addons/Skin.h"
@@ -125,6 +126,14 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
 
 bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLowerPath)
 {
+  // a cached definition has its includes resolved already
+  std::unique_ptr<TiXmlElement> cachedRoot = CGUIWindowCache::Load(strPath, m_xmlIncludeConditions);
+  if (cachedRoot)
+  {
+    CLog::Log(LOGDEBUG, "Using skin cache for {}", strPath);
+    return Load(cachedRoot.get());
+  }
+
   // load window xml if we don't have it stored yet
   if (!m_windowXMLRootElement)
   {
@@ -153,7 +162,11 @@ bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLower
   else
     CLog::Log(LOGDEBUG, "Using already stored xml root node for {}", strPath);
 
-  return Load(Prepare(m_windowXMLRootElement).get());
+  std::unique_ptr<TiXmlElement> preparedRoot = Prepare(m_windowXMLRootElement);
+  if (preparedRoot)
+    CGUIWindowCache::Save(strPath, *preparedRoot, m_xmlIncludeConditions);
+
+  return Load(preparedRoot.get());
 }
 
 std::unique_ptr<TiXmlElement> CGUIWindow::Prepare(const std::unique_ptr<TiXmlElement>& rootElement)
@@ -0,0 +1,333 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIWindowCache.h"
+
+#include "GUIInfoManager.h"
+#include "ServiceBroker.h"
+#include "addons/AddonVersion.h"
+#include "addons/Skin.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "guilib/GUIComponent.h"
+#include "utils/Archive.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/log.h"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace XFILE;
+
+namespace
+{
+constexpr const char* CACHE_PATH = "special://temp/skin_cache/";
+
+// bump whenever the layout written by CGUIWindowCache::Save() changes
+constexpr int CACHE_VERSION = 1;
+// written last, so a truncated file is not mistaken for a complete one
+constexpr int CACHE_END = 0x4b574331;
+
+// limits for sanity checking the element tree read back from disk
+constexpr unsigned int MAX_DEPTH = 256;
+constexpr unsigned int MAX_NODES = 1000000;
+
+enum class NodeType : char
+{
+  ELEMENT = 'E',
+  TEXT = 'T',
+};
+
+struct Dependency
+{
+  std::string path;
+  long long mtime;
+  long long size;
+};
+
+bool GetDependency(const std::string& path, Dependency& dependency)
+{
+  struct __stat64 buffer;
+  if (CFile::Stat(path, &buffer) != 0)
+    return false;
+
+  dependency.path = path;
+  dependency.mtime = static_cast<long long>(buffer.st_mtime);
+  dependency.size = static_cast<long long>(buffer.st_size);
+  return true;
+}
+} // namespace
+
+std::unique_ptr<TiXmlElement> CGUIWindowCache::Load(const std::string& windowFile,
+                                                    std::map<INFO::InfoPtr, bool>& includeConditions)
+{
+  if (!g_SkinInfo)
+    return nullptr;
+
+  const std::string cacheFile = GetCacheFile(windowFile);
+  CFile file;
+  if (!file.Open(cacheFile))
+    return nullptr;
+
+  try
+  {
+    CArchive ar(&file, CArchive::load);
+
+    int version;
+    ar >> version;
+    if (version != CACHE_VERSION)
+      return nullptr;
+
+    std::string skinId;
+    std::string skinVersion;
+    std::string cachedWindowFile;
+    ar >> skinId;
+    ar >> skinVersion;
+    ar >> cachedWindowFile;
+    if (skinId != g_SkinInfo->ID() || skinVersion != g_SkinInfo->Version().asString() ||
+        cachedWindowFile != windowFile)
+      return nullptr;
+
+    unsigned int count;
+    ar >> count;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      Dependency cached;
+      ar >> cached.path;
+      ar >> cached.mtime;
+      ar >> cached.size;
+
+      Dependency current;
+      if (!GetDependency(cached.path, current) || current.mtime != cached.mtime ||
+          current.size != cached.size)
+      {
+        CLog::Log(LOGDEBUG, "Skin cache for {} is out of date: {} changed", windowFile,
+                  cached.path);
+        return nullptr;
+      }
+    }
+
+    // the cached tree is only valid if the includes would be resolved the same way now
+    std::map<INFO::InfoPtr, bool> conditions;
+    ar >> count;
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      std::string expression;
+      bool value;
+      ar >> expression;
+      ar >> value;
+
+      INFO::InfoPtr condition =
+          CServiceBroker::GetGUI()->GetInfoManager().Register(expression);
+      if (!condition || condition->Get(INFO::DEFAULT_CONTEXT) != value)
+        return nullptr;
+
+      conditions.emplace(condition, value);
+    }
+
+    auto root = std::make_unique<TiXmlElement>("window");
+    if (!ReadElement(ar, *root, 0))
+    {
+      CLog::Log(LOGERROR, "Corrupt skin cache file: {}", cacheFile);
+      return nullptr;
+    }
+
+    int end;
+    ar >> end;
+    if (end != CACHE_END)
+    {
+      CLog::Log(LOGERROR, "Corrupt skin cache file: {}", cacheFile);
+      return nullptr;
+    }
+
+    includeConditions = std::move(conditions);
+    return root;
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::Log(LOGERROR, "Corrupt skin cache file: {}", cacheFile);
+  }
+
+  return nullptr;
+}
+
+void CGUIWindowCache::Save(const std::string& windowFile,
+                           const TiXmlElement& root,
+                           const std::map<INFO::InfoPtr, bool>& includeConditions)
+{
+  if (!g_SkinInfo)
+    return;
+
+  // every include file loaded so far, which may be more than this window uses
+  std::vector<Dependency> dependencies;
+  Dependency dependency;
+  if (!GetDependency(windowFile, dependency))
+    return;
+  dependencies.emplace_back(std::move(dependency));
+
+  for (const auto& includeFile : g_SkinInfo->GetIncludeFiles())
+  {
+    if (!GetDependency(includeFile, dependency))
+      return;
+    dependencies.emplace_back(std::move(dependency));
+  }
+
+  if (!CDirectory::Exists(CACHE_PATH) && !CDirectory::Create(CACHE_PATH))
+    return;
+
+  const std::string cacheFile = GetCacheFile(windowFile);
+  CFile file;
+  if (!file.OpenForWrite(cacheFile, true))
+  {
+    CLog::Log(LOGWARNING, "Unable to write skin cache file {}", cacheFile);
+    return;
+  }
+
+  try
+  {
+    CArchive ar(&file, CArchive::store);
+    ar << CACHE_VERSION;
+    ar << g_SkinInfo->ID();
+    ar << g_SkinInfo->Version().asString();
+    ar << windowFile;
+
+    ar << static_cast<unsigned int>(dependencies.size());
+    for (const auto& dep : dependencies)
+    {
+      ar << dep.path;
+      ar << dep.mtime;
+      ar << dep.size;
+    }
+
+    ar << static_cast<unsigned int>(includeConditions.size());
+    for (const auto& [condition, value] : includeConditions)
+    {
+      ar << condition->GetExpression();
+      ar << value;
+    }
+
+    WriteElement(ar, root);
+    ar << CACHE_END;
+    ar.Close();
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::Log(LOGERROR, "Unable to write skin cache file {}", cacheFile);
+    file.Close();
+    CFile::Delete(cacheFile);
+  }
+}
+
+std::string CGUIWindowCache::GetCacheFile(const std::string& windowFile)
+{
+  const uint32_t crc = Crc32::ComputeFromLowerCase(g_SkinInfo->ID() + "|" + windowFile);
+  return StringUtils::Format("{}{:08x}.skc", CACHE_PATH, crc);
+}
+
+void CGUIWindowCache::WriteElement(CArchive& ar, const TiXmlElement& element)
+{
+  ar << element.ValueStr();
+
+  unsigned int attributes = 0;
+  for (const TiXmlAttribute* attribute = element.FirstAttribute(); attribute;
+       attribute = attribute->Next())
+    attributes++;
+
+  ar << attributes;
+  for (const TiXmlAttribute* attribute = element.FirstAttribute(); attribute;
+       attribute = attribute->Next())
+  {
+    ar << attribute->NameTStr();
+    ar << attribute->ValueStr();
+  }
+
+  // comments and the like are of no use to the control factory
+  unsigned int children = 0;
+  for (const TiXmlNode* child = element.FirstChild(); child; child = child->NextSibling())
+  {
+    if (child->ToElement() || child->ToText())
+      children++;
+  }
+
+  ar << children;
+  for (const TiXmlNode* child = element.FirstChild(); child; child = child->NextSibling())
+  {
+    if (const TiXmlElement* childElement = child->ToElement())
+    {
+      ar << static_cast<char>(NodeType::ELEMENT);
+      WriteElement(ar, *childElement);
+    }
+    else if (const TiXmlText* text = child->ToText())
+    {
+      ar << static_cast<char>(NodeType::TEXT);
+      ar << text->ValueStr();
+      ar << text->CDATA();
+    }
+  }
+}
+
+bool CGUIWindowCache::ReadElement(CArchive& ar, TiXmlElement& element, unsigned int depth)
+{
+  if (depth > MAX_DEPTH)
+    return false;
+
+  std::string value;
+  ar >> value;
+  if (value.empty())
+    return false;
+  element.SetValue(value);
+
+  unsigned int attributes;
+  ar >> attributes;
+  if (attributes > MAX_NODES)
+    return false;
+
+  for (unsigned int i = 0; i < attributes; ++i)
+  {
+    std::string name;
+    std::string attributeValue;
+    ar >> name;
+    ar >> attributeValue;
+    element.SetAttribute(name, attributeValue);
+  }
+
+  unsigned int children;
+  ar >> children;
+  if (children > MAX_NODES)
+    return false;
+
+  for (unsigned int i = 0; i < children; ++i)
+  {
+    char type;
+    ar >> type;
+    if (type == static_cast<char>(NodeType::ELEMENT))
+    {
+      // link first so the subtree is built in place instead of being copied
+      auto* child = new TiXmlElement("");
+      element.LinkEndChild(child);
+      if (!ReadElement(ar, *child, depth + 1))
+        return false;
+    }
+    else if (type == static_cast<char>(NodeType::TEXT))
+    {
+      std::string text;
+      bool cdata;
+      ar >> text;
+      ar >> cdata;
+      auto* child = new TiXmlText(text);
+      child->SetCDATA(cdata);
+      element.LinkEndChild(child);
+    }
+    else
+      return false;
+  }
+
+  return true;
+}
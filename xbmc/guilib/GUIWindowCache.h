@@ -0,0 +1,62 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+/*!
+\file GUIWindowCache.h
+\brief
+*/
+
+#include "interfaces/info/InfoBool.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+class CArchive;
+class TiXmlElement;
+
+/*!
+ \ingroup winman
+ \brief On-disk cache of window definitions with their skin includes resolved.
+
+ Resolving includes, constants and expressions is most of the time spent loading a window.
+ The cache stores the resolved <window> element in a binary form along with what the result
+ depends on: the skin and its version, the modification times of the window and include files,
+ and the values the include conditions had. An entry is only used while all of these match.
+ */
+class CGUIWindowCache
+{
+public:
+  /*!
+   \brief Load the resolved definition of a window from the cache.
+
+   \param windowFile path of the window's skin file
+   \param includeConditions [out] the conditions of the includes that were resolved
+   \return the resolved <window> element, or nullptr if there is no up to date entry
+   */
+  static std::unique_ptr<TiXmlElement> Load(const std::string& windowFile,
+                                            std::map<INFO::InfoPtr, bool>& includeConditions);
+
+  /*!
+   \brief Store the resolved definition of a window in the cache.
+
+   \param windowFile path of the window's skin file
+   \param root the <window> element after resolving includes
+   \param includeConditions the conditions of the includes that were resolved
+   */
+  static void Save(const std::string& windowFile,
+                   const TiXmlElement& root,
+                   const std::map<INFO::InfoPtr, bool>& includeConditions);
+
+private:
+  static std::string GetCacheFile(const std::string& windowFile);
+  static void WriteElement(CArchive& ar, const TiXmlElement& element);
+  static bool ReadElement(CArchive& ar, TiXmlElement& element, unsigned int depth);
+};
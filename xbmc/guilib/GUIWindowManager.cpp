@@ -1399,6 +1399,9 @@ bool CGUIWindowManager::Render()
     CServiceBroker::GetWinSystem()->GetGfxContext().ResetScissors();
   }
 
+  // RenderEx() and the video overlays draw next, with their own state
+  CGUITexture::FlushBatch();
+
   if (visualizeDirtyRegions)
   {
     CServiceBroker::GetWinSystem()->GetGfxContext().SetRenderingResolution(CServiceBroker::GetWinSystem()->GetGfxContext().GetResInfo(), false);
@@ -1710,6 +1713,19 @@ int CGUIWindowManager::GetActiveWindowOrDialog() const
   return GetActiveWindow() & WINDOW_ID_MASK;
 }
 
+void CGUIWindowManager::GetActiveWindowsState(std::vector<int>& state) const
+{
+  std::unique_lock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+  state.clear();
+  state.push_back(GetActiveWindow());
+  for (const auto& window : m_activeDialogs)
+  {
+    state.push_back(window->GetID());
+    state.push_back((window->IsAnimating(ANIM_TYPE_WINDOW_CLOSE) ? 1 : 0) |
+                    (window->IsModalDialog() ? 2 : 0));
+  }
+}
+
 bool CGUIWindowManager::IsWindowActive(int id, bool ignoreClosing /* = true */) const
 {
   // mask out multiple instances of the same window
@@ -211,6 +211,11 @@ public:
   bool IsWindowVisible(int id) const;
   bool IsWindowActive(const std::string &xmlFile, bool ignoreClosing = true) const;
   bool IsWindowVisible(const std::string &xmlFile) const;
+  /*! \brief Get the state of the active window and dialogs, to find out whether it changed.
+   \param state receives the id of the active window, followed by the id and flags (1 closing,
+   2 modal) of each active dialog
+   */
+  void GetActiveWindowsState(std::vector<int>& state) const;
   /*! \brief Checks if the given window is an addon window.
    *
    * \return true if the given window is an addon window, otherwise false.
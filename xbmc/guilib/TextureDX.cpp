@@ -8,6 +8,7 @@
 
 #include "TextureDX.h"
 
+#include "GUIControlProfiler.h"
 #include "utils/MemUtils.h"
 #include "utils/log.h"
 
@@ -75,6 +76,7 @@ void CDXTexture::LoadToGPU()
     // nothing to load - probably same image (no change)
     return;
   }
+  GUIPROFILER_TEXTURE_UPLOADS(1);
 
   bool needUpdate = true;
   D3D11_USAGE usage = D3D11_USAGE_DEFAULT;
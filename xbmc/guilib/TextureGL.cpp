@@ -9,6 +9,7 @@
 #include "TextureGL.h"
 
 #include "ServiceBroker.h"
+#include "guilib/GUIControlProfiler.h"
 #include "guilib/TextureFormats.h"
 #include "guilib/TextureManager.h"
 #include "rendering/GLExtensions.h"
@@ -175,6 +176,8 @@ void CGLTexture::LoadToGPU()
     // nothing to load - probably same image (no change)
     return;
   }
+  GUIPROFILER_TEXTURE_UPLOADS(1);
+
   if (m_texture == 0)
   {
     // Have OpenGL generate a texture object handle for us
@@ -9,6 +9,7 @@
 #include "TextureGLES.h"
 
 #include "ServiceBroker.h"
+#include "guilib/GUIControlProfiler.h"
 #include "guilib/TextureFormats.h"
 #include "guilib/TextureManager.h"
 #include "rendering/GLExtensions.h"
@@ -212,6 +213,8 @@ void CGLESTexture::LoadToGPU()
     // nothing to load - probably same image (no change)
     return;
   }
+  GUIPROFILER_TEXTURE_UPLOADS(1);
+
   if (m_texture == 0)
   {
     // Have OpenGL generate a texture object handle for us
@@ -16,6 +16,8 @@
 #include "filesystem/File.h"
 #include "guilib/TextureBundle.h"
 #include "guilib/TextureFormats.h"
+#include "jobs/Job.h"
+#include "jobs/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
@@ -24,9 +26,6 @@
 
 #include <mutex>
 
-#ifdef _DEBUG_TEXTURES
-#include "utils/TimeUtils.h"
-#endif
 #if defined(TARGET_DARWIN_IOS)
 #define WIN_SYSTEM_CLASS CWinSystemIOS
 #include "windowing/ios/WinSystemIOS.h" // for g_Windowing in CGUITextureManager::FreeUnusedTextures
@@ -45,6 +44,45 @@
 #include <cassert>
 #include <exception>
 
+namespace
+{
+// loads taking longer than this are logged even without _DEBUG_TEXTURES
+constexpr std::chrono::milliseconds SLOW_LOAD_TIME{20};
+
+/*!
+ \brief Decodes a texture from a file, without uploading it to the GPU.
+ \sa CGUITextureManager::LoadAsync
+ */
+class CTextureDecodeJob : public CJob
+{
+public:
+  explicit CTextureDecodeJob(const std::string& path) : m_path(path) {}
+
+  bool DoWork() override
+  {
+    m_texture = CTexture::LoadFromFile(m_path);
+    return m_texture != nullptr;
+  }
+
+  const char* GetType() const override { return "texturedecode"; }
+
+  std::string m_path;
+  std::unique_ptr<CTexture> m_texture;
+};
+
+void LogLoadTime(const std::string& path,
+                 const std::chrono::duration<double, std::milli>& duration,
+                 const char* how)
+{
+#ifndef _DEBUG_TEXTURES
+  if (duration < SLOW_LOAD_TIME)
+    return;
+#endif
+  CLog::Log(LOGDEBUG, "CGUITextureManager: load {}: {:.3f} ms {}", CURL::GetRedacted(path),
+            duration.count(), how);
+}
+} // namespace
+
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
@@ -267,14 +305,10 @@ bool CGUITextureManager::HasTexture(const std::string &textureName, std::string
 
   // Check our loaded and bundled textures - we store in bundles using \\.
   std::string bundledName = CTextureBundle::Normalize(textureName);
-  for (int i = 0; i < (int)m_vecTextures.size(); ++i)
+  if (m_textures.find(textureName) != m_textures.end())
   {
-    CTextureMap *pMap = m_vecTextures[i];
-    if (pMap->GetName() == textureName)
-    {
-      if (size) *size = 1;
-      return true;
-    }
+    if (size) *size = 1;
+    return true;
   }
 
   for (int i = 0; i < 2; i++)
@@ -295,30 +329,58 @@ bool CGUITextureManager::HasTexture(const std::string &textureName, std::string
 
 const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName, bool checkBundleOnly /*= false */)
 {
-  std::string strPath;
   static CTextureArray emptyTexture;
+  bool pending = false;
+
+  CTextureMap* pMap = GetTextureMap(strTextureName, checkBundleOnly, false, pending);
+  if (!pMap)
+    return emptyTexture;
+
+  return pMap->GetTexture();
+}
+
+bool CGUITextureManager::LoadAsync(const std::string& strTextureName, CTextureArray& texture)
+{
+  bool pending = false;
+
+  CTextureMap* pMap = GetTextureMap(strTextureName, false, true, pending);
+  if (!pMap)
+  {
+    texture.Reset();
+    return pending;
+  }
+
+  texture = pMap->GetTexture();
+  return true;
+}
+
+CTextureMap* CGUITextureManager::GetTextureMap(const std::string& strTextureName,
+                                               bool checkBundleOnly,
+                                               bool async,
+                                               bool& pending)
+{
+  std::string strPath;
   int bundle = -1;
   int size = 0;
 
+  pending = false;
+
   if (strTextureName.empty())
-    return emptyTexture;
+    return nullptr;
 
   if (!HasTexture(strTextureName, &strPath, &bundle, &size))
-    return emptyTexture;
+    return nullptr;
 
   if (size) // we found the texture
   {
-    for (int i = 0; i < (int)m_vecTextures.size(); ++i)
+    const auto it = m_textures.find(strTextureName);
+    if (it != m_textures.end())
     {
-      CTextureMap *pMap = m_vecTextures[i];
-      if (pMap->GetName() == strTextureName)
-      {
-        //CLog::Log(LOGDEBUG, "Total memusage {}", GetMemoryUsage());
-        return pMap->GetTexture();
-      }
+      //CLog::Log(LOGDEBUG, "Total memusage {}", GetMemoryUsage());
+      return it->second;
     }
     // Whoops, not there.
-    return emptyTexture;
+    return nullptr;
   }
 
   for (auto i = m_unusedTextures.begin(); i != m_unusedTextures.end(); ++i)
@@ -330,21 +392,19 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
 
     if (pMap->GetName() == strTextureName && duration.count() > 0)
     {
-      m_vecTextures.push_back(pMap);
+      m_textures.emplace(strTextureName, pMap);
       m_unusedTextures.erase(i);
-      return pMap->GetTexture();
+      return pMap;
     }
   }
 
   if (checkBundleOnly && bundle == -1)
-    return emptyTexture;
+    return nullptr;
 
   //Lock here, we will do stuff that could break rendering
   std::unique_lock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
-#ifdef _DEBUG_TEXTURES
   const auto start = std::chrono::steady_clock::now();
-#endif
 
   if (bundle >= 0 && StringUtils::EndsWithNoCase(strPath, ".gif"))
   {
@@ -354,7 +414,7 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
     if (!animation)
     {
       CLog::Log(LOGERROR, "Texture manager unable to load bundled file: {}", strTextureName);
-      return emptyTexture;
+      return nullptr;
     }
 
     int nLoops = animation.value().loops;
@@ -374,8 +434,9 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
     pMap->SetWidth((int)maxWidth);
     pMap->SetHeight((int)maxHeight);
 
-    m_vecTextures.push_back(pMap);
-    return pMap->GetTexture();
+    m_textures.emplace(strTextureName, pMap);
+    AddSyncLoad(strPath, start, true);
+    return pMap;
   }
   else if (StringUtils::EndsWithNoCase(strPath, ".gif") ||
            StringUtils::EndsWithNoCase(strPath, ".apng"))
@@ -394,7 +455,7 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
     {
       CLog::Log(LOGERROR, "Texture manager unable to load file: {}", CURL::GetRedacted(strPath));
       file.Close();
-      return emptyTexture;
+      return nullptr;
     }
 
     CTextureMap* pMap = new CTextureMap(strTextureName, 0, 0, 0);
@@ -432,8 +493,9 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
 
     file.Close();
 
-    m_vecTextures.push_back(pMap);
-    return pMap->GetTexture();
+    m_textures.emplace(strTextureName, pMap);
+    AddSyncLoad(strPath, start, false);
+    return pMap;
   }
 
   std::unique_ptr<CTexture> pTexture;
@@ -445,36 +507,174 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
     if (!texture)
     {
       CLog::Log(LOGERROR, "Texture manager unable to load bundled file: {}", strTextureName);
-      return emptyTexture;
+      return nullptr;
     }
 
     pTexture = std::move(texture.value().texture);
     width = texture.value().width;
     height = texture.value().height;
+    AddSyncLoad(strPath, start, true);
   }
   else
   {
-    pTexture = CTexture::LoadFromFile(strPath);
-    if (!pTexture)
-      return emptyTexture;
+    bool decoding = false;
+    if (TakeDecodedTexture(strTextureName, pTexture, decoding))
+    {
+      // decoded by a background job
+      if (!pTexture)
+        return nullptr;
+    }
+    else if (async)
+    {
+      if (!decoding)
+        QueueDecode(strTextureName, strPath);
+      pending = true;
+      return nullptr;
+    }
+    else
+    {
+      if (decoding)
+        CancelDecode(strTextureName);
+
+      pTexture = CTexture::LoadFromFile(strPath);
+      if (!pTexture)
+        return nullptr;
+      AddSyncLoad(strPath, start, false);
+    }
     width = pTexture->GetWidth();
     height = pTexture->GetHeight();
   }
 
-  if (!pTexture) return emptyTexture;
+  if (!pTexture) return nullptr;
 
   CTextureMap* pMap = new CTextureMap(strTextureName, width, height, 0);
   pMap->Add(std::move(pTexture), 100);
-  m_vecTextures.push_back(pMap);
+  m_textures.emplace(strTextureName, pMap);
 
-#ifdef _DEBUG_TEXTURES
-  const auto end = std::chrono::steady_clock::now();
-  const std::chrono::duration<double, std::milli> duration = end - start;
-  CLog::Log(LOGDEBUG, "Load {}: {:.3f} ms {}", strPath, duration.count(),
-            (bundle >= 0) ? "(bundled)" : "");
-#endif
+  return pMap;
+}
 
-  return pMap->GetTexture();
+bool CGUITextureManager::TakeDecodedTexture(const std::string& strTextureName,
+                                            std::unique_ptr<CTexture>& texture,
+                                            bool& pending)
+{
+  std::unique_lock lock(m_section);
+
+  const auto it = m_pendingDecodes.find(strTextureName);
+  if (it == m_pendingDecodes.end())
+  {
+    pending = false;
+    return false;
+  }
+
+  pending = !it->second.done;
+  if (pending)
+    return false;
+
+  LogLoadTime(strTextureName, it->second.end - it->second.start, "(decoded in background)");
+  texture = std::move(it->second.texture);
+  m_pendingDecodes.erase(it);
+  return true;
+}
+
+void CGUITextureManager::QueueDecode(const std::string& strTextureName, const std::string& strPath)
+{
+  std::unique_lock lock(m_section);
+
+  CPendingDecode& decode = m_pendingDecodes[strTextureName];
+  decode.start = std::chrono::steady_clock::now();
+  decode.jobId = CServiceBroker::GetJobManager()->AddJob(new CTextureDecodeJob(strPath), this,
+                                                         CJob::PRIORITY_HIGH);
+  if (!decode.jobId)
+  {
+    // job manager is shutting down, report the texture as failed
+    decode.done = true;
+    decode.end = decode.start;
+  }
+}
+
+void CGUITextureManager::OnJobComplete(unsigned int jobID, bool success, CJob* job)
+{
+  std::unique_lock lock(m_section);
+
+  // the texture may have been loaded synchronously or released in the meantime
+  for (auto& [name, decode] : m_pendingDecodes)
+  {
+    if (decode.jobId == jobID && !decode.done)
+    {
+      decode.done = true;
+      decode.end = std::chrono::steady_clock::now();
+      if (success)
+        decode.texture = std::move(static_cast<CTextureDecodeJob*>(job)->m_texture);
+      else
+        CLog::Log(LOGERROR, "Texture manager unable to load file: {}",
+                  CURL::GetRedacted(static_cast<CTextureDecodeJob*>(job)->m_path));
+      return;
+    }
+  }
+}
+
+void CGUITextureManager::CancelDecode(const std::string& strTextureName)
+{
+  unsigned int jobId = 0;
+  {
+    std::unique_lock lock(m_section);
+    const auto it = m_pendingDecodes.find(strTextureName);
+    if (it == m_pendingDecodes.end())
+      return;
+
+    if (!it->second.done)
+      jobId = it->second.jobId;
+    m_pendingDecodes.erase(it);
+  }
+
+  // not under our lock, the job manager may be calling OnJobComplete()
+  if (jobId)
+    CServiceBroker::GetJobManager()->CancelJob(jobId);
+}
+
+void CGUITextureManager::CancelDecodes()
+{
+  std::vector<unsigned int> jobIds;
+  {
+    std::unique_lock lock(m_section);
+    for (const auto& [name, decode] : m_pendingDecodes)
+    {
+      if (!decode.done)
+        jobIds.push_back(decode.jobId);
+    }
+    m_pendingDecodes.clear();
+  }
+
+  for (unsigned int jobId : jobIds)
+    CServiceBroker::GetJobManager()->CancelJob(jobId);
+}
+
+void CGUITextureManager::AddSyncLoad(const std::string& strPath,
+                                     std::chrono::steady_clock::time_point start,
+                                     bool bundled)
+{
+  const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+
+  LogLoadTime(strPath, duration, bundled ? "(bundled)" : "");
+
+  m_syncLoads++;
+  m_syncLoadTime += duration;
+}
+
+void CGUITextureManager::EndFrame()
+{
+  std::unique_lock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+
+  if (!m_syncLoads)
+    return;
+
+  CLog::Log(LOGDEBUG, "CGUITextureManager: {} texture(s) loaded on the render thread in {:.3f} ms",
+            m_syncLoads, m_syncLoadTime.count());
+
+  m_syncLoads = 0;
+  m_syncLoadTime = std::chrono::duration<double, std::milli>::zero();
 }
 
 
@@ -482,28 +682,23 @@ void CGUITextureManager::ReleaseTexture(const std::string& strTextureName, bool
 {
   std::unique_lock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
-  ivecTextures i;
-  i = m_vecTextures.begin();
-  while (i != m_vecTextures.end())
+  const auto i = m_textures.find(strTextureName);
+  if (i != m_textures.end())
   {
-    CTextureMap* pMap = *i;
-    if (pMap->GetName() == strTextureName)
+    CTextureMap* pMap = i->second;
+    if (pMap->Release())
     {
-      if (pMap->Release())
-      {
-        //CLog::Log(LOGINFO, "  cleanup:{}", strTextureName);
-        // add to our textures to free
-        std::chrono::time_point<std::chrono::steady_clock> timestamp;
+      //CLog::Log(LOGINFO, "  cleanup:{}", strTextureName);
+      // add to our textures to free
+      std::chrono::time_point<std::chrono::steady_clock> timestamp;
 
-        if (!immediately)
-          timestamp = std::chrono::steady_clock::now();
+      if (!immediately)
+        timestamp = std::chrono::steady_clock::now();
 
-        m_unusedTextures.emplace_back(pMap, timestamp);
-        i = m_vecTextures.erase(i);
-      }
-      return;
+      m_unusedTextures.emplace_back(pMap, timestamp);
+      m_textures.erase(i);
     }
-    ++i;
+    return;
   }
   CLog::Log(LOGWARNING, "{}: Unable to release texture {}", __FUNCTION__, strTextureName);
 }
@@ -525,6 +720,14 @@ void CGUITextureManager::FreeUnusedTextures(unsigned int timeDelay)
       ++i;
   }
 
+  {
+    // decoded images nobody picked up, e.g. the control asking for it went away meanwhile
+    std::unique_lock decodeLock(m_section);
+    const auto expired = std::chrono::steady_clock::now() - std::chrono::milliseconds(timeDelay);
+    std::erase_if(m_pendingDecodes, [expired](const auto& decode)
+                  { return decode.second.done && decode.second.end <= expired; });
+  }
+
 #if defined(HAS_GL) || defined(HAS_GLES)
   for (unsigned int i = 0; i < m_unusedHwTextures.size(); ++i)
   {
@@ -551,15 +754,14 @@ void CGUITextureManager::Cleanup()
 {
   std::unique_lock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
-  ivecTextures i;
-  i = m_vecTextures.begin();
-  while (i != m_vecTextures.end())
+  CancelDecodes();
+
+  for (const auto& [name, pMap] : m_textures)
   {
-    CTextureMap* pMap = *i;
-    CLog::Log(LOGWARNING, "{}: Having to cleanup texture {}", __FUNCTION__, pMap->GetName());
+    CLog::Log(LOGWARNING, "{}: Having to cleanup texture {}", __FUNCTION__, name);
     delete pMap;
-    i = m_vecTextures.erase(i);
   }
+  m_textures.clear();
   m_TexBundle[0].Close();
   m_TexBundle[1].Close();
   m_TexBundle[0] = CTextureBundle(true);
@@ -569,11 +771,10 @@ void CGUITextureManager::Cleanup()
 
 void CGUITextureManager::Dump() const
 {
-  CLog::Log(LOGDEBUG, "{0}: total texturemaps size: {1}", __FUNCTION__, m_vecTextures.size());
+  CLog::Log(LOGDEBUG, "{0}: total texturemaps size: {1}", __FUNCTION__, m_textures.size());
 
-  for (int i = 0; i < (int)m_vecTextures.size(); ++i)
+  for (const auto& [name, pMap] : m_textures)
   {
-    const CTextureMap* pMap = m_vecTextures[i];
     if (!pMap->IsEmpty())
       pMap->Dump();
   }
@@ -583,16 +784,21 @@ void CGUITextureManager::Flush()
 {
   std::unique_lock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
-  ivecTextures i;
-  i = m_vecTextures.begin();
-  while (i != m_vecTextures.end())
   {
-    CTextureMap* pMap = *i;
+    // drop decoded images nobody picked up
+    std::unique_lock decodeLock(m_section);
+    std::erase_if(m_pendingDecodes, [](const auto& decode) { return decode.second.done; });
+  }
+
+  auto i = m_textures.begin();
+  while (i != m_textures.end())
+  {
+    CTextureMap* pMap = i->second;
     pMap->Flush();
     if (pMap->IsEmpty() )
     {
       delete pMap;
-      i = m_vecTextures.erase(i);
+      i = m_textures.erase(i);
     }
     else
     {
@@ -604,9 +810,9 @@ void CGUITextureManager::Flush()
 unsigned int CGUITextureManager::GetMemoryUsage() const
 {
   unsigned int memUsage = 0;
-  for (int i = 0; i < (int)m_vecTextures.size(); ++i)
+  for (const auto& [name, pMap] : m_textures)
   {
-    memUsage += m_vecTextures[i]->GetMemoryUsage();
+    memUsage += pMap->GetMemoryUsage();
   }
   return memUsage;
 }
@@ -11,6 +11,7 @@
 #include "GUIComponent.h"
 #include "TextureBundle.h"
 #include "TextureScaling.h"
+#include "jobs/IJobCallback.h"
 #include "threads/CriticalSection.h"
 
 #include <chrono>
@@ -19,6 +20,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -97,15 +99,42 @@ protected:
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
-class CGUITextureManager
+class CGUITextureManager : public IJobCallback
 {
 public:
   CGUITextureManager(void);
-  virtual ~CGUITextureManager(void);
+  ~CGUITextureManager(void) override;
 
   bool HasTexture(const std::string &textureName, std::string *path = NULL, int *bundle = NULL, int *size = NULL);
   static bool CanLoad(const std::string &texturePath); ///< Returns true if the texture manager can load this texture
   const CTextureArray& Load(const std::string& strTextureName, bool checkBundleOnly = false);
+
+  /*!
+   \brief Load a texture without decoding the image on the calling thread.
+
+   Textures that are loaded already, bundled or animated are returned right away as with Load().
+   Other images are decoded by a background job, \p texture stays empty until a later call (usually
+   on one of the next frames) finds the decoded image. The upload to the GPU happens on first use.
+   \param strTextureName name of the texture to load
+   \param texture [out] the texture, empty while it is being decoded
+   \return false if the texture doesn't exist or failed to load, true otherwise
+   */
+  bool LoadAsync(const std::string& strTextureName, CTextureArray& texture);
+
+  /*!
+   \brief Drop a background decode started by LoadAsync() that is no longer needed.
+   \param strTextureName name of the texture passed to LoadAsync()
+   */
+  void CancelLoadAsync(const std::string& strTextureName) { CancelDecode(strTextureName); }
+
+  void OnJobComplete(unsigned int jobID, bool success, CJob* job) override;
+
+  /*!
+   \brief Log the textures that were loaded on the render thread during the last frame
+   \note Called once per rendered frame.
+   */
+  void EndFrame();
+
   void ReleaseTexture(const std::string& strTextureName, bool immediately = false);
   void Cleanup();
   void Dump() const;
@@ -121,15 +150,42 @@ public:
   void FreeUnusedTextures(unsigned int timeDelay = 0); ///< Free textures (called from app thread only)
   void ReleaseHwTexture(unsigned int texture);
 protected:
-  std::vector<CTextureMap*> m_vecTextures;
+  CTextureMap* GetTextureMap(const std::string& strTextureName,
+                             bool checkBundleOnly,
+                             bool async,
+                             bool& pending);
+  bool TakeDecodedTexture(const std::string& strTextureName,
+                          std::unique_ptr<CTexture>& texture,
+                          bool& pending);
+  void QueueDecode(const std::string& strTextureName, const std::string& strPath);
+  void CancelDecode(const std::string& strTextureName);
+  void CancelDecodes();
+  void AddSyncLoad(const std::string& strPath,
+                   std::chrono::steady_clock::time_point start,
+                   bool bundled);
+
+  struct CPendingDecode
+  {
+    unsigned int jobId = 0;
+    bool done = false;
+    std::unique_ptr<CTexture> texture;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+  };
+
+  std::unordered_map<std::string, CTextureMap*> m_textures; ///< loaded textures by name
   std::list<std::pair<CTextureMap*, std::chrono::time_point<std::chrono::steady_clock>>>
       m_unusedTextures;
   std::vector<unsigned int> m_unusedHwTextures;
-  typedef std::vector<CTextureMap*>::iterator ivecTextures;
+  std::unordered_map<std::string, CPendingDecode> m_pendingDecodes; ///< background decodes by texture name
   // we have 2 texture bundles (one for the base textures, one for the theme)
   CTextureBundle m_TexBundle[2];
 
   std::vector<std::string> m_texturePaths;
   CCriticalSection m_section;
+
+  // textures loaded on the render thread since the last EndFrame()
+  unsigned int m_syncLoads = 0;
+  std::chrono::duration<double, std::milli> m_syncLoadTime{0};
 };
 
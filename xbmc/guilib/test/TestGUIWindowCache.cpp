@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2026 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/Skin.h"
+#include "addons/addoninfo/AddonInfoBuilder.h"
+#include "addons/addoninfo/AddonType.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "guilib/GUIWindowCache.h"
+#include "test/TestUtils.h"
+#include "utils/XBMCTinyXML.h"
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+constexpr const char* WINDOW_XML = "<window><controls>"
+                                   "<control type=\"label\" id=\"2\"><label>Hello</label></control>"
+                                   "<control type=\"button\"><onclick><![CDATA[Back]]></onclick>"
+                                   "</control></controls></window>";
+
+std::string ToString(const TiXmlElement& element)
+{
+  std::string str;
+  str << element;
+  return str;
+}
+} // namespace
+
+class TestGUIWindowCache : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    g_SkinInfo = std::make_shared<ADDON::CSkinInfo>(
+        ADDON::CAddonInfoBuilder::Generate("skin.test", ADDON::AddonType::SKIN),
+        RESOLUTION_INFO());
+
+    m_windowFile = XBMC_CREATETEMPFILE(".xml");
+    ASSERT_NE(nullptr, m_windowFile);
+    const std::string xml(WINDOW_XML);
+    ASSERT_EQ(static_cast<ssize_t>(xml.size()), m_windowFile->Write(xml.c_str(), xml.size()));
+    m_windowFile->Close();
+
+    CXBMCTinyXML doc;
+    ASSERT_TRUE(doc.Parse(xml));
+    m_root.reset(static_cast<TiXmlElement*>(doc.RootElement()->Clone()));
+  }
+
+  void TearDown() override
+  {
+    XBMC_DELETETEMPFILE(m_windowFile);
+    XFILE::CDirectory::RemoveRecursive("special://temp/skin_cache/");
+    g_SkinInfo.reset();
+  }
+
+  std::string GetWindowPath() const { return XBMC_TEMPFILEPATH(m_windowFile); }
+
+  XFILE::CFile* m_windowFile = nullptr;
+  std::unique_ptr<TiXmlElement> m_root;
+};
+
+TEST_F(TestGUIWindowCache, RoundTrip)
+{
+  std::map<INFO::InfoPtr, bool> conditions;
+  EXPECT_EQ(nullptr, CGUIWindowCache::Load(GetWindowPath(), conditions));
+
+  CGUIWindowCache::Save(GetWindowPath(), *m_root, {});
+
+  const std::unique_ptr<TiXmlElement> cached = CGUIWindowCache::Load(GetWindowPath(), conditions);
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(ToString(*m_root), ToString(*cached));
+  EXPECT_TRUE(conditions.empty());
+}
+
+TEST_F(TestGUIWindowCache, InvalidatedByModifiedWindowFile)
+{
+  CGUIWindowCache::Save(GetWindowPath(), *m_root, {});
+
+  std::map<INFO::InfoPtr, bool> conditions;
+  ASSERT_NE(nullptr, CGUIWindowCache::Load(GetWindowPath(), conditions));
+
+  // same size, only the modification time differs
+  const std::filesystem::path path(GetWindowPath());
+  std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + 10s);
+
+  EXPECT_EQ(nullptr, CGUIWindowCache::Load(GetWindowPath(), conditions));
+}
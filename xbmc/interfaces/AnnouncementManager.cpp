@@ -9,6 +9,9 @@
 #include "AnnouncementManager.h"
 
 #include "FileItem.h"
+#include "ServiceBroker.h"
+#include "jobs/Job.h"
+#include "jobs/JobManager.h"
 #include "music/MusicDatabase.h"
 #include "music/tags/MusicInfoTag.h"
 #include "playlists/PlayListTypes.h"
@@ -20,11 +23,14 @@
 #include "video/VideoDatabase.h"
 #include "video/VideoFileItemClassify.h"
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 
 #define LOOKUP_PROPERTY "database-lookup"
 
+using namespace std::chrono_literals;
+
 using namespace ANNOUNCEMENT;
 using namespace KODI;
 
@@ -32,6 +38,23 @@ const std::string CAnnouncementManager::ANNOUNCEMENT_SENDER = "xbmc";
 
 namespace
 {
+// announcers lagging behind by more than this lose their oldest announcements
+constexpr size_t MAX_PENDING_ANNOUNCEMENTS = 1000;
+
+// library announcements come in bursts while scanning. they are held back for a moment so
+// identical ones can be merged before they are sent out.
+std::chrono::milliseconds GetCoalescingWindow(AnnouncementFlag flag)
+{
+  switch (flag)
+  {
+    case VideoLibrary:
+    case AudioLibrary:
+    case Sources:
+      return 250ms;
+    default:
+      return 0ms;
+  }
+}
 
 void CopyPVRTagInfoToObject(const PVR::CPVRChannel& channel, bool copyPlayerId, CVariant& object)
 {
@@ -219,6 +242,35 @@ CVariant CreateDataObjectFromItem(CFileItem& item, const CVariant& data)
 
 } // unnamed namespace
 
+class CAnnouncementManager::CDeliveryJob : public CJob
+{
+public:
+  explicit CDeliveryJob(std::shared_ptr<CAnnouncerQueue> queue) : m_queue(std::move(queue)) {}
+
+  ~CDeliveryJob() override
+  {
+    // a job cancelled before it ran must not keep the queue from being scheduled again
+    if (!m_done)
+    {
+      std::unique_lock lock(m_queue->queueCritSection);
+      m_queue->scheduled = false;
+    }
+  }
+
+  bool DoWork() override
+  {
+    Deliver(m_queue);
+    m_done = true;
+    return true;
+  }
+
+  const char* GetType() const override { return "announcement"; }
+
+private:
+  std::shared_ptr<CAnnouncerQueue> m_queue;
+  bool m_done = false;
+};
+
 CAnnouncementManager::CAnnouncementManager() : CThread("Announce")
 {
 }
@@ -238,8 +290,24 @@ void CAnnouncementManager::Deinitialize()
   m_bStop = true;
   m_queueEvent.Set();
   StopThread();
-  std::unique_lock lock(m_announcersCritSection);
-  m_announcers.clear();
+
+  std::unordered_map<IAnnouncer*, std::shared_ptr<CAnnouncerQueue>> announcers;
+  {
+    std::unique_lock lock(m_announcersCritSection);
+    announcers.swap(m_announcers);
+  }
+
+  for (const auto& [announcer, queue] : announcers)
+    Remove(queue);
+}
+
+CAnnouncementManager::Statistics CAnnouncementManager::GetStatistics() const
+{
+  Statistics statistics;
+  statistics.queued = m_queued;
+  statistics.coalesced = m_coalesced;
+  statistics.dropped = m_dropped;
+  return statistics;
 }
 
 void CAnnouncementManager::AddAnnouncer(IAnnouncer *listener)
@@ -253,7 +321,13 @@ void CAnnouncementManager::AddAnnouncer(IAnnouncer* listener, int flagMask)
     return;
 
   std::unique_lock lock(m_announcersCritSection);
-  m_announcers.emplace(listener, flagMask);
+  if (m_announcers.contains(listener))
+    return;
+
+  auto queue = std::make_shared<CAnnouncerQueue>();
+  queue->announcer = listener;
+  queue->flagMask = flagMask;
+  m_announcers.emplace(listener, queue);
 }
 
 void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
@@ -261,8 +335,87 @@ void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
   if (!listener)
     return;
 
-  std::unique_lock lock(m_announcersCritSection);
-  m_announcers.erase(listener);
+  std::shared_ptr<CAnnouncerQueue> queue;
+  {
+    std::unique_lock lock(m_announcersCritSection);
+    auto it = m_announcers.find(listener);
+    if (it == m_announcers.end())
+      return;
+
+    queue = it->second;
+    m_announcers.erase(it);
+  }
+
+  Remove(queue);
+}
+
+void CAnnouncementManager::Remove(const std::shared_ptr<CAnnouncerQueue>& queue)
+{
+  {
+    std::unique_lock lock(queue->queueCritSection);
+    queue->removed = true;
+    queue->announcements.clear();
+  }
+
+  // the announcer may go away once this returns, so wait for a call in progress to finish. an
+  // announcer removing itself from within Announce() already holds the lock.
+  std::unique_lock lock(queue->deliveryCritSection);
+}
+
+void CAnnouncementManager::Enqueue(const std::shared_ptr<CAnnouncerQueue>& queue,
+                                   const std::shared_ptr<const CAnnounceData>& announcement)
+{
+  {
+    std::unique_lock lock(queue->queueCritSection);
+    if (queue->removed)
+      return;
+
+    if (queue->announcements.size() >= MAX_PENDING_ANNOUNCEMENTS)
+    {
+      CLog::LogFC(LOGWARNING, LOGANNOUNCE,
+                  "CAnnouncementManager - Announcer is {} announcements behind, dropping {}",
+                  queue->announcements.size(), queue->announcements.front()->message);
+      queue->announcements.pop_front();
+      m_dropped++;
+    }
+
+    queue->announcements.push_back(announcement);
+    if (queue->scheduled)
+      return;
+
+    queue->scheduled = true;
+  }
+
+  const std::shared_ptr<CJobManager> jobManager = CServiceBroker::GetJobManager();
+  if (!jobManager ||
+      jobManager->AddJob(new CDeliveryJob(queue), nullptr, CJob::PRIORITY_DEDICATED) == 0)
+  {
+    // no more jobs while shutting down
+    Deliver(queue);
+  }
+}
+
+void CAnnouncementManager::Deliver(const std::shared_ptr<CAnnouncerQueue>& queue)
+{
+  std::unique_lock deliveryLock(queue->deliveryCritSection);
+  while (true)
+  {
+    std::shared_ptr<const CAnnounceData> announcement;
+    {
+      std::unique_lock lock(queue->queueCritSection);
+      if (queue->removed || queue->announcements.empty())
+      {
+        queue->scheduled = false;
+        return;
+      }
+
+      announcement = queue->announcements.front();
+      queue->announcements.pop_front();
+    }
+
+    queue->announcer->Announce(announcement->flag, announcement->sender, announcement->message,
+                               announcement->data);
+  }
 }
 
 void CAnnouncementManager::Announce(AnnouncementFlag flag, const std::string& message)
@@ -326,9 +479,28 @@ void CAnnouncementManager::Announce(AnnouncementFlag flag,
   if (item != nullptr)
     announcement.item = std::make_shared<CFileItem>(*item);
 
+  const auto now = std::chrono::steady_clock::now();
+  announcement.due = now + GetCoalescingWindow(flag);
+
+  m_queued++;
   {
     std::unique_lock lock(m_queueCritSection);
-    m_announcementQueue.push_back(announcement);
+    if (announcement.item == nullptr && announcement.due > now)
+    {
+      // an identical announcement still waiting makes this one redundant. only the most recent
+      // one of the same flag is considered, merging past a different one would reorder them
+      const auto it =
+          std::find_if(m_announcementQueue.rbegin(), m_announcementQueue.rend(),
+                       [flag](const CAnnounceData& queued) { return queued.flag == flag; });
+      if (it != m_announcementQueue.rend() && it->due > now && it->item == nullptr &&
+          it->message == message && it->sender == sender && it->data == data)
+      {
+        m_coalesced++;
+        return;
+      }
+    }
+
+    m_announcementQueue.push_back(std::move(announcement));
   }
   m_queueEvent.Set();
 }
@@ -341,16 +513,18 @@ void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag,
   CLog::LogFC(LOGWARNING, LOGANNOUNCE, "CAnnouncementManager - Announcement: {} from {}", message,
               sender);
 
-  std::unique_lock lock(m_announcersCritSection);
+  auto announcement = std::make_shared<CAnnounceData>();
+  announcement->flag = flag;
+  announcement->sender = sender;
+  announcement->message = message;
+  announcement->data = data;
 
-  // Make a copy of announcers. They may be removed or even remove themselves during execution of IAnnouncer::Announce()!
-  std::unordered_map<IAnnouncer*, int> announcers{m_announcers};
-  for (const auto& [announcer, flagMask] : announcers)
+  // only queued here, every announcer gets it from its own job
+  std::unique_lock lock(m_announcersCritSection);
+  for (const auto& [announcer, queue] : m_announcers)
   {
-    if (flag & flagMask)
-    {
-      announcer->Announce(flag, sender, message, data);
-    }
+    if (flag & queue->flagMask)
+      Enqueue(queue, announcement);
   }
 }
 
@@ -373,20 +547,36 @@ void CAnnouncementManager::Process()
   while (!m_bStop)
   {
     std::unique_lock lock(m_queueCritSection);
-    if (!m_announcementQueue.empty())
+    const auto now = std::chrono::steady_clock::now();
+
+    // announcements held back for coalescing don't delay those of other kinds queued after them
+    auto it = std::ranges::find_if(m_announcementQueue,
+                                   [now](const CAnnounceData& data) { return data.due <= now; });
+    if (it != m_announcementQueue.end())
     {
-      auto announcement = m_announcementQueue.front();
-      m_announcementQueue.pop_front();
+      auto announcement = std::move(*it);
+      m_announcementQueue.erase(it);
       {
         CSingleExit ex(m_queueCritSection);
         DoAnnounce(announcement.flag, announcement.sender, announcement.message, announcement.item,
                    announcement.data);
       }
     }
+    else if (!m_announcementQueue.empty())
+    {
+      const auto due = std::ranges::min_element(m_announcementQueue, {}, &CAnnounceData::due)->due;
+      CSingleExit ex(m_queueCritSection);
+      m_queueEvent.Wait(std::chrono::ceil<std::chrono::milliseconds>(due - now));
+    }
     else
     {
       CSingleExit ex(m_queueCritSection);
       m_queueEvent.Wait();
     }
   }
+
+  CLog::Log(LOGDEBUG,
+            "CAnnouncementManager - {} announcements queued, {} coalesced, {} dropped by "
+            "announcers lagging behind",
+            m_queued.load(), m_coalesced.load(), m_dropped.load());
 }
@@ -14,6 +14,10 @@
 #include "threads/Thread.h"
 #include "utils/Variant.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
 #include <list>
 #include <memory>
 #include <unordered_map>
@@ -62,6 +66,15 @@ namespace ANNOUNCEMENT
     // a big number of python addons and third party json consumers.
     static const std::string ANNOUNCEMENT_SENDER;
 
+    struct Statistics
+    {
+      uint64_t queued = 0; //!< announcements passed to Announce()
+      uint64_t coalesced = 0; //!< announcements merged into an identical one still waiting
+      uint64_t dropped = 0; //!< deliveries discarded because an announcer fell too far behind
+    };
+
+    Statistics GetStatistics() const;
+
   protected:
     void Process() override;
     void DoAnnounce(AnnouncementFlag flag,
@@ -81,6 +94,7 @@ namespace ANNOUNCEMENT
       std::string message;
       std::shared_ptr<CFileItem> item;
       CVariant data;
+      std::chrono::steady_clock::time_point due; //!< end of the coalescing window
     };
     std::list<CAnnounceData> m_announcementQueue;
     CEvent m_queueEvent;
@@ -89,8 +103,35 @@ namespace ANNOUNCEMENT
     CAnnouncementManager(const CAnnouncementManager&) = delete;
     CAnnouncementManager const& operator=(CAnnouncementManager const&) = delete;
 
+    /*!
+     \brief The announcements waiting to be delivered to one announcer. Every announcer is called
+     from its own job so a slow one doesn't hold up the others, while the order of the
+     announcements it gets is kept.
+     */
+    struct CAnnouncerQueue
+    {
+      IAnnouncer* announcer = nullptr;
+      int flagMask = 0;
+      CCriticalSection queueCritSection;
+      std::deque<std::shared_ptr<const CAnnounceData>> announcements;
+      bool scheduled = false;
+      bool removed = false;
+      CCriticalSection deliveryCritSection; //!< held while calling the announcer
+    };
+
+    class CDeliveryJob;
+
+    void Enqueue(const std::shared_ptr<CAnnouncerQueue>& queue,
+                 const std::shared_ptr<const CAnnounceData>& announcement);
+    static void Deliver(const std::shared_ptr<CAnnouncerQueue>& queue);
+    static void Remove(const std::shared_ptr<CAnnouncerQueue>& queue);
+
     CCriticalSection m_announcersCritSection;
     CCriticalSection m_queueCritSection;
-    std::unordered_map<IAnnouncer*, int> m_announcers;
+    std::unordered_map<IAnnouncer*, std::shared_ptr<CAnnouncerQueue>> m_announcers;
+
+    std::atomic<uint64_t> m_queued{0};
+    std::atomic<uint64_t> m_coalesced{0};
+    std::atomic<uint64_t> m_dropped{0};
   };
 }
@@ -8,6 +8,8 @@
 
 #include "InfoBool.h"
 
+#include "GUIInfoManager.h"
+#include "guilib/GUIControlProfiler.h"
 #include "utils/StringUtils.h"
 
 namespace INFO
@@ -17,4 +19,32 @@ InfoBool::InfoBool(const std::string& expression, int context, unsigned int& ref
 {
   StringUtils::ToLower(m_expression);
 }
+
+bool InfoBool::NeedsUpdate()
+{
+  switch (m_source)
+  {
+    case InfoSource::CONSTANT:
+      if (m_evaluated)
+        return false;
+      break;
+    case InfoSource::SKIN_SETTINGS:
+    case InfoSource::PLAYER_STATE:
+    case InfoSource::ACTIVE_WINDOWS:
+    {
+      const unsigned int counter = m_infoMgr->GetSourceCounter(m_source);
+      if (m_evaluated && counter == m_sourceCounter)
+        return false;
+      m_sourceCounter = counter;
+      break;
+    }
+    case InfoSource::DYNAMIC:
+    default:
+      break;
+  }
+
+  m_evaluated = true;
+  GUIPROFILER_INFO_EVALUATIONS(1);
+  return true;
+}
 }
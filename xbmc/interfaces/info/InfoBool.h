@@ -16,6 +16,19 @@ class CGUIInfoManager;
 
 namespace INFO
 {
+/*!
+ \ingroup info
+ \brief What the value of a boolean condition depends on, deciding when it has to be re-evaluated
+ */
+enum class InfoSource
+{
+  DYNAMIC, ///< may change at any time, re-evaluated whenever the info cache is reset
+  SKIN_SETTINGS, ///< changes only when a skin setting changes
+  PLAYER_STATE, ///< changes only when playback starts, stops, pauses or changes speed
+  ACTIVE_WINDOWS, ///< changes only when a window or dialog is activated, starts closing or closes
+  CONSTANT, ///< never changes
+};
+
 /*!
  \ingroup info
  \brief Base class, wrapping boolean conditions and expressions
@@ -68,14 +81,26 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+  InfoSource GetSource() const { return m_source; }
+
 protected:
+  /*! \brief Check whether the value may have changed since the last evaluation
+   Conditions that don't depend on dynamic info are evaluated once, and again only
+   after what they depend on has changed.
+   \return true if Update() has to evaluate the condition
+   */
+  bool NeedsUpdate();
+
   bool m_value = false; ///< current value
   int m_context;               ///< contextual information to go with the condition
   bool m_listItemDependent = false; ///< do not cache if a listitem pointer is given
   std::string  m_expression;   ///< original expression
   CGUIInfoManager* m_infoMgr;
+  InfoSource m_source = InfoSource::DYNAMIC; ///< what the value depends on
 
 private:
+  bool m_evaluated = false; ///< whether the value was evaluated at least once
+  unsigned int m_sourceCounter = 0; ///< change counter of m_source at the last evaluation
   unsigned int m_refreshCounter = 0;
   unsigned int &m_parentRefreshCounter;
 };
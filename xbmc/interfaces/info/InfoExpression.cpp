@@ -11,6 +11,7 @@
 #include "GUIInfoManager.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <list>
 #include <memory>
 #include <stack>
@@ -21,10 +22,14 @@ void InfoSingle::Initialize(CGUIInfoManager* infoMgr)
 {
   InfoBool::Initialize(infoMgr);
   m_condition = m_infoMgr->TranslateSingleString(m_expression, m_listItemDependent);
+  m_source = m_infoMgr->GetInfoSource(m_condition);
 }
 
 void InfoSingle::Update(int contextWindow, const CGUIListItem* item)
 {
+  if (!NeedsUpdate())
+    return;
+
   // use propagated context in case this info has the default context (i.e. if not tied to a specific window)
   // its value might depend on the context in which the evaluation was called
   int context = m_context == DEFAULT_CONTEXT ? contextWindow : m_context;
@@ -34,19 +39,30 @@ void InfoSingle::Update(int contextWindow, const CGUIListItem* item)
 void InfoExpression::Initialize(CGUIInfoManager* infoMgr)
 {
   InfoBool::Initialize(infoMgr);
-  if (!Parse(m_expression))
+  InfoSubexpressionPtr tree;
+  if (!Parse(m_expression, tree))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression {}", m_expression);
-    m_expression_tree = std::make_shared<InfoLeaf>(m_infoMgr->Register("false", 0), false);
+    tree = std::make_shared<InfoLeaf>(m_infoMgr->Register("false", 0), false);
   }
+  Compile(tree);
 }
 
 void InfoExpression::Update(int contextWindow, const CGUIListItem* item)
 {
+  if (!NeedsUpdate())
+    return;
+
+  if (m_nodes.empty())
+  {
+    m_value = m_constantValue;
+    return;
+  }
+
   // use propagated context in case this info expression has the default context (i.e. if not tied to a specific window)
   // its value might depend on the context in which the evaluation was called
   int context = m_context == DEFAULT_CONTEXT ? contextWindow : m_context;
-  m_value = m_expression_tree->Evaluate(context, item);
+  m_value = Evaluate(0, context, item);
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
@@ -65,56 +81,198 @@ void InfoExpression::Update(int contextWindow, const CGUIListItem* item)
  * 2) Combining adjacent AND or OR operations such that each path from the root
  *    to a leaf encounters a strictly alternating pattern of AND and OR
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
+ *
+ * The tree is then compiled into flat arrays of nodes. While compiling, leaves
+ * whose value can never change are folded into their groups, groups left with
+ * a single child are replaced by it (splicing it into its parent if they are of
+ * the same type) and duplicate leaves within a group are dropped. Leaves are
+ * shared between all expressions by the info manager, so a condition used in
+ * many expressions is still only evaluated once per frame.
  */
 
-bool InfoExpression::InfoLeaf::Evaluate(int contextWindow, const CGUIListItem* item)
+struct InfoExpression::FoldedNode
+{
+  bool constant = false;
+  bool value = false; // constants only
+  node_type_t type = NODE_LEAF;
+  bool invert = false; // leaves only
+  InfoPtr info; // leaves only
+  std::vector<FoldedNode> children; // groups only
+};
+
+void InfoExpression::Compile(const InfoSubexpressionPtr& tree)
 {
-  return m_invert ^ m_info->Get(contextWindow, item);
+  m_nodes.clear();
+  m_children.clear();
+  m_leaves.clear();
+
+  FoldedNode root = Fold(tree);
+  if (root.constant)
+  {
+    m_constantValue = root.value;
+    m_listItemDependent = false;
+    m_source = InfoSource::CONSTANT;
+    return;
+  }
+
+  Emit(root);
+
+  // the expression can only skip evaluation if all leaves change with the same source, the
+  // leaves still cache their own values otherwise
+  m_listItemDependent = false;
+  m_source = m_leaves.front()->GetSource();
+  for (const auto& leaf : m_leaves)
+  {
+    m_listItemDependent |= leaf->ListItemDependent();
+    if (leaf->GetSource() != m_source)
+      m_source = InfoSource::DYNAMIC;
+  }
 }
 
-InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
-    node_type_t type,
-    const InfoSubexpressionPtr &left,
-    const InfoSubexpressionPtr &right)
-    : m_type(type)
+InfoExpression::FoldedNode InfoExpression::Fold(const InfoSubexpressionPtr& node)
 {
-  AddChild(right);
-  AddChild(left);
+  FoldedNode folded;
+  if (node->Type() == NODE_LEAF)
+  {
+    const auto& leaf = static_cast<const InfoLeaf&>(*node);
+    if (leaf.Info()->GetSource() == InfoSource::CONSTANT)
+    {
+      folded.constant = true;
+      folded.value = leaf.Invert() ^ leaf.Info()->Get(DEFAULT_CONTEXT);
+    }
+    else
+    {
+      folded.info = leaf.Info();
+      folded.invert = leaf.Invert();
+    }
+    return folded;
+  }
+
+  const auto& group = static_cast<const InfoAssociativeGroup&>(*node);
+  const bool use_and = (group.Type() == NODE_AND);
+  folded.type = group.Type();
+  for (const auto& child : group.Children())
+  {
+    FoldedNode foldedChild = Fold(child);
+    if (foldedChild.constant)
+    {
+      // false decides an AND group and true an OR group, otherwise the child has no effect
+      if (foldedChild.value != use_and)
+      {
+        FoldedNode result;
+        result.constant = true;
+        result.value = !use_and;
+        return result;
+      }
+      continue;
+    }
+
+    // a child group that collapsed to our own type merges into this one
+    if (foldedChild.type == folded.type)
+    {
+      for (auto& grandChild : foldedChild.children)
+        AddFoldedChild(folded.children, std::move(grandChild));
+    }
+    else
+      AddFoldedChild(folded.children, std::move(foldedChild));
+  }
+
+  if (folded.children.empty())
+  {
+    folded.constant = true;
+    folded.value = use_and;
+  }
+  else if (folded.children.size() == 1)
+  {
+    FoldedNode only = std::move(folded.children.front());
+    return only;
+  }
+  return folded;
 }
 
-void InfoExpression::InfoAssociativeGroup::AddChild(const InfoSubexpressionPtr &child)
+void InfoExpression::AddFoldedChild(std::vector<FoldedNode>& children, FoldedNode&& child)
 {
-  m_children.push_front(child); // largely undoes the effect of parsing right-associative
+  if (child.type == NODE_LEAF)
+  {
+    for (const auto& sibling : children)
+    {
+      if (sibling.type == NODE_LEAF && sibling.info == child.info && sibling.invert == child.invert)
+        return;
+    }
+  }
+  children.emplace_back(std::move(child));
 }
 
-void InfoExpression::InfoAssociativeGroup::Merge(const std::shared_ptr<InfoAssociativeGroup>& other)
+unsigned int InfoExpression::Emit(const FoldedNode& node)
 {
-  m_children.splice(m_children.end(), other->m_children);
+  const auto index = static_cast<unsigned int>(m_nodes.size());
+  m_nodes.push_back({node.type, node.invert, node.info.get(), 0, 0});
+  if (node.type == NODE_LEAF)
+  {
+    m_leaves.push_back(node.info);
+    return index;
+  }
+
+  // reserve the range of children up front so that it stays contiguous
+  const auto first = static_cast<unsigned int>(m_children.size());
+  const auto count = static_cast<unsigned int>(node.children.size());
+  m_children.resize(first + count);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    const unsigned int child = Emit(node.children[i]);
+    m_children[first + i] = child;
+  }
+  m_nodes[index].first = first;
+  m_nodes[index].count = count;
+  return index;
 }
 
-bool InfoExpression::InfoAssociativeGroup::Evaluate(int contextWindow, const CGUIListItem* item)
+bool InfoExpression::Evaluate(unsigned int index, int contextWindow, const CGUIListItem* item)
 {
+  const CompiledNode& node = m_nodes[index];
+  if (node.type == NODE_LEAF)
+    return node.invert ^ node.info->Get(contextWindow, item);
+
   /* Handle either AND or OR by using the relation
    * A AND B == !(!A OR !B)
    * to convert ANDs into ORs
    */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
-  bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(contextWindow, item);
-  while (!result && ++it != last)
+  const auto first = m_children.begin() + node.first;
+  const auto last = first + node.count;
+  bool use_and = (node.type == NODE_AND);
+  bool result = use_and ^ Evaluate(*first, contextWindow, item);
+  for (auto it = first + 1; !result && it != last; ++it)
   {
-    result = use_and ^ (*it)->Evaluate(contextWindow, item);
+    result = use_and ^ Evaluate(*it, contextWindow, item);
     if (result)
     {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
+      /* Move this child to the head of the range so we evaluate faster next time */
+      std::rotate(first, it, it + 1);
     }
   }
   return use_and ^ result;
 }
 
+InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
+    node_type_t type,
+    const InfoSubexpressionPtr &left,
+    const InfoSubexpressionPtr &right)
+    : m_type(type)
+{
+  AddChild(right);
+  AddChild(left);
+}
+
+void InfoExpression::InfoAssociativeGroup::AddChild(const InfoSubexpressionPtr &child)
+{
+  m_children.push_front(child); // largely undoes the effect of parsing right-associative
+}
+
+void InfoExpression::InfoAssociativeGroup::Merge(const std::shared_ptr<InfoAssociativeGroup>& other)
+{
+  m_children.splice(m_children.end(), other->m_children);
+}
+
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
  * (AND/OR) are treated as right-associative so that we don't need to make a
  * special case for the unary NOT operator. This has no effect upon the answers
@@ -203,7 +361,7 @@ void InfoExpression::OperatorPop(std::stack<operator_t> &operator_stack, bool &i
   }
 }
 
-bool InfoExpression::Parse(const std::string &expression)
+bool InfoExpression::Parse(const std::string &expression, InfoSubexpressionPtr& tree)
 {
   const char *s = expression.c_str();
   std::string operand;
@@ -303,6 +461,6 @@ bool InfoExpression::Parse(const std::string &expression)
   while (!operator_stack.empty())
     OperatorPop(operator_stack, invert, nodes);
 
-  m_expression_tree = nodes.top();
+  tree = nodes.top();
   return true;
 }
@@ -69,12 +69,11 @@ private:
     NODE_OR,
   } node_type_t;
 
-  // An abstract base class for nodes in the expression tree
+  // An abstract base class for nodes in the expression tree built by the parser
   class InfoSubexpression
   {
   public:
     virtual ~InfoSubexpression(void) = default; // so we can destruct derived classes using a pointer to their base class
-    virtual bool Evaluate(int contextWindow, const CGUIListItem* item) = 0;
     virtual node_type_t Type() const=0;
   };
 
@@ -85,8 +84,9 @@ private:
   {
   public:
     InfoLeaf(InfoPtr info, bool invert) : m_info(std::move(info)), m_invert(invert) {}
-    bool Evaluate(int contextWindow, const CGUIListItem* item) override;
     node_type_t Type() const override { return NODE_LEAF; }
+    const InfoPtr& Info() const { return m_info; }
+    bool Invert() const { return m_invert; }
 
   private:
     InfoPtr m_info;
@@ -100,18 +100,40 @@ private:
     InfoAssociativeGroup(node_type_t type, const InfoSubexpressionPtr &left, const InfoSubexpressionPtr &right);
     void AddChild(const InfoSubexpressionPtr &child);
     void Merge(const std::shared_ptr<InfoAssociativeGroup>& other);
-    bool Evaluate(int contextWindow, const CGUIListItem* item) override;
     node_type_t Type() const override { return m_type; }
+    const std::list<InfoSubexpressionPtr>& Children() const { return m_children; }
 
   private:
     node_type_t m_type;
     std::list<InfoSubexpressionPtr> m_children;
   };
 
+  // A node of the compiled expression. Groups own the range [first, first + count) of m_children.
+  struct CompiledNode
+  {
+    node_type_t type;
+    bool invert; // leaves only
+    InfoBool* info; // leaves only, kept alive by m_leaves
+    unsigned int first;
+    unsigned int count;
+  };
+
+  struct FoldedNode;
+
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
-  bool Parse(const std::string &expression);
-  InfoSubexpressionPtr m_expression_tree;
+  bool Parse(const std::string &expression, InfoSubexpressionPtr& tree);
+
+  void Compile(const InfoSubexpressionPtr& tree);
+  static FoldedNode Fold(const InfoSubexpressionPtr& node);
+  static void AddFoldedChild(std::vector<FoldedNode>& children, FoldedNode&& child);
+  unsigned int Emit(const FoldedNode& node);
+  bool Evaluate(unsigned int index, int contextWindow, const CGUIListItem* item);
+
+  std::vector<CompiledNode> m_nodes; ///< the compiled expression, root first. Empty if it is constant
+  std::vector<unsigned int> m_children; ///< indices of the child nodes of all groups
+  std::vector<InfoPtr> m_leaves; ///< the conditions referenced by the leaves
+  bool m_constantValue = false; ///< value of an expression that folded to a constant
 };
 
 };
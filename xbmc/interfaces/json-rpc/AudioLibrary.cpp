@@ -26,6 +26,7 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/Artwork.h"
+#include "utils/JSONStreamWriter.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -411,79 +412,95 @@ JSONRPC_STATUS CAudioLibrary::GetSongs(const std::string &method, ITransportLaye
       fields.insert(field->asString());
   }
 
-  if (!musicdatabase.GetSongsByWhereJSON(fields, musicUrl.ToString(), result, total, sorting))
-    return InternalError;
+  bool bFetchArt = fields.contains("art");
+  bool bFetchFanart = fields.contains("fanart");
+  bool bFetchThumb = fields.contains("thumbnail");
+  std::unique_ptr<CThumbLoader> thumbLoader;
+  if (bFetchArt || bFetchFanart || bFetchThumb)
+  {
+    thumbLoader = std::make_unique<CMusicThumbLoader>();
+    thumbLoader->OnLoaderStart();
+  }
 
-  if (!result.isNull())
+  // Songs are serialized as they are read from the database, a large library would
+  // otherwise be held as one CVariant per song until the whole response is written
+  std::string songs;
+  CJSONStreamWriter songWriter(songs);
+  songWriter.StartArray();
+  bool hasSongs = false;
+
+  const auto writeSong = [&](CVariant& song)
   {
-    bool bFetchArt = fields.contains("art");
-    bool bFetchFanart = fields.contains("fanart");
-    bool bFetchThumb = fields.contains("thumbnail");
-    if (bFetchArt || bFetchFanart || bFetchThumb)
+    hasSongs = true;
+    if (thumbLoader)
     {
-      CThumbLoader* thumbLoader = new CMusicThumbLoader();
-      thumbLoader->OnLoaderStart();
+      CFileItem item;
+      // Only needs song and album id (if we have it) set to get art
+      // Getting art is quicker if "albumid" has been fetched
+      item.GetMusicInfoTag()->SetDatabaseId(song["songid"].asInteger32(), MediaTypeSong);
+      if (song.isMember("albumid"))
+        item.GetMusicInfoTag()->SetAlbumId(song["albumid"].asInteger32());
+      else
+        item.GetMusicInfoTag()->SetAlbumId(-1);
 
-      std::set<std::string> artfields;
-      if (bFetchArt)
-        artfields.insert("art");
-      if (bFetchFanart)
-        artfields.insert("fanart");
-      if (bFetchThumb)
-        artfields.insert("thumbnail");
+      // Could use FillDetails, but it does unnecessary serialization of empty MusiInfoTag
+      // CFileItemPtr itemptr(new CFileItem(item));
+      // FillDetails(item.GetMusicInfoTag(), itemptr, artfields, song, thumbLoader);
+
+      thumbLoader->FillLibraryArt(item);
 
-      for (unsigned int index = 0; index < result["songs"].size(); index++)
+      if (bFetchThumb)
       {
-        CFileItem item;
-        // Only needs song and album id (if we have it) set to get art
-        // Getting art is quicker if "albumid" has been fetched
-        item.GetMusicInfoTag()->SetDatabaseId(result["songs"][index]["songid"].asInteger32(), MediaTypeSong);
-        if (result["songs"][index].isMember("albumid"))
-          item.GetMusicInfoTag()->SetAlbumId(result["songs"][index]["albumid"].asInteger32());
+        if (item.HasArt("thumb"))
+          song["thumbnail"] = IMAGE_FILES::URLFromFile(item.GetArt("thumb"));
         else
-          item.GetMusicInfoTag()->SetAlbumId(-1);
-
-        // Could use FillDetails, but it does unnecessary serialization of empty MusiInfoTag
-        // CFileItemPtr itemptr(new CFileItem(item));
-        // FillDetails(item.GetMusicInfoTag(), itemptr, artfields, result["songs"][index], thumbLoader);
-
-        thumbLoader->FillLibraryArt(item);
-
-        if (bFetchThumb)
-        {
-          if (item.HasArt("thumb"))
-            result["songs"][index]["thumbnail"] = IMAGE_FILES::URLFromFile(item.GetArt("thumb"));
-          else
-            result["songs"][index]["thumbnail"] = "";
-        }
-        if (bFetchFanart)
+          song["thumbnail"] = "";
+      }
+      if (bFetchFanart)
+      {
+        if (item.HasArt("fanart"))
+          song["fanart"] = IMAGE_FILES::URLFromFile(item.GetArt("fanart"));
+        else
+          song["fanart"] = "";
+      }
+      if (bFetchArt)
+      {
+        const KODI::ART::Artwork& artMap = item.GetArt();
+        CVariant artObj(CVariant::VariantTypeObject);
+        for (const auto& artIt : artMap)
         {
-          if (item.HasArt("fanart"))
-            result["songs"][index]["fanart"] = IMAGE_FILES::URLFromFile(item.GetArt("fanart"));
-          else
-            result["songs"][index]["fanart"] = "";
-        }
-        if (bFetchArt)
-        {
-          const KODI::ART::Artwork& artMap = item.GetArt();
-          CVariant artObj(CVariant::VariantTypeObject);
-          for (const auto& artIt : artMap)
-          {
-            if (!artIt.second.empty())
-              artObj[artIt.first] = IMAGE_FILES::URLFromFile(artIt.second);
-          }
-          result["songs"][index]["art"] = artObj;
+          if (!artIt.second.empty())
+            artObj[artIt.first] = IMAGE_FILES::URLFromFile(artIt.second);
         }
+        song["art"] = artObj;
       }
-
-      delete thumbLoader;
     }
-  }
+    songWriter.Value(song);
+  };
 
+  if (!musicdatabase.GetSongsByWhereJSON(fields, musicUrl.ToString(), writeSong, total, sorting))
+    return InternalError;
+
+  songWriter.EndArray();
+
+  CVariant limits;
   int start, end;
-  HandleLimits(parameterObject, result, total, start, end);
+  HandleLimits(parameterObject, limits, total, start, end);
+
+  std::string output;
+  CJSONStreamWriter writer(output);
+  writer.StartObject();
+  writer.Key("limits");
+  writer.Value(limits["limits"]);
+  if (hasSongs)
+  {
+    writer.Key("songs");
+    writer.RawValue(songs);
+  }
+  writer.EndObject();
 
-  return OK;
+  result = std::move(output);
+  return OKSerialized;
 }
 
 JSONRPC_STATUS CAudioLibrary::GetSongDetails(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
@@ -30,6 +30,7 @@
 #include "pvr/timers/PVRTimers.h"
 #include "utils/Artwork.h"
 #include "utils/FileUtils.h"
+#include "utils/JSONStreamWriter.h"
 #include "utils/ISerializable.h"
 #include "utils/SortUtils.h"
 #include "utils/URIUtils.h"
@@ -334,6 +335,76 @@ void CFileItemHandler::HandleFileItemList(const char *ID, bool allowFile, const
   delete thumbLoader;
 }
 
+std::string CFileItemHandler::SerializeFileItemList(const char* ID,
+                                                   bool allowFile,
+                                                   const char* resultname,
+                                                   CFileItemList& items,
+                                                   const CVariant& parameterObject,
+                                                   int size,
+                                                   bool sortLimit /* = true */)
+{
+  CVariant limits;
+  int start, end;
+  HandleLimits(parameterObject, limits, size, start, end);
+
+  if (sortLimit)
+    Sort(items, parameterObject);
+  else
+  {
+    start = 0;
+    end = items.Size();
+  }
+
+  std::unique_ptr<CThumbLoader> thumbLoader;
+  if (end - start > 0)
+  {
+    if (items.Get(start)->HasVideoInfoTag())
+      thumbLoader = std::make_unique<CVideoThumbLoader>();
+    else if (items.Get(start)->HasMusicInfoTag())
+      thumbLoader = std::make_unique<CMusicThumbLoader>();
+
+    if (thumbLoader)
+      thumbLoader->OnLoaderStart();
+  }
+
+  std::set<std::string> fields;
+  if (parameterObject.isMember("properties") && parameterObject["properties"].isArray())
+  {
+    for (CVariant::const_iterator_array field = parameterObject["properties"].begin_array();
+         field != parameterObject["properties"].end_array(); ++field)
+      fields.insert(field->asString());
+  }
+
+  std::string output;
+  CJSONStreamWriter writer(output);
+  const auto writeItems = [&]()
+  {
+    writer.Key(resultname);
+    writer.StartArray();
+    for (int i = start; i < end; i++)
+    {
+      // only one item is held as a CVariant at a time
+      CVariant object;
+      HandleFileItem(ID, allowFile, resultname, items.Get(i), parameterObject, fields, object,
+                     false, thumbLoader.get());
+      writer.Value(object[resultname]);
+    }
+    writer.EndArray();
+  };
+
+  // members in the same order as a serialized CVariant
+  writer.StartObject();
+  if (strcmp(resultname, "limits") < 0)
+    writeItems();
+  writer.Key("limits");
+  writer.Value(limits["limits"]);
+  if (strcmp(resultname, "limits") > 0)
+    writeItems();
+  writer.EndObject();
+
+  return output;
+}
+
 void CFileItemHandler::HandleFileItem(const char* ID,
                                       bool allowFile,
                                       const char* resultname,
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <set>
+#include <string>
 
 class CFileItem;
 class CFileItemList;
@@ -32,6 +33,18 @@ namespace JSONRPC
                             CThumbLoader* thumbLoader = nullptr);
     static void HandleFileItemList(const char *ID, bool allowFile, const char *resultname, CFileItemList &items, const CVariant &parameterObject, CVariant &result, bool sortLimit = true);
     static void HandleFileItemList(const char *ID, bool allowFile, const char *resultname, CFileItemList &items, const CVariant &parameterObject, CVariant &result, int size, bool sortLimit = true);
+    /*!
+     \brief Same as HandleFileItemList() but returns the result object as JSON text.
+     Only one item at a time is converted to a CVariant, so this is preferable for large lists.
+     The returned string is meant to be passed on as the result of an OKSerialized method call.
+     */
+    static std::string SerializeFileItemList(const char* ID,
+                                             bool allowFile,
+                                             const char* resultname,
+                                             CFileItemList& items,
+                                             const CVariant& parameterObject,
+                                             int size,
+                                             bool sortLimit = true);
     static void HandleFileItem(const char* ID,
                                bool allowFile,
                                const char* resultname,
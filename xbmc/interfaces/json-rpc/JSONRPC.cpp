@@ -27,6 +27,7 @@
 #include "playlists/SmartPlayList.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/JSONStreamWriter.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -241,11 +242,17 @@ JSONRPC_STATUS CJSONRPC::NotifyAll(const std::string &method, ITransportLayer *t
 
 std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client)
 {
-  CVariant inputroot, outputroot, result;
+  CVariant inputroot;
   bool hasResponse = false;
 
   CLog::Log(LOGDEBUG, LOGJSONRPC, "JSONRPC: Incoming request: {}", inputString);
 
+  // the response is serialized as it is built, results of large library requests never
+  // exist as a CVariant tree in addition to their JSON text
+  std::string str;
+  CJSONStreamWriter writer(
+      str, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
+
   if (CJSONVariantParser::Parse(inputString, inputroot) && !inputroot.isNull())
   {
     if (inputroot.isArray())
@@ -253,41 +260,38 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
       if (inputroot.empty())
       {
         CLog::Log(LOGERROR, "JSONRPC: Empty batch call");
-        BuildResponse(inputroot, InvalidRequest, CVariant(), outputroot);
+        WriteResponse(writer, inputroot, InvalidRequest, CVariant());
         hasResponse = true;
       }
       else
       {
+        writer.StartArray();
         for (CVariant::const_iterator_array itr = inputroot.begin_array();
              itr != inputroot.end_array(); ++itr)
         {
-          CVariant response;
-          if (HandleMethodCall(*itr, response, transport, client))
-          {
-            outputroot.append(response);
+          if (HandleMethodCall(*itr, writer, transport, client))
             hasResponse = true;
-          }
         }
+        writer.EndArray();
       }
     }
     else
-      hasResponse = HandleMethodCall(inputroot, outputroot, transport, client);
+      hasResponse = HandleMethodCall(inputroot, writer, transport, client);
   }
   else
   {
     CLog::Log(LOGERROR, "JSONRPC: Failed to parse '{}'", inputString);
-    BuildResponse(inputroot, ParseError, CVariant(), outputroot);
+    WriteResponse(writer, inputroot, ParseError, CVariant());
     hasResponse = true;
   }
 
-  std::string str;
-  if (hasResponse)
-    CJSONVariantWriter::Write(outputroot, str, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
+  if (!hasResponse)
+    str.clear();
 
   return str;
 }
 
-bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client)
+bool CJSONRPC::HandleMethodCall(const CVariant& request, CJSONStreamWriter& writer, ITransportLayer *transport, IClient *client)
 {
   JSONRPC_STATUS errorCode = OK;
   CVariant result;
@@ -317,9 +321,32 @@ bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITr
     errorCode = InvalidRequest;
   }
 
-  BuildResponse(request, errorCode, result, response);
+  if (isNotification)
+    return false;
+
+  WriteResponse(writer, request, errorCode, result);
+  return true;
+}
+
+void CJSONRPC::WriteResponse(CJSONStreamWriter& writer, const CVariant& request, JSONRPC_STATUS code, const CVariant& result)
+{
+  if (code != OKSerialized)
+  {
+    CVariant response;
+    BuildResponse(request, code, result, response);
+    writer.Value(response);
+    return;
+  }
 
-  return !isNotification;
+  // same layout as BuildResponse() with the members in the order of CVariant's map
+  writer.StartObject();
+  writer.Key("id");
+  writer.Value(request.isMember("id") ? request["id"] : CVariant());
+  writer.Key("jsonrpc");
+  writer.String("2.0");
+  writer.Key("result");
+  writer.RawValue(result.asString());
+  writer.EndObject();
 }
 
 inline bool CJSONRPC::IsProperJSONRPC(const CVariant& inputroot)
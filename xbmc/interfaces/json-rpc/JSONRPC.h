@@ -16,6 +16,7 @@
 #include <stdio.h>
 #include <string>
 
+class CJSONStreamWriter;
 class CVariant;
 
 namespace JSONRPC
@@ -62,10 +63,11 @@ namespace JSONRPC
     static JSONRPC_STATUS NotifyAll(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
 
   private:
-    static bool HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client);
+    static bool HandleMethodCall(const CVariant& request, CJSONStreamWriter& writer, ITransportLayer *transport, IClient *client);
     static inline bool IsProperJSONRPC(const CVariant& inputroot);
 
     inline static void BuildResponse(const CVariant& request, JSONRPC_STATUS code, const CVariant& result, CVariant& response);
+    static void WriteResponse(CJSONStreamWriter& writer, const CVariant& request, JSONRPC_STATUS code, const CVariant& result);
 
     static bool m_initialized;
   };
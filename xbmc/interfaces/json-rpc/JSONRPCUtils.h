@@ -31,6 +31,8 @@ namespace JSONRPC
   {
     OK = 0,
     ACK = -1,
+    /*! Success, the result is a string holding the already serialized (compact) JSON of the result */
+    OKSerialized = -2,
     InvalidRequest = -32600,
     MethodNotFound = -32601,
     InvalidParams = -32602,
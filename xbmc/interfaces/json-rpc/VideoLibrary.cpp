@@ -81,7 +81,12 @@ JSONRPC_STATUS CVideoLibrary::GetMovies(const std::string &method, ITransportLay
   if (!videodatabase.GetMoviesNav(videoUrl.ToString(), items, genreID, year, -1, -1, -1, -1, setID, -1, sorting, RequiresAdditionalDetails(MediaTypeMovie, parameterObject)))
     return InvalidParams;
 
-  return HandleItems("movieid", "movies", items, parameterObject, result, false);
+  int size = items.Size();
+  if (items.HasProperty("total") && items.GetProperty("total").asInteger() > size)
+    size = static_cast<int>(items.GetProperty("total").asInteger());
+
+  result = SerializeFileItemList("movieid", true, "movies", items, parameterObject, size, false);
+  return OKSerialized;
 }
 
 JSONRPC_STATUS CVideoLibrary::GetMovieDetails(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <mutex>
 #include <stdexcept>
 #include <thread>
@@ -30,7 +31,10 @@ bool CJob::ShouldCancel(unsigned int progress, unsigned int total) const
 class CJobManager::CJobWorker : private CThread
 {
 public:
-  explicit CJobWorker(CJobManager& manager) : CThread("JobWorker"), m_jobManager(manager)
+  CJobWorker(CJobManager& manager, size_t queue)
+    : CThread("JobWorker"),
+      m_jobManager(manager),
+      m_queue(queue)
   {
     Create(true); // start work immediately, and kill ourselves when we're done
   }
@@ -48,7 +52,7 @@ public:
     while (true)
     {
       // request an item from our manager (this call is blocking)
-      CJob* job{m_jobManager.GetNextJob()};
+      CJob* job{m_jobManager.GetNextJob(m_queue)};
       if (!job)
         break;
 
@@ -67,6 +71,7 @@ public:
 
 private:
   CJobManager& m_jobManager;
+  const size_t m_queue;
 };
 
 struct CJobManager::JobFinder
@@ -77,50 +82,65 @@ struct CJobManager::JobFinder
   const CJob* m_job{nullptr};
 };
 
+CJobManager::CJobManager(unsigned int maxWorkers /* = DEFAULT_MAX_WORKERS */)
+  : m_maxWorkers(std::max(maxWorkers, 1u))
+{
+  // one queue per worker that may be busy at the same time, bounded by the available cores
+  const unsigned int queues{
+      std::clamp(std::thread::hardware_concurrency(), 1u, m_maxWorkers)};
+  for (unsigned int i = 0; i < queues; ++i)
+    m_queues.emplace_back(std::make_unique<CWorkQueue>());
+}
+
 bool CJobManager::IsRunning() const
 {
-  std::unique_lock lock(m_section);
   return m_running;
 }
 
 void CJobManager::Restart()
 {
-  std::unique_lock lock(m_section);
-
-  if (m_running)
+  bool running{false};
+  if (!m_running.compare_exchange_strong(running, true))
     throw std::logic_error("CJobManager already running");
-  m_running = true;
 }
 
 void CJobManager::CancelJobs()
 {
-  std::unique_lock lock(m_section);
   m_running = false;
 
-  // clear any pending jobs
-  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED;
-       ++priority)
+  for (const auto& queue : m_queues)
   {
-    std::ranges::for_each(m_jobQueue[priority],
+    std::unique_lock lock(queue->m_section);
+
+    // clear any pending jobs
+    for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED;
+         ++priority)
+    {
+      JobQueue& jobs{queue->m_jobs[priority]};
+      std::ranges::for_each(jobs,
+                            [this, priority](CWorkItem& wi)
+                            {
+                              if (wi.GetCallback())
+                                wi.GetCallback()->OnJobAbort(wi.GetId(), wi.GetJob());
+                              RemoveFromQueuedIndex(wi.GetJob(), CJob::PRIORITY(priority));
+                              wi.FreeJob();
+                            });
+      m_queuedJobs[priority] -= static_cast<unsigned int>(jobs.size());
+      jobs.clear();
+    }
+
+    // cancel any callbacks on jobs still processing
+    std::ranges::for_each(queue->m_processing,
                           [](CWorkItem& wi)
                           {
                             if (wi.GetCallback())
                               wi.GetCallback()->OnJobAbort(wi.GetId(), wi.GetJob());
-                            wi.FreeJob();
+                            wi.Cancel();
                           });
-    m_jobQueue[priority].clear();
   }
 
-  // cancel any callbacks on jobs still processing
-  std::ranges::for_each(m_processing,
-                        [](CWorkItem& wi)
-                        {
-                          if (wi.GetCallback())
-                            wi.GetCallback()->OnJobAbort(wi.GetId(), wi.GetJob());
-                          wi.Cancel();
-                        });
-
   // tell our workers to finish
+  std::unique_lock lock(m_workersSection);
   while (!m_workers.empty())
   {
     lock.unlock();
@@ -130,165 +150,254 @@ void CJobManager::CancelJobs()
   }
 }
 
-unsigned int CJobManager::AddJob(CJob* job, IJobCallback* callback, CJob::PRIORITY priority)
+bool CJobManager::AddToQueuedIndex(const CJob* job, CJob::PRIORITY priority)
 {
-  std::unique_lock lock(m_section);
+  std::unique_lock lock(m_queuedIndexSection);
+  QueuedIndex& index{m_queuedIndex[priority]};
+  const auto [first, last] = index.equal_range(job->GetType());
+  if (std::any_of(first, last, [job](const auto& queued) { return queued.second->Equals(job); }))
+    return false;
 
+  index.emplace(job->GetType(), job);
+  return true;
+}
+
+void CJobManager::RemoveFromQueuedIndex(const CJob* job, CJob::PRIORITY priority)
+{
+  std::unique_lock lock(m_queuedIndexSection);
+  QueuedIndex& index{m_queuedIndex[priority]};
+  const auto [first, last] = index.equal_range(job->GetType());
+  const auto it =
+      std::find_if(first, last, [job](const auto& queued) { return queued.second == job; });
+  if (it != last)
+    index.erase(it);
+}
+
+CJobManager::CWorkQueue* CJobManager::FindProcessing(const CJob* job,
+                                                     std::unique_lock<CCriticalSection>& lock) const
+{
+  for (const auto& queue : m_queues)
+  {
+    std::unique_lock queueLock(queue->m_section);
+    if (std::ranges::any_of(queue->m_processing, JobFinder(job)))
+    {
+      lock = std::move(queueLock);
+      return queue.get();
+    }
+  }
+  return nullptr;
+}
+
+unsigned int CJobManager::AddJob(CJob* job, IJobCallback* callback, CJob::PRIORITY priority)
+{
   // Check if we are not running or have this job already.  In either case, we're done.
-  if (!m_running ||
-      std::ranges::find_if(m_jobQueue[priority], [job](const CWorkItem& wi)
-                           { return wi.GetJob()->Equals(job); }) != m_jobQueue[priority].cend())
+  // Checking and indexing the job is a single step, so equal jobs added concurrently are caught.
+  if (!m_running || !AddToQueuedIndex(job, priority))
   {
     delete job;
     return 0;
   }
 
   // increment the job counter, ensuring 0 (invalid job) is never hit
-  m_jobCounter++;
-  if (m_jobCounter == 0)
-    m_jobCounter++;
+  unsigned int id{++m_jobCounter};
+  if (id == 0)
+    id = ++m_jobCounter;
 
-  // create a work item for this job
-  CWorkItem work(job, m_jobCounter, priority, callback);
-  m_jobQueue[priority].emplace_back(work);
+  // create a work item for this job and hand it to the next queue in line
+  const CWorkItem work(job, id, priority, callback);
+  CWorkQueue& queue{*m_queues[m_nextQueue++ % m_queues.size()]};
+  {
+    std::unique_lock lock(queue.m_section);
+
+    // CancelJobs() drains the queues after resetting m_running, so re-check under the lock
+    if (!m_running)
+    {
+      RemoveFromQueuedIndex(job, priority);
+      delete job;
+      return 0;
+    }
+
+    queue.m_jobs[priority].emplace_back(work);
+    ++m_queuedJobs[priority];
+  }
 
   StartWorkers(priority);
-  return work.GetId();
+  return id;
 }
 
 void CJobManager::CancelJob(unsigned int jobID)
 {
-  std::unique_lock lock(m_section);
+  const auto hasId = [jobID](const auto& wi) { return wi.GetId() == jobID; };
 
-  // check whether we have this job in the queue
-  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED;
-       ++priority)
+  for (const auto& queue : m_queues)
   {
-    const auto i = std::ranges::find_if(m_jobQueue[priority],
-                                        [jobID](const auto& wi) { return wi.GetId() == jobID; });
-    if (i != m_jobQueue[priority].cend())
+    std::unique_lock lock(queue->m_section);
+
+    // check whether we have this job in the queue
+    for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED;
+         ++priority)
+    {
+      JobQueue& jobs{queue->m_jobs[priority]};
+      const auto i = std::ranges::find_if(jobs, hasId);
+      if (i != jobs.cend())
+      {
+        RemoveFromQueuedIndex(i->GetJob(), CJob::PRIORITY(priority));
+        i->FreeJob();
+        jobs.erase(i);
+        --m_queuedJobs[priority];
+        return;
+      }
+    }
+
+    // or if we're processing it. Jobs move to the processing list of the queue they leave under
+    // the same lock, so a job can't be missed in between.
+    const auto it = std::ranges::find_if(queue->m_processing, hasId);
+    if (it != queue->m_processing.cend())
     {
-      i->FreeJob();
-      m_jobQueue[priority].erase(i);
+      it->SetCallback(nullptr); // job is in progress, so only thing to do is to remove callback
       return;
     }
   }
-  // or if we're processing it
-  const auto it =
-      std::ranges::find_if(m_processing, [jobID](const auto& wi) { return wi.GetId() == jobID; });
-  if (it != m_processing.cend())
-    it->SetCallback(nullptr); // job is in progress, so only thing to do is to remove callback
 }
 
 void CJobManager::StartWorkers(CJob::PRIORITY priority)
 {
-  std::unique_lock lock(m_section);
+  std::unique_lock lock(m_workersSection);
 
   // check how many free threads we have
-  if (m_processing.size() >= GetMaxWorkers(priority))
+  const size_t processing{m_processingCount};
+  if (processing >= GetMaxWorkers(priority))
     return;
 
   // do we have any sleeping threads?
-  if (m_processing.size() < m_workers.size())
+  if (processing < m_workers.size())
   {
     m_jobEvent.Set();
     return;
   }
 
   // everyone is busy - we need more workers
-  m_workers.emplace_back(new CJobWorker(*this));
+  m_workers.emplace_back(new CJobWorker(*this, m_nextWorkerQueue++ % m_queues.size()));
 }
 
-CJob* CJobManager::PopJob()
+CJob* CJobManager::PopJob(size_t queue)
 {
-  std::unique_lock lock(m_section);
   for (int priority = CJob::PRIORITY_DEDICATED; priority >= CJob::PRIORITY_LOW_PAUSABLE; --priority)
   {
     // Check whether we're pausing pausable jobs
     if (priority == CJob::PRIORITY_LOW_PAUSABLE && m_pauseJobs)
       continue;
 
-    if (!m_jobQueue[priority].empty() &&
-        m_processing.size() < GetMaxWorkers(CJob::PRIORITY(priority)))
+    if (m_queuedJobs[priority] == 0 ||
+        m_processingCount >= GetMaxWorkers(CJob::PRIORITY(priority)))
+      continue;
+
+    // try our own queue first, then steal from the others
+    for (size_t i = 0; i < m_queues.size(); ++i)
     {
-      // pop the job off the queue
-      const CWorkItem job{m_jobQueue[priority].front()};
-      m_jobQueue[priority].pop_front();
-
-      // add to the processing vector
-      m_processing.emplace_back(job);
-      job.GetJob()->SetProgressCallback(this);
-      return job.GetJob();
+      CJob* job{PopJob(*m_queues[(queue + i) % m_queues.size()], CJob::PRIORITY(priority))};
+      if (job)
+        return job;
     }
   }
   return nullptr;
 }
 
+CJob* CJobManager::PopJob(CWorkQueue& queue, CJob::PRIORITY priority)
+{
+  std::unique_lock lock(queue.m_section);
+  JobQueue& jobs{queue.m_jobs[priority]};
+  if (jobs.empty())
+    return nullptr;
+
+  // take a worker slot, workers of the other queues may be doing the same
+  size_t processing{m_processingCount};
+  do
+  {
+    if (processing >= GetMaxWorkers(priority))
+      return nullptr;
+  } while (!m_processingCount.compare_exchange_weak(processing, processing + 1));
+  ++m_processingJobs[priority];
+
+  // move the job from the queue to the processing list
+  const CWorkItem job{jobs.front()};
+  jobs.pop_front();
+  --m_queuedJobs[priority];
+  RemoveFromQueuedIndex(job.GetJob(), priority);
+  queue.m_processing.emplace_back(job);
+
+  job.GetJob()->SetProgressCallback(this);
+  return job.GetJob();
+}
+
 void CJobManager::PauseJobs()
 {
-  std::unique_lock lock(m_section);
   m_pauseJobs = true;
 }
 
 void CJobManager::UnPauseJobs()
 {
-  std::unique_lock lock(m_section);
   m_pauseJobs = false;
 }
 
 bool CJobManager::IsProcessing(const CJob::PRIORITY& priority) const
 {
-  std::unique_lock lock(m_section);
-
   if (m_pauseJobs && priority == CJob::PRIORITY::PRIORITY_LOW_PAUSABLE)
     return false;
 
-  return std::ranges::any_of(m_processing,
-                             [priority](const auto& wi) { return wi.GetPriority() == priority; });
+  return m_processingJobs[priority] > 0;
 }
 
 int CJobManager::IsProcessing(const std::string& type) const
 {
-  std::unique_lock lock(m_section);
+  const bool pauseJobs{m_pauseJobs};
 
-  return static_cast<int>(std::ranges::count_if(
-      m_processing,
-      [this, &type](const auto& wi)
-      {
-        return (!m_pauseJobs || wi.GetPriority() != CJob::PRIORITY::PRIORITY_LOW_PAUSABLE) &&
-               (std::string(wi.GetJob()->GetType()) == type);
-      }));
+  int count{0};
+  for (const auto& queue : m_queues)
+  {
+    std::unique_lock lock(queue->m_section);
+    count += static_cast<int>(std::ranges::count_if(
+        queue->m_processing,
+        [pauseJobs, &type](const auto& wi)
+        {
+          return (!pauseJobs || wi.GetPriority() != CJob::PRIORITY::PRIORITY_LOW_PAUSABLE) &&
+                 (std::string(wi.GetJob()->GetType()) == type);
+        }));
+  }
+  return count;
 }
 
-CJob* CJobManager::GetNextJob()
+CJob* CJobManager::GetNextJob(size_t queue /* = 0 */)
 {
-  std::unique_lock lock(m_section);
+  queue %= m_queues.size();
   while (m_running)
   {
-    // grab a job off the queue if we have one
-    CJob* job = PopJob();
+    // grab a job off the queues if we have one
+    CJob* job = PopJob(queue);
     if (job)
+    {
+      // pass the baton on to another sleeping worker if there is more work left
+      if (std::ranges::any_of(m_queuedJobs, [](const auto& queued) { return queued > 0; }))
+        m_jobEvent.Set();
       return job;
+    }
     // no jobs are left - sleep for 30 seconds to allow new jobs to come in
-    lock.unlock();
-    bool newJob = m_jobEvent.Wait(30000ms);
-    lock.lock();
-    if (!newJob)
+    if (!m_jobEvent.Wait(30000ms))
       break;
   }
   // ensure no jobs have come in during the period after
-  // timeout and before we held the lock
-  return PopJob();
+  // timeout and before we stopped waiting
+  return PopJob(queue);
 }
 
 bool CJobManager::OnJobProgress(unsigned int progress, unsigned int total, const CJob* job) const
 {
-  std::unique_lock lock(m_section);
-  // find the job in the processing queue, and check whether it's cancelled (no callback)
-  const auto i = std::ranges::find_if(m_processing, JobFinder(job));
-  if (i != m_processing.cend())
+  std::unique_lock<CCriticalSection> lock;
+  const CWorkQueue* queue{FindProcessing(job, lock)};
+  if (queue)
   {
-    CWorkItem item(*i);
+    // check whether the job is cancelled (no callback)
+    CWorkItem item(*std::ranges::find_if(queue->m_processing, JobFinder(job)));
     lock.unlock(); // leave section prior to call
     if (item.GetCallback())
     {
@@ -301,13 +410,12 @@ bool CJobManager::OnJobProgress(unsigned int progress, unsigned int total, const
 
 void CJobManager::OnJobComplete(bool success, CJob* job)
 {
-  std::unique_lock lock(m_section);
-  // remove the job from the processing queue
-  const auto i = std::ranges::find_if(m_processing, JobFinder(job));
-  if (i != m_processing.cend())
+  std::unique_lock<CCriticalSection> lock;
+  CWorkQueue* queue{FindProcessing(job, lock)};
+  if (queue)
   {
     // tell any listeners we're done with the job, then delete it
-    CWorkItem item(*i);
+    CWorkItem item(*std::ranges::find_if(queue->m_processing, JobFinder(job)));
     lock.unlock();
     try
     {
@@ -318,10 +426,15 @@ void CJobManager::OnJobComplete(bool success, CJob* job)
     {
       CLog::LogF(LOGERROR, "Error processing job {}", item.GetJob()->GetType());
     }
+    // remove the job from the processing list, it never moves to another queue
     lock.lock();
-    const auto j = std::ranges::find_if(m_processing, JobFinder(job));
-    if (j != m_processing.cend())
-      m_processing.erase(j);
+    const auto j = std::ranges::find_if(queue->m_processing, JobFinder(job));
+    if (j != queue->m_processing.cend())
+    {
+      queue->m_processing.erase(j);
+      --m_processingJobs[item.GetPriority()];
+      --m_processingCount;
+    }
     lock.unlock();
     item.FreeJob();
   }
@@ -329,17 +442,19 @@ void CJobManager::OnJobComplete(bool success, CJob* job)
 
 void CJobManager::RemoveWorker(const CJobWorker* worker)
 {
-  std::unique_lock lock(m_section);
+  std::unique_lock lock(m_workersSection);
   // remove our worker
   const auto i = std::ranges::find(m_workers, worker);
   if (i != m_workers.cend())
     m_workers.erase(i); // workers auto-delete
 }
 
-unsigned int CJobManager::GetMaxWorkers(CJob::PRIORITY priority)
+unsigned int CJobManager::GetMaxWorkers(CJob::PRIORITY priority) const
 {
-  static const unsigned int max_workers = 5;
   if (priority == CJob::PRIORITY_DEDICATED)
     return 10000; // A large number..
-  return max_workers - (CJob::PRIORITY_HIGH - priority);
+
+  // one worker less per priority level below PRIORITY_HIGH, but always at least one
+  const auto reserved{static_cast<unsigned int>(CJob::PRIORITY_HIGH - priority)};
+  return m_maxWorkers > reserved ? m_maxWorkers - reserved : 1;
 }
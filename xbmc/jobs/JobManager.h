@@ -14,8 +14,12 @@
 #include "threads/Event.h"
 
 #include <array>
-#include <queue>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class IJobCallback;
@@ -29,12 +33,24 @@ class IJobCallback;
  on priority levels.  Lower priority jobs are executed only if there are sufficient
  spare worker threads free to allow for higher priority jobs that may arise.
 
+ Queued jobs are spread over several independently locked queues. Each worker takes
+ jobs from its own queue first and steals from the other queues when it runs dry, so
+ producers and workers rarely contend on the same lock. A job that is being processed
+ stays with the queue it was taken from.
+
  \sa CJob and IJobCallback
  */
 class CJobManager final
 {
 public:
-  CJobManager() = default;
+  static constexpr unsigned int DEFAULT_MAX_WORKERS = 5;
+
+  /*!
+   \brief Create a job manager.
+   \param maxWorkers the maximum number of workers processing PRIORITY_HIGH jobs. Each lower
+   priority level may use one worker less. PRIORITY_DEDICATED jobs are not limited.
+   */
+  explicit CJobManager(unsigned int maxWorkers = DEFAULT_MAX_WORKERS);
 
   /*!
    \brief Returns whether the job manager is currently running.
@@ -155,9 +171,11 @@ public:
 
   /*!
    \brief Get a new job to process. Blocks until a new job is available, or a timeout has occurred.
+   \param queue the index of the calling worker's own queue, which is checked before stealing
+   jobs from the other queues.
    \sa CJob
    */
-  CJob* GetNextJob();
+  CJob* GetNextJob(size_t queue = 0);
 
 private:
   CJobManager(const CJobManager&) = delete;
@@ -197,27 +215,75 @@ private:
     CJob::PRIORITY m_priority{CJob::PRIORITY::PRIORITY_LOW};
   };
 
-  /*! \brief Pop a job off the job queue and add to the processing queue ready to process
+  using JobQueue = std::deque<CWorkItem>;
+  using Processing = std::vector<CWorkItem>;
+  using Workers = std::vector<CJobWorker*>;
+
+  /*! \brief A set of per-priority job queues with its own lock. Each worker is attached to one
+   of these, and new jobs are distributed round-robin over all of them. Jobs taken from the
+   queues are kept in m_processing until they complete.
+   */
+  struct CWorkQueue
+  {
+    std::array<JobQueue, CJob::PRIORITY_DEDICATED + 1> m_jobs;
+    Processing m_processing;
+    CCriticalSection m_section;
+  };
+
+  /*! \brief Queued jobs by type, to find equal jobs without locking every queue. Jobs of
+   different types are never equal.
+   */
+  using QueuedIndex = std::unordered_multimap<std::string, const CJob*>;
+
+  /*! \brief Pop a job off the job queues and add to the processing queue ready to process.
+   The given queue is tried first, the other queues are stolen from afterwards. Higher priority
+   jobs are always taken before lower priority ones, regardless of the queue they are in.
+   \param queue the index of the queue to try first
    \return the job to process, nullptr if no jobs are available
    */
-  CJob* PopJob();
+  CJob* PopJob(size_t queue);
+
+  /*! \brief Pop the oldest job with the given priority off a queue, if the worker limit for that
+   priority allows another job to be processed.
+   \return the job to process, nullptr if the queue is empty or the worker limit was reached
+   */
+  CJob* PopJob(CWorkQueue& queue, CJob::PRIORITY priority);
+
+  /*! \brief Add a job about to be queued to the queued index, unless an equal job with the
+   given priority is queued already.
+   \return true if the job was added, false if it is a duplicate
+   \sa CJob::Equals()
+   */
+  bool AddToQueuedIndex(const CJob* job, CJob::PRIORITY priority);
+  void RemoveFromQueuedIndex(const CJob* job, CJob::PRIORITY priority);
+
+  /*! \brief Find the queue that holds the given job in its processing list.
+   \param lock receives the lock of the returned queue
+   \return the queue, nullptr if the job isn't processing
+   */
+  CWorkQueue* FindProcessing(const CJob* job, std::unique_lock<CCriticalSection>& lock) const;
 
   void StartWorkers(CJob::PRIORITY priority);
   void RemoveWorker(const CJobWorker* worker);
-  static unsigned int GetMaxWorkers(CJob::PRIORITY priority);
+  unsigned int GetMaxWorkers(CJob::PRIORITY priority) const;
 
-  unsigned int m_jobCounter{0};
+  const unsigned int m_maxWorkers;
+  std::atomic<unsigned int> m_jobCounter{0};
 
-  using JobQueue = std::deque<CWorkItem>;
-  using Processing = std::vector<CWorkItem>;
-  using Workers = std::vector<CJobWorker*>;
+  std::vector<std::unique_ptr<CWorkQueue>> m_queues;
+  std::atomic<size_t> m_nextQueue{0};
+  std::array<std::atomic<unsigned int>, CJob::PRIORITY_DEDICATED + 1> m_queuedJobs{};
+  std::atomic<bool> m_pauseJobs{false};
+  std::atomic<bool> m_running{true};
 
-  std::array<JobQueue, CJob::PRIORITY_DEDICATED + 1> m_jobQueue;
-  bool m_pauseJobs{false};
-  Processing m_processing;
-  Workers m_workers;
+  std::array<QueuedIndex, CJob::PRIORITY_DEDICATED + 1> m_queuedIndex;
+  CCriticalSection m_queuedIndexSection; // never held while taking a queue lock
+
+  std::atomic<size_t> m_processingCount{0}; // jobs processing from all queues
+  std::array<std::atomic<unsigned int>, CJob::PRIORITY_DEDICATED + 1> m_processingJobs{};
 
-  mutable CCriticalSection m_section;
+  Workers m_workers;
+  size_t m_nextWorkerQueue{0};
+  CCriticalSection m_workersSection;
   CEvent m_jobEvent;
-  bool m_running{true};
 };
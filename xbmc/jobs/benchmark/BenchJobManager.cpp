@@ -0,0 +1,78 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "jobs/JobManager.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+constexpr int JOBS_PER_PRODUCER = 5000;
+
+// Roughly the cost of a small CLambdaJob, e.g. a cache lookup or a state update
+void DoSomeWork()
+{
+  unsigned int value{0};
+  for (unsigned int i = 0; i < 500; ++i)
+    benchmark::DoNotOptimize(value += i);
+}
+} // namespace
+
+/*!
+ \brief Stress the job manager with many small jobs submitted from several threads.
+ Arguments are the number of workers and the number of producer threads. Reports jobs/second.
+ */
+static void BM_JobManager_Throughput(benchmark::State& state)
+{
+  const auto workers = static_cast<unsigned int>(state.range(0));
+  const auto producers = static_cast<int>(state.range(1));
+  const int total = producers * JOBS_PER_PRODUCER;
+
+  for (auto _ : state)
+  {
+    CJobManager jobManager(workers);
+    std::atomic<int> finished{0};
+    CEvent allFinished;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+      threads.emplace_back(
+          [&]()
+          {
+            for (int i = 0; i < JOBS_PER_PRODUCER; ++i)
+            {
+              jobManager.Submit(
+                  [&]()
+                  {
+                    DoSomeWork();
+                    if (++finished == total)
+                      allFinished.Set();
+                  },
+                  CJob::PRIORITY_HIGH);
+            }
+          });
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    allFinished.Wait();
+    jobManager.CancelJobs();
+  }
+  state.SetItemsProcessed(state.iterations() * total);
+}
+BENCHMARK(BM_JobManager_Throughput)
+    ->ArgNames({"workers", "producers"})
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {1, 4}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -3071,8 +3071,8 @@ int CMusicDatabase::AddPath(const std::string& strPath1)
     if (it != m_pathCache.end())
       return it->second;
 
-    strSQL = PrepareSQL("SELECT * FROM path WHERE strPath='%s'", strPath.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "SELECT * FROM path WHERE strPath=?";
+    m_pDS->query(strSQL, {dbiplus::field_value(strPath.c_str())});
     if (m_pDS->num_rows() == 0)
     {
       m_pDS->close();
@@ -6473,7 +6473,49 @@ bool CMusicDatabase::GetSongsByWhere(
                                     : "songview.*") +
              strSQLExtra;
 
+    int count = 0;
+    const auto addSong = [&](const dbiplus::sql_record* record)
+    {
+      try
+      {
+        auto item{std::make_shared<CFileItem>()};
+        GetFileItemFromDataset(record, item.get(), musicUrl);
+        //! @todo remove hack to use program count for sorting by database returned order
+        count++;
+        item->SetProgramCount(count);
+        items.Add(std::move(item));
+        return true;
+      }
+      catch (...)
+      {
+        m_pDS->close();
+        CLog::LogF(LOGERROR, "out of memory loading query: {}", filter.where);
+        return false;
+      }
+    };
+
     CLog::LogF(LOGDEBUG, "query = {}", strSQL);
+
+    if (sorting.sortBy == SortByNone)
+    {
+      // rows are used in database order, create the items while the rows are fetched
+      if (!m_pDS->query_stream(strSQL))
+        return false;
+
+      for (; !m_pDS->eof(); m_pDS->next())
+      {
+        if (!addSong(m_pDS->get_sql_record()))
+          return !items.IsEmpty();
+      }
+
+      // store the total value of items as a property
+      if (m_pDS->num_rows() > 0)
+        items.SetProperty("total", std::max(total, m_pDS->num_rows()));
+
+      m_pDS->close();
+      return true;
+    }
+
     // run query
     if (!m_pDS->query(strSQL))
       return false;
@@ -6498,27 +6540,11 @@ bool CMusicDatabase::GetSongsByWhere(
     // get data from returned rows
     items.Reserve(results.size());
     const dbiplus::query_data& data = m_pDS->get_result_set().records;
-    int count = 0;
     for (const auto& i : results)
     {
       const auto targetRow = static_cast<unsigned int>(i.at(FieldRow).asInteger());
-      const dbiplus::sql_record* const record = data.at(targetRow);
-
-      try
-      {
-        auto item{std::make_shared<CFileItem>()};
-        GetFileItemFromDataset(record, item.get(), musicUrl);
-        //! @todo remove hack to use program count for sorting by database returned order
-        count++;
-        item->SetProgramCount(count);
-        items.Add(std::move(item));
-      }
-      catch (...)
-      {
-        m_pDS->close();
-        CLog::LogF(LOGERROR, "out of memory loading query: {}", filter.where);
+      if (!addSong(data.at(targetRow)))
         return !items.IsEmpty();
-      }
     }
 
     // cleanup
@@ -7016,16 +7042,16 @@ bool CMusicDatabase::GetArtistsByWhereJSON(
     // run query
     auto start = std::chrono::steady_clock::now();
 
-    if (!m_pDS->query(strSQL))
+    // rows are grouped by item and only walked forward, fetch them as they are processed
+    if (!m_pDS->query_stream(strSQL))
       return false;
 
     auto end = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
-    CLog::LogF(LOGDEBUG, "query took {} ms", duration.count());
+    CLog::LogF(LOGDEBUG, "query took {} ms to the first row", duration.count());
 
-    int iRowsFound = m_pDS->num_rows();
-    if (iRowsFound <= 0)
+    if (m_pDS->eof())
     {
       m_pDS->close();
       return true;
@@ -7566,16 +7592,16 @@ bool CMusicDatabase::GetAlbumsByWhereJSON(
     // run query
     auto start = std::chrono::steady_clock::now();
 
-    if (!m_pDS->query(strSQL))
+    // rows are grouped by item and only walked forward, fetch them as they are processed
+    if (!m_pDS->query_stream(strSQL))
       return false;
 
     auto end = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
-    CLog::LogF(LOGDEBUG, "query took {} ms", duration.count());
+    CLog::LogF(LOGDEBUG, "query took {} ms to the first row", duration.count());
 
-    int iRowsFound = m_pDS->num_rows();
-    if (iRowsFound <= 0)
+    if (m_pDS->eof())
     {
       m_pDS->close();
       return true;
@@ -7800,7 +7826,7 @@ const std::array<TranslateJSONField, 54> JSONtoDBSong = {{
 bool CMusicDatabase::GetSongsByWhereJSON(
     const std::set<std::string, std::less<>>& fields,
     const std::string& baseDir,
-    CVariant& result,
+    const std::function<void(CVariant& song)>& onSong,
     int& total,
     const SortDescription& sortDescription /* = SortDescription() */)
 {
@@ -8150,16 +8176,16 @@ bool CMusicDatabase::GetSongsByWhereJSON(
     // Run query
     auto start = std::chrono::steady_clock::now();
 
-    if (!m_pDS->query(strSQL))
+    // rows are grouped by item and only walked forward, fetch them as they are processed
+    if (!m_pDS->query_stream(strSQL))
       return false;
 
     auto end = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
-    CLog::LogF(LOGDEBUG, "query took {} ms", duration.count());
+    CLog::LogF(LOGDEBUG, "query took {} ms to the first row", duration.count());
 
-    int iRowsFound = m_pDS->num_rows();
-    if (iRowsFound <= 0)
+    if (m_pDS->eof())
     {
       m_pDS->close();
       return true;
@@ -8174,7 +8200,11 @@ bool CMusicDatabase::GetSongsByWhereJSON(
     bool bSongArtistDone(false);
     bool bHaveSong(false);
     CVariant songObj;
-    result["songs"].reserve(resultcount);
+    // Ensure random order of output when results set is sorted to process multi-value joins
+    const bool shuffle = sortDescription.sortBy == SortByRandom && joinLayout.HasFilterFields();
+    std::vector<CVariant> shuffled;
+    if (shuffle)
+      shuffled.reserve(resultcount);
     while (!m_pDS->eof() || bHaveSong)
     {
       const dbiplus::sql_record* const record = m_pDS->get_sql_record();
@@ -8213,7 +8243,10 @@ bool CMusicDatabase::GetSongsByWhereJSON(
                 songObj[displayXXX] = "";
             }
           }
-          result["songs"].append(songObj);
+          if (shuffle)
+            shuffled.emplace_back(std::move(songObj));
+          else
+            onSong(songObj);
           bHaveSong = false;
           songObj.clear();
         }
@@ -8373,9 +8406,12 @@ bool CMusicDatabase::GetSongsByWhereJSON(
     }
     m_pDS->close(); // cleanup recordset data
 
-    // Ensure random order of output when results set is sorted to process multi-value joins
-    if (sortDescription.sortBy == SortByRandom && joinLayout.HasFilterFields())
-      KODI::UTILS::RandomShuffle(result["songs"].begin_array(), result["songs"].end_array());
+    if (shuffle)
+    {
+      KODI::UTILS::RandomShuffle(shuffled.begin(), shuffled.end());
+      for (auto& song : shuffled)
+        onSong(song);
+    }
 
     return true;
   }
@@ -11293,8 +11329,7 @@ bool CMusicDatabase::GetPathHash(const std::string& path, std::string& hash)
     if (nullptr == m_pDS)
       return false;
 
-    std::string strSQL = PrepareSQL("select strHash from path where strPath='%s'", path.c_str());
-    m_pDS->query(strSQL);
+    m_pDS->query("select strHash from path where strPath=?", {dbiplus::field_value(path.c_str())});
     if (m_pDS->num_rows() == 0)
       return false;
     hash = m_pDS->fv("strHash").get_asString();
@@ -13097,9 +13132,8 @@ bool CMusicDatabase::GetArtForItem(int mediaId,
     if (nullptr == m_pDS2)
       return false; // using dataset 2 as we're likely called in loops on dataset 1
 
-    std::string sql = PrepareSQL("SELECT type,url FROM art WHERE media_id=%i AND media_type='%s'",
-                                 mediaId, mediaType.c_str());
-    m_pDS2->query(sql);
+    m_pDS2->query("SELECT type,url FROM art WHERE media_id=? AND media_type=?",
+                  {dbiplus::field_value(mediaId), dbiplus::field_value(mediaType.c_str())});
     while (!m_pDS2->eof())
     {
       art.try_emplace(m_pDS2->fv(0).get_asString(), m_pDS2->fv(1).get_asString());
@@ -22,6 +22,7 @@
 #include "utils/SortUtils.h"
 
 #include <cctype>
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
@@ -661,9 +662,13 @@ public:
                             CVariant& result,
                             int& total,
                             const SortDescription& sortDescription = SortDescription());
+  /*!
+   \brief Fetch songs for JSON-RPC without collecting them in one CVariant
+   \param onSong called with each song object in result order, the object may be modified
+   */
   bool GetSongsByWhereJSON(const std::set<std::string, std::less<>>& fields,
                            const std::string& baseDir,
-                           CVariant& result,
+                           const std::function<void(CVariant& song)>& onSong,
                            int& total,
                            const SortDescription& sortDescription = SortDescription());
 
@@ -58,6 +58,8 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <string_view>
 #include <utility>
 
@@ -574,11 +576,9 @@ CInfoScanner::InfoRet CMusicInfoScanner::ScanTags(const CFileItemList& items,
 {
   std::vector<std::string> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
 
+  std::vector<CFileItemPtr> songs;
   for (int i = 0; i < items.Size(); ++i)
   {
-    if (m_bStop)
-      return InfoRet::CANCELLED;
-
     CFileItemPtr pItem = items[i];
 
     if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
@@ -588,15 +588,20 @@ CInfoScanner::InfoRet CMusicInfoScanner::ScanTags(const CFileItemList& items,
         MUSIC::IsLyrics(*pItem))
       continue;
 
+    songs.emplace_back(pItem);
+  }
+
+  if (!LoadTags(songs))
+    return InfoRet::CANCELLED;
+
+  for (const CFileItemPtr& pItem : songs)
+  {
+    if (m_bStop)
+      return InfoRet::CANCELLED;
+
     m_currentItem++;
 
-    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
-    {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (nullptr != pLoader)
-        pLoader->Load(pItem->GetPath(), tag);
-    }
+    const CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
 
     if (m_handle && m_itemCount>0)
       m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
@@ -620,6 +625,55 @@ CInfoScanner::InfoRet CMusicInfoScanner::ScanTags(const CFileItemList& items,
   return InfoRet::ADDED;
 }
 
+bool CMusicInfoScanner::LoadTags(const std::vector<CFileItemPtr>& songs)
+{
+  const auto loadTag = [](CFileItem& item)
+  {
+    CMusicInfoTag& tag = *item.GetMusicInfoTag();
+    if (!tag.Loaded())
+    {
+      std::unique_ptr<IMusicInfoTagLoader> pLoader(CMusicInfoTagLoaderFactory::CreateLoader(item));
+      if (nullptr != pLoader)
+        pLoader->Load(item.GetPath(), tag);
+    }
+  };
+
+  const size_t threads = std::min<size_t>(
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_musicLibraryTagReaderThreads,
+      songs.size());
+  if (threads <= 1)
+  {
+    for (const CFileItemPtr& song : songs)
+    {
+      if (m_bStop)
+        return false;
+
+      loadTag(*song);
+    }
+    return !m_bStop;
+  }
+
+  // tags are read over the network most of the time, so overlap the round trips
+  std::atomic<size_t> next{0};
+  const auto worker = [&]()
+  {
+    for (size_t i = next++; i < songs.size() && !m_bStop; i = next++)
+      loadTag(*songs[i]);
+  };
+
+  std::vector<std::future<void>> workers;
+  workers.reserve(threads - 1);
+  for (size_t i = 1; i < threads; ++i)
+    workers.emplace_back(std::async(std::launch::async, worker));
+
+  worker();
+
+  for (auto& future : workers)
+    future.wait();
+
+  return !m_bStop;
+}
+
 static bool SortSongsByTrack(const CSong& song, const CSong& song2)
 {
   return song.iTrack < song2.iTrack;
@@ -253,6 +253,14 @@ protected:
    \param scannedItems [in] list to populate with the scannedItems
    */
   InfoRet ScanTags(const CFileItemList& items, CFileItemList& scannedItems);
+
+  /*! \brief Read the tags (and embedded art info) of the given songs
+   Uses up to m_musicLibraryTagReaderThreads threads, each song is handled by exactly one
+   of them so the items can be processed in their original order afterwards.
+   \param songs [in,out] songs to read the tags of, tags already loaded are left alone
+   \return false if the scan was stopped before all tags were read
+   */
+  bool LoadTags(const std::vector<std::shared_ptr<CFileItem>>& songs);
   int GetPathHash(const CFileItemList &items, std::string &hash);
 
   void Run() override;
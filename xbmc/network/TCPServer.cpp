@@ -18,6 +18,9 @@
 #include "utils/log.h"
 #include "websocket/WebSocketManager.h"
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,6 +29,16 @@
 #include <memory.h>
 #include <netinet/in.h>
 
+#if !defined(TARGET_WINDOWS)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+#define HAS_EPOLL
+#include <sys/epoll.h>
+#endif
+
 using namespace std::chrono_literals;
 
 #if defined(TARGET_WINDOWS) || defined(HAVE_LIBBLUETOOTH)
@@ -58,8 +71,57 @@ using namespace JSONRPC;
 namespace
 {
 constexpr size_t maxBufferLength = 64 * 1024;
+// output queued for a client which doesn't read it, beyond that the client is disconnected
+constexpr size_t maxSendBufferLength = 1024 * 1024;
+
+#ifdef HAS_EPOLL
+constexpr int maxEvents = 64;
+#endif
+
+bool SetNonBlocking(SOCKET socket)
+{
+#if defined(TARGET_WINDOWS)
+  u_long nonblocking = 1;
+  return ioctlsocket(socket, FIONBIO, &nonblocking) == 0;
+#else
+  return fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK) == 0;
+#endif
+}
+
+bool WouldBlock()
+{
+#if defined(TARGET_WINDOWS)
+  return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+  return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
 }
 
+// a call interrupted by a signal has to be repeated, edge-triggered epoll won't report it again
+bool Interrupted()
+{
+#if defined(TARGET_WINDOWS)
+  return WSAGetLastError() == WSAEINTR;
+#else
+  return errno == EINTR;
+#endif
+}
+
+// returns the number of bytes sent, which is 0 if the socket's buffer is full, or -1 on error
+int SendNonBlocking(SOCKET socket, const char* data, size_t size)
+{
+  while (true)
+  {
+    const int sent = static_cast<int>(send(socket, data, size, 0));
+    if (sent >= 0)
+      return sent;
+
+    if (!Interrupted())
+      return WouldBlock() ? 0 : -1;
+  }
+}
+} // namespace
+
 CTCPServer *CTCPServer::ServerInstance = NULL;
 
 bool CTCPServer::StartServer(int port, bool nonlocal)
@@ -110,10 +172,55 @@ void CTCPServer::Process()
 
   while (!m_bStop)
   {
+#ifdef HAS_EPOLL
+    epoll_event events[maxEvents];
+    int res = epoll_wait(m_epollFd, events, maxEvents, 1000);
+    if (res < 0)
+    {
+      if (errno == EINTR)
+        continue;
+
+      CLog::Log(LOGERROR, "JSONRPC Server: epoll_wait failed: {}", errno);
+      CThread::Sleep(1000ms);
+      Initialize();
+      continue;
+    }
+
+    for (int e = 0; e < res; e++)
+    {
+      const SOCKET socket = events[e].data.fd;
+      if (std::find(m_servers.begin(), m_servers.end(), socket) != m_servers.end())
+      {
+        // on failure the servers have been re-initialized and the remaining events are stale
+        if (!AcceptConnection(socket))
+          break;
+        continue;
+      }
+
+      // the connection may have been closed while handling an earlier event
+      auto connection = std::find_if(m_connections.begin(), m_connections.end(),
+                                     [socket](const CTCPClient* client)
+                                     { return client->m_socket == socket; });
+      if (connection == m_connections.end())
+        continue;
+
+      const unsigned int index = connection - m_connections.begin();
+      bool close = (events[e].events & EPOLLERR) != 0;
+      if (!close && (events[e].events & EPOLLOUT))
+        close = !m_connections[index]->Flush();
+      if (!close && (events[e].events & (EPOLLIN | EPOLLHUP)))
+        close = !ReadFromConnection(index);
+
+      if (close)
+        CloseConnection(index);
+    }
+#else
     SOCKET          max_fd = 0;
     fd_set          rfds;
+    fd_set          wfds;
     struct timeval  to     = {1, 0};
     FD_ZERO(&rfds);
+    FD_ZERO(&wfds);
 
     for (auto& it : m_servers)
     {
@@ -125,11 +232,13 @@ void CTCPServer::Process()
     for (unsigned int i = 0; i < m_connections.size(); i++)
     {
       FD_SET(m_connections[i]->m_socket, &rfds);
+      if (m_connections[i]->HasPendingOutput())
+        FD_SET(m_connections[i]->m_socket, &wfds);
       if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
         max_fd = m_connections[i]->m_socket;
     }
 
-    int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
+    int res = select((intptr_t)max_fd+1, &rfds, &wfds, NULL, &to);
     if (res < 0)
     {
       CLog::Log(LOGERROR, "JSONRPC Server: Select failed");
@@ -140,83 +249,134 @@ void CTCPServer::Process()
     {
       for (int i = m_connections.size() - 1; i >= 0; i--)
       {
-        int socket = m_connections[i]->m_socket;
-        if (FD_ISSET(socket, &rfds))
-        {
-          char buffer[RECEIVEBUFFER] = {};
-          int  nread = 0;
-          nread = recv(socket, (char*)&buffer, RECEIVEBUFFER, 0);
-          bool close = false;
-          if (nread > 0)
-          {
-            std::string response;
-            if (m_connections[i]->IsNew())
-            {
-              CWebSocket *websocket = CWebSocketManager::Handle(buffer, nread, response);
-
-              if (!response.empty())
-                m_connections[i]->Send(response.c_str(), response.size());
-
-              if (websocket != NULL)
-              {
-                // Replace the CTCPClient with a CWebSocketClient
-                CWebSocketClient *websocketClient = new CWebSocketClient(websocket, *(m_connections[i]));
-                delete m_connections[i];
-                m_connections.erase(m_connections.begin() + i);
-                m_connections.insert(m_connections.begin() + i, websocketClient);
-              }
-            }
-
-            if (response.empty())
-              m_connections[i]->PushBuffer(this, buffer, nread);
-
-            close = m_connections[i]->Closing();
-          }
-          else
-            close = true;
-
-          if (close)
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
-            m_connections[i]->Disconnect();
-            delete m_connections[i];
-            m_connections.erase(m_connections.begin() + i);
-          }
-        }
+        SOCKET socket = m_connections[i]->m_socket;
+        bool close = false;
+        if (FD_ISSET(socket, &wfds))
+          close = !m_connections[i]->Flush();
+        if (!close && FD_ISSET(socket, &rfds))
+          close = !ReadFromConnection(i);
+
+        if (close)
+          CloseConnection(i);
       }
 
       for (auto& it : m_servers)
       {
         if (FD_ISSET(it, &rfds))
         {
-          CLog::Log(LOGDEBUG, "JSONRPC Server: New connection detected");
-          CTCPClient *newconnection = new CTCPClient();
-          newconnection->m_socket =
-              accept(it, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
-
-          if (newconnection->m_socket == INVALID_SOCKET)
-          {
-            CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: {}", errno);
-            if (EBADF == errno)
-            {
-              CThread::Sleep(1000ms);
-              Initialize();
-              break;
-            }
-          }
-          else
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
-            m_connections.push_back(newconnection);
-          }
+          if (!AcceptConnection(it))
+            break;
         }
       }
     }
+#endif
   }
 
   Deinitialize();
 }
 
+bool CTCPServer::AcceptConnection(SOCKET server)
+{
+  CLog::Log(LOGDEBUG, "JSONRPC Server: New connection detected");
+  CTCPClient *newconnection = new CTCPClient();
+  newconnection->m_socket =
+      accept(server, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
+
+  if (newconnection->m_socket == INVALID_SOCKET)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: {}", errno);
+    delete newconnection;
+    if (EBADF == errno)
+    {
+      CThread::Sleep(1000ms);
+      Initialize();
+      return false;
+    }
+    return true;
+  }
+
+  // responses and announcements are queued instead of blocking on a slow client
+  if (!SetNonBlocking(newconnection->m_socket))
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Unable to make new connection non-blocking");
+    newconnection->Disconnect();
+    delete newconnection;
+    return true;
+  }
+
+#ifdef HAS_EPOLL
+  // edge-triggered so a writable socket is only reported after its buffer ran full
+  epoll_event event = {};
+  event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+  event.data.fd = newconnection->m_socket;
+  if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, newconnection->m_socket, &event) != 0)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Unable to watch new connection: {}", errno);
+    newconnection->Disconnect();
+    delete newconnection;
+    return true;
+  }
+#endif
+
+  CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
+  std::unique_lock lock(m_critSection);
+  m_connections.push_back(newconnection);
+  return true;
+}
+
+bool CTCPServer::ReadFromConnection(unsigned int index)
+{
+  // read everything available, which the edge-triggered epoll relies on
+  while (true)
+  {
+    char buffer[RECEIVEBUFFER] = {};
+    int nread = recv(m_connections[index]->m_socket, (char*)&buffer, RECEIVEBUFFER, 0);
+    if (nread < 0)
+    {
+      if (Interrupted())
+        continue;
+
+      return WouldBlock();
+    }
+    if (nread == 0)
+      return false;
+
+    std::string response;
+    if (m_connections[index]->IsNew())
+    {
+      CWebSocket *websocket = CWebSocketManager::Handle(buffer, nread, response);
+
+      if (!response.empty())
+        m_connections[index]->Send(response.c_str(), response.size());
+
+      if (websocket != NULL)
+      {
+        // Replace the CTCPClient with a CWebSocketClient
+        CWebSocketClient *websocketClient = new CWebSocketClient(websocket, *(m_connections[index]));
+        std::unique_lock lock(m_critSection);
+        delete m_connections[index];
+        m_connections[index] = websocketClient;
+      }
+    }
+
+    if (response.empty())
+      m_connections[index]->PushBuffer(this, buffer, nread);
+
+    if (m_connections[index]->Closing() || m_connections[index]->m_socket == INVALID_SOCKET)
+      return false;
+  }
+}
+
+void CTCPServer::CloseConnection(unsigned int index)
+{
+  CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
+
+  std::unique_lock lock(m_critSection);
+  m_connections[index]->Disconnect();
+  delete m_connections[index];
+  m_connections.erase(m_connections.begin() + index);
+}
+
 bool CTCPServer::PrepareDownload(const char *path, CVariant &details, std::string &protocol)
 {
   return false;
@@ -237,20 +397,30 @@ void CTCPServer::Announce(ANNOUNCEMENT::AnnouncementFlag flag,
                           const std::string& message,
                           const CVariant& data)
 {
+  std::unique_lock lock(m_critSection);
   if (m_connections.empty())
     return;
 
   std::string str = IJSONRPCAnnouncer::AnnouncementToJSONRPC(flag, sender, message, data, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
 
-  for (unsigned int i = 0; i < m_connections.size(); i++)
+  // the notification is framed once for all clients talking the same protocol
+  std::map<int, std::string> framedAnnouncements;
+  for (auto* connection : m_connections)
   {
     {
-      std::unique_lock lock(m_connections[i]->m_critSection);
-      if ((m_connections[i]->GetAnnouncementFlags() & flag) == 0)
+      std::unique_lock clientLock(connection->m_critSection);
+      if ((connection->GetAnnouncementFlags() & flag) == 0)
         continue;
     }
 
-    m_connections[i]->Send(str.c_str(), str.size());
+    auto framed = framedAnnouncements.find(connection->GetFraming());
+    if (framed == framedAnnouncements.end())
+      framed =
+          framedAnnouncements.emplace(connection->GetFraming(), connection->Frame(str)).first;
+
+    // only queues the data, clients which aren't reading don't hold up the others
+    if (!framed->second.empty())
+      connection->CTCPClient::Send(framed->second.c_str(), framed->second.size());
   }
 }
 
@@ -263,6 +433,25 @@ bool CTCPServer::Initialize()
   started |= InitializeBlue();
   started |= InitializeTCP();
 
+#ifdef HAS_EPOLL
+  if (started)
+  {
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    for (const auto& server : m_servers)
+    {
+      epoll_event event = {};
+      event.events = EPOLLIN;
+      event.data.fd = server;
+      if (m_epollFd < 0 || epoll_ctl(m_epollFd, EPOLL_CTL_ADD, server, &event) != 0)
+      {
+        CLog::Log(LOGERROR, "JSONRPC Server: Unable to watch server socket: {}", errno);
+        started = false;
+        break;
+      }
+    }
+  }
+#endif
+
   if (started)
   {
     CServiceBroker::GetAnnouncementManager()->AddAnnouncer(this);
@@ -479,13 +668,22 @@ bool CTCPServer::InitializeTCP()
 
 void CTCPServer::Deinitialize()
 {
-  for (unsigned int i = 0; i < m_connections.size(); i++)
   {
-    m_connections[i]->Disconnect();
-    delete m_connections[i];
+    std::unique_lock lock(m_critSection);
+    for (unsigned int i = 0; i < m_connections.size(); i++)
+    {
+      m_connections[i]->Disconnect();
+      delete m_connections[i];
+    }
+
+    m_connections.clear();
   }
 
-  m_connections.clear();
+#ifdef HAS_EPOLL
+  if (m_epollFd >= 0)
+    close(m_epollFd);
+  m_epollFd = -1;
+#endif
 
   for (unsigned int i = 0; i < m_servers.size(); i++)
     closesocket(m_servers[i]);
@@ -542,12 +740,60 @@ bool CTCPServer::CTCPClient::SetAnnouncementFlags(int flags)
 
 void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
 {
-  unsigned int sent = 0;
-  do
+  std::unique_lock lock(m_critSection);
+  if (m_socket == INVALID_SOCKET)
+    return;
+
+  // anything already queued has to go out first
+  if (m_sendBuffer.empty())
   {
-    std::unique_lock lock(m_critSection);
-    sent += send(m_socket, data + sent, size - sent, 0);
-  } while (sent < size);
+    int sent = SendNonBlocking(m_socket, data, size);
+    if (sent < 0)
+    {
+      // the server notices the broken connection and removes the client
+      shutdown(m_socket, SHUT_RDWR);
+      return;
+    }
+
+    data += sent;
+    size -= sent;
+  }
+
+  if (size == 0)
+    return;
+
+  if (m_sendBuffer.size() + size > maxSendBufferLength)
+  {
+    CLog::Log(LOGINFO, "JSONRPC Server: client send buffer size {} exceeded", maxSendBufferLength);
+    shutdown(m_socket, SHUT_RDWR);
+    return;
+  }
+
+  // sent by the server once the socket becomes writable again
+  m_sendBuffer.append(data, size);
+}
+
+bool CTCPServer::CTCPClient::Flush()
+{
+  std::unique_lock lock(m_critSection);
+  while (!m_sendBuffer.empty())
+  {
+    int sent = SendNonBlocking(m_socket, m_sendBuffer.data(), m_sendBuffer.size());
+    if (sent < 0)
+      return false;
+    if (sent == 0)
+      break;
+
+    m_sendBuffer.erase(0, sent);
+  }
+
+  return true;
+}
+
+bool CTCPServer::CTCPClient::HasPendingOutput()
+{
+  std::unique_lock lock(m_critSection);
+  return !m_sendBuffer.empty();
 }
 
 void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
@@ -627,6 +873,9 @@ void CTCPServer::CTCPClient::Disconnect()
   if (m_socket > 0)
   {
     std::unique_lock lock(m_critSection);
+    // whatever fits into the socket's buffer still reaches the client
+    Flush();
+    m_sendBuffer.clear();
     shutdown(m_socket, SHUT_RDWR);
     closesocket(m_socket);
     m_socket = INVALID_SOCKET;
@@ -645,6 +894,7 @@ void CTCPServer::CTCPClient::Copy(const CTCPClient& client)
   m_beginChar         = client.m_beginChar;
   m_endChar           = client.m_endChar;
   m_buffer            = client.m_buffer;
+  m_sendBuffer        = client.m_sendBuffer;
 }
 
 CTCPServer::CWebSocketClient::CWebSocketClient(CWebSocket *websocket)
@@ -685,13 +935,23 @@ CTCPServer::CWebSocketClient& CTCPServer::CWebSocketClient::operator=(const CWeb
 
 void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
 {
-  const CWebSocketMessage *msg = m_websocket->Send(WebSocketTextFrame, data, size);
-  if (msg == NULL || !msg->IsComplete())
-    return;
+  std::string framed = Frame(std::string(data, size));
+  if (!framed.empty())
+    CTCPClient::Send(framed.c_str(), framed.size());
+}
+
+std::string CTCPServer::CWebSocketClient::Frame(const std::string& data)
+{
+  std::unique_ptr<const CWebSocketMessage> msg(
+      m_websocket->Send(WebSocketTextFrame, data.c_str(), data.size()));
+  if (msg == nullptr || !msg->IsComplete())
+    return "";
+
+  std::string framed;
+  for (const CWebSocketFrame* frame : msg->GetFrames())
+    framed.append(frame->GetFrameData(), static_cast<size_t>(frame->GetFrameLength()));
 
-  std::vector<const CWebSocketFrame *> frames = msg->GetFrames();
-  for (unsigned int index = 0; index < frames.size(); index++)
-    CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
+  return framed;
 }
 
 void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
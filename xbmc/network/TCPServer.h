@@ -15,6 +15,7 @@
 #include "threads/Thread.h"
 #include "websocket/WebSocket.h"
 
+#include <string>
 #include <vector>
 
 #include <sys/socket.h>
@@ -50,6 +51,10 @@ namespace JSONRPC
     bool InitializeTCP();
     void Deinitialize();
 
+    bool AcceptConnection(SOCKET server);
+    bool ReadFromConnection(unsigned int index);
+    void CloseConnection(unsigned int index);
+
     class CTCPClient : public IClient
     {
     public:
@@ -64,6 +69,9 @@ namespace JSONRPC
       int GetAnnouncementFlags() override;
       bool SetAnnouncementFlags(int flags) override;
 
+      /*!
+       \brief Send data to the client or queue it if the client isn't able to receive it right now.
+       */
       virtual void Send(const char *data, unsigned int size);
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
       virtual void Disconnect();
@@ -71,6 +79,20 @@ namespace JSONRPC
       virtual bool IsNew() const { return m_new; }
       virtual bool Closing() const { return false; }
 
+      /*!
+       \brief Put data into the form it is sent in, which is the same for all clients with the
+       same framing. The result can be passed to CTCPClient::Send().
+       */
+      virtual std::string Frame(const std::string& data) { return data; }
+      virtual int GetFraming() const { return 0; }
+
+      /*!
+       \brief Send as much of the queued data as the socket accepts.
+       \return false if the connection is broken
+       */
+      bool Flush();
+      bool HasPendingOutput();
+
       SOCKET m_socket{INVALID_SOCKET};
       sockaddr_storage m_cliaddr;
       socklen_t m_addrlen;
@@ -84,6 +106,7 @@ namespace JSONRPC
       int m_beginBrackets, m_endBrackets;
       char m_beginChar, m_endChar;
       std::string m_buffer;
+      std::string m_sendBuffer;
     };
 
     class CWebSocketClient : public CTCPClient
@@ -99,6 +122,9 @@ namespace JSONRPC
       void PushBuffer(CTCPServer *host, const char *buffer, int length) override;
       void Disconnect() override;
 
+      std::string Frame(const std::string& data) override;
+      int GetFraming() const override { return m_websocket->GetVersion(); }
+
       bool IsNew() const override { return m_websocket == NULL; }
       bool Closing() const override { return m_websocket != NULL && m_websocket->GetState() == WebSocketStateClosed; }
 
@@ -108,7 +134,9 @@ namespace JSONRPC
     };
 
     std::vector<CTCPClient*> m_connections;
+    CCriticalSection m_critSection; // protects m_connections against changes while announcing
     std::vector<SOCKET> m_servers;
+    int m_epollFd{-1}; // only used where epoll is available
     int m_port;
     bool m_nonlocal;
     void* m_sdpd;
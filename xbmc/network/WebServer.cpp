@@ -10,10 +10,13 @@
 
 #include "CompileInfo.h"
 #include "ServiceBroker.h"
+#include "URL.h"
 #include "XBDateTime.h"
 #include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/FileUtils.h"
@@ -28,15 +31,22 @@
 #include <mutex>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 #if defined(TARGET_POSIX)
+#include <fcntl.h>
 #include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #include <inttypes.h>
 
 #define MAX_POST_BUFFER_SIZE 2048
 
+// size of the blocks read from files which can't be sent from a file descriptor
+#define FILE_DOWNLOAD_BLOCK_SIZE (128 * 1024)
+
 #define PAGE_FILE_NOT_FOUND \
   "<html><head><title>File not found</title></head><body>File not found</body></html>"
 #define NOT_SUPPORTED \
@@ -81,6 +91,41 @@ CWebServer::CWebServer()
 #endif
 }
 
+#if defined(TARGET_POSIX)
+// opens a regular file on a local filesystem so MHD can send it from the file descriptor (using
+// sendfile() where possible). returns -1 for any other kind of path.
+static int OpenLocalFile(const std::string& filePath, uint64_t& fileLength)
+{
+  const std::string path = CSpecialProtocol::TranslatePath(filePath);
+  if (!CURL(path).GetProtocol().empty() || URIUtils::IsStack(path))
+    return -1;
+
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return -1;
+
+  struct stat statBuffer;
+  if (fstat(fd, &statBuffer) != 0 || !S_ISREG(statBuffer.st_mode))
+  {
+    close(fd);
+    return -1;
+  }
+
+  fileLength = static_cast<uint64_t>(statBuffer.st_size);
+  return fd;
+}
+#endif
+
+static unsigned int GetFileDownloadFlags(const std::string& filePath)
+{
+  // let files on network shares be read ahead by the file cache (depending on the user's cache
+  // settings) so the transfer doesn't stall on every request to the remote end
+  if (URIUtils::IsNetworkFilesystem(filePath) || URIUtils::IsInternetStream(filePath))
+    return XFILE::READ_AUDIO_VIDEO | XFILE::READ_TRUNCATED;
+
+  return XFILE::READ_NO_CACHE;
+}
+
 static MHD_Response* create_response(size_t size, const void* data, int free, int copy)
 {
   MHD_ResponseMemoryMode mode = MHD_RESPMEM_PERSISTENT;
@@ -798,14 +843,24 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
   if (!CFileUtils::CheckFileAccessAllowed(filePath))
     return SendErrorResponse(request, MHD_HTTP_NOT_FOUND, request.method);
 
-  if (!file->Open(filePath, XFILE::READ_NO_CACHE))
+  uint64_t fileLength = 0;
+  int fd = -1;
+#if defined(TARGET_POSIX)
+  fd = OpenLocalFile(filePath, fileLength);
+#endif
+
+  if (fd < 0)
   {
-    m_logger->error("Failed to open {}", filePath);
-    return SendErrorResponse(request, MHD_HTTP_NOT_FOUND, request.method);
+    if (!file->Open(filePath, GetFileDownloadFlags(filePath)))
+    {
+      m_logger->error("Failed to open {}", filePath);
+      return SendErrorResponse(request, MHD_HTTP_NOT_FOUND, request.method);
+    }
+
+    fileLength = static_cast<uint64_t>(file->GetLength());
   }
 
   bool ranged = false;
-  uint64_t fileLength = static_cast<uint64_t>(file->GetLength());
 
   // get the MIME type for the Content-Type header
   std::string mimeType = responseDetails.contentType;
@@ -887,18 +942,49 @@ MHD_RESULT CWebServer::CreateFileDownloadResponse(
   // set the initial write position
   context->ranges.GetFirstPosition(context->writePosition);
 
-  // create the response object
-  response =
-      MHD_create_response_from_callback(totalLength, 2048, &CWebServer::ContentReaderCallback,
-                                        context.get(), &CWebServer::ContentReaderFreeCallback);
-  if (response == nullptr)
+#if defined(TARGET_POSIX)
+  if (fd >= 0 && context->rangeCountTotal == 1)
   {
-    m_logger->error("failed to create a HTTP response for {} to be filled from{}", request.pathUrl,
-                    filePath);
-    return MHD_NO;
+    // a single range of a local file is sent directly from the file descriptor which is closed
+    // by mhd together with the response
+    response = MHD_create_response_from_fd_at_offset64(totalLength, fd, context->writePosition);
+    if (response == nullptr)
+    {
+      close(fd);
+      m_logger->error("failed to create a HTTP response for {} to be filled from {}",
+                      request.pathUrl, filePath);
+      return MHD_NO;
+    }
   }
+  else
+#endif
+  {
+#if defined(TARGET_POSIX)
+    // multipart responses are put together in ContentReaderCallback
+    if (fd >= 0)
+    {
+      close(fd);
+      if (!file->Open(filePath, XFILE::READ_NO_CACHE))
+      {
+        m_logger->error("Failed to open {}", filePath);
+        return SendErrorResponse(request, MHD_HTTP_NOT_FOUND, request.method);
+      }
+    }
+#endif
 
-  context.release(); // ownership was passed to mhd
+    // create the response object
+    response = MHD_create_response_from_callback(totalLength, FILE_DOWNLOAD_BLOCK_SIZE,
+                                                 &CWebServer::ContentReaderCallback, context.get(),
+                                                 &CWebServer::ContentReaderFreeCallback);
+    if (response == nullptr)
+    {
+      m_logger->error("failed to create a HTTP response for {} to be filled from {}",
+                      request.pathUrl, filePath);
+      return MHD_NO;
+    }
+
+    context.release(); // ownership was passed to mhd
+  }
 
   // add Content-Range header
   if (ranged)
@@ -1196,50 +1282,75 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
 
   MHD_set_panic_func(&panicHandlerForMHD, nullptr);
 
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const unsigned int threadPoolSize = advancedSettings->m_webServerThreadPoolSize;
+
+  flags |= MHD_USE_DEBUG; /* Print MHD error messages to log */
+
+  if (threadPoolSize > 0)
+  {
+    // all connections are served by a fixed number of threads, each running its own event loop
+    // (epoll where available). handlers block one of these threads while they are working.
+#if (MHD_VERSION >= 0x00095300)
+    flags |= MHD_USE_AUTO_INTERNAL_THREAD;
+#else
+    flags |= MHD_USE_SELECT_INTERNALLY;
+#endif
+  }
+  else
+  {
+    // one thread per connection
+    // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
+    // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
+    flags |= MHD_USE_THREAD_PER_CONNECTION;
+#if (MHD_VERSION >= 0x00095207)
+    flags |= MHD_USE_INTERNAL_POLLING_THREAD; /* MHD_USE_THREAD_PER_CONNECTION must be used only
+                                                 with MHD_USE_INTERNAL_POLLING_THREAD since
+                                                 0.9.54 */
+#endif
+  }
+
+  std::vector<MHD_OptionItem> options = {
+      {MHD_OPTION_EXTERNAL_LOGGER, reinterpret_cast<intptr_t>(&logFromMHD), nullptr},
+      {MHD_OPTION_CONNECTION_LIMIT,
+       static_cast<intptr_t>(advancedSettings->m_webServerConnectionLimit), nullptr},
+      {MHD_OPTION_CONNECTION_TIMEOUT, static_cast<intptr_t>(timeout), nullptr},
+      {MHD_OPTION_URI_LOG_CALLBACK, reinterpret_cast<intptr_t>(&CWebServer::UriRequestLogger),
+       this},
+      {MHD_OPTION_THREAD_STACK_SIZE, static_cast<intptr_t>(m_thread_stacksize), nullptr},
+  };
+
+  if (threadPoolSize > 0)
+    options.push_back(
+        {MHD_OPTION_THREAD_POOL_SIZE, static_cast<intptr_t>(threadPoolSize), nullptr});
+
   if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
           CSettings::SETTING_SERVICES_WEBSERVERSSL) &&
       MHD_is_feature_supported(MHD_FEATURE_SSL) == MHD_YES && LoadCert(m_key, m_cert))
+  {
     // SSL enabled
-    return MHD_start_daemon(
-        flags |
-            // one thread per connection
-            // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-            // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-            MHD_USE_THREAD_PER_CONNECTION
-#if (MHD_VERSION >= 0x00095207)
-            |
-            MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with
-                                               MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
-#endif
-            | MHD_USE_DEBUG /* Print MHD error messages to log */
-            | MHD_USE_SSL,
-        port, 0, 0, &CWebServer::AnswerToConnection, this,
-
-        MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, 512,
-        MHD_OPTION_CONNECTION_TIMEOUT, timeout, MHD_OPTION_URI_LOG_CALLBACK,
-        &CWebServer::UriRequestLogger, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
-        MHD_OPTION_HTTPS_MEM_KEY, m_key.c_str(), MHD_OPTION_HTTPS_MEM_CERT, m_cert.c_str(),
-        MHD_OPTION_HTTPS_PRIORITIES, ciphers, MHD_OPTION_END);
-
-  // No SSL
-  return MHD_start_daemon(
-      flags |
-          // one thread per connection
-          // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-          // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-          MHD_USE_THREAD_PER_CONNECTION
-#if (MHD_VERSION >= 0x00095207)
-          | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with
-                                               MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
-#endif
-          | MHD_USE_DEBUG /* Print MHD error messages to log */
-      ,
-      port, 0, 0, &CWebServer::AnswerToConnection, this,
-
-      MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0, MHD_OPTION_CONNECTION_LIMIT, 512,
-      MHD_OPTION_CONNECTION_TIMEOUT, timeout, MHD_OPTION_URI_LOG_CALLBACK,
-      &CWebServer::UriRequestLogger, this, MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
-      MHD_OPTION_END);
+    flags |= MHD_USE_SSL;
+    options.push_back({MHD_OPTION_HTTPS_MEM_KEY, 0, const_cast<char*>(m_key.c_str())});
+    options.push_back({MHD_OPTION_HTTPS_MEM_CERT, 0, const_cast<char*>(m_cert.c_str())});
+    options.push_back({MHD_OPTION_HTTPS_PRIORITIES, 0, const_cast<char*>(ciphers)});
+  }
+
+  options.push_back({MHD_OPTION_END, 0, nullptr});
+
+  struct MHD_Daemon* daemon =
+      MHD_start_daemon(flags, port, 0, 0, &CWebServer::AnswerToConnection, this,
+                       MHD_OPTION_ARRAY, options.data(), MHD_OPTION_END);
+
+  if (daemon)
+  {
+    if (threadPoolSize > 0)
+      m_logger->debug("serving connections with {} threads", threadPoolSize);
+    else
+      m_logger->debug("serving connections with one thread each");
+  }
+
+  return daemon;
 }
 
 bool CWebServer::Start(uint16_t port, const std::string& username, const std::string& password)
@@ -0,0 +1,218 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "network/WebServer.h"
+#include "network/httprequesthandler/HTTPVfsHandler.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/MediaSourceSettings.h"
+#include "settings/SettingsComponent.h"
+#include "test/TestUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+constexpr int CONCURRENT_CLIENTS = 500;
+
+// Reads a numeric field of /proc/self/status, e.g. VmRSS (in kB) or Threads
+long ReadProcessStatus(const std::string& field)
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (StringUtils::StartsWith(line, field + ":"))
+      return std::strtol(line.c_str() + field.size() + 1, nullptr, 10);
+  }
+  return 0;
+}
+
+int Connect(uint16_t port)
+{
+  const int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+    return -1;
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+  {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+bool SendAll(int fd, const std::string& data)
+{
+  size_t sent = 0;
+  while (sent < data.size())
+  {
+    const ssize_t ret = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (ret <= 0)
+      return false;
+    sent += static_cast<size_t>(ret);
+  }
+  return true;
+}
+
+// Reads until the server closes the connection, returns whether the answer was a 200
+bool ReceiveOk(int fd)
+{
+  std::string response;
+  char buffer[4096];
+  ssize_t ret;
+  while ((ret = recv(fd, buffer, sizeof(buffer), 0)) > 0)
+    response.append(buffer, static_cast<size_t>(ret));
+  return StringUtils::StartsWith(response, "HTTP/1.1 200");
+}
+
+class CWebServerLoad
+{
+public:
+  explicit CWebServerLoad(unsigned int threadPoolSize)
+  {
+    std::random_device rd;
+    std::mt19937 mt(rd());
+    m_port = std::uniform_int_distribution<uint16_t>(49152, 65535)(mt);
+
+    const std::string sourcePath = XBMC_REF_FILE_PATH("xbmc/network/test/data/webserver/");
+    CMediaSource source;
+    source.strName = "WebServer Share";
+    source.strPath = sourcePath;
+    source.vecPaths.push_back(sourcePath);
+    source.m_allowSharing = true;
+    source.m_iDriveType = SourceType::LOCAL;
+    source.GetLockInfo().SetMode(LockMode::EVERYONE);
+    source.m_ignore = true;
+    CMediaSourceSettings::GetInstance().AddShare("videos", source);
+
+    const std::string path = CURL::Encode(URIUtils::AddFileToFolder(sourcePath, "test.html"));
+    m_request = StringUtils::Format("GET /vfs/{} HTTP/1.1\r\n"
+                                    "Host: localhost:{}\r\n"
+                                    "Connection: close\r\n\r\n",
+                                    path, m_port);
+
+    const std::shared_ptr<CAdvancedSettings> advancedSettings =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    const unsigned int oldThreadPoolSize = advancedSettings->m_webServerThreadPoolSize;
+    advancedSettings->m_webServerThreadPoolSize = threadPoolSize;
+    m_webServer.Start(m_port, "", "");
+    advancedSettings->m_webServerThreadPoolSize = oldThreadPoolSize;
+    m_webServer.RegisterRequestHandler(&m_vfsHandler);
+  }
+
+  ~CWebServerLoad()
+  {
+    if (m_webServer.IsStarted())
+      m_webServer.Stop();
+    m_webServer.UnregisterRequestHandler(&m_vfsHandler);
+    CMediaSourceSettings::GetInstance().Clear();
+  }
+
+  bool IsStarted() { return m_webServer.IsStarted(); }
+  uint16_t GetPort() const { return m_port; }
+  const std::string& GetRequest() const { return m_request; }
+
+private:
+  CWebServer m_webServer;
+  CHTTPVfsHandler m_vfsHandler;
+  uint16_t m_port;
+  std::string m_request;
+};
+} // namespace
+
+/*!
+ \brief Keep 500 clients connected to the web server, then let each of them fetch a small file
+ over the VFS handler.
+ The argument is the thread pool size, 0 is one thread per connection. Reports requests/second,
+ and the threads and resident memory (kB) the process gained while all clients were connected.
+ Needs a file descriptor limit of about 1100 (ulimit -n).
+ */
+static void BM_WebServer_ConcurrentClients(benchmark::State& state)
+{
+  CWebServerLoad server(static_cast<unsigned int>(state.range(0)));
+  if (!server.IsStarted())
+  {
+    state.SkipWithError("failed to start the web server");
+    return;
+  }
+
+  long extraThreads = 0;
+  long extraMemory = 0;
+  for (auto _ : state)
+  {
+    const long threadsBefore = ReadProcessStatus("Threads");
+    const long memoryBefore = ReadProcessStatus("VmRSS");
+
+    std::vector<int> clients;
+    clients.reserve(CONCURRENT_CLIENTS);
+    for (int i = 0; i < CONCURRENT_CLIENTS; ++i)
+    {
+      const int fd = Connect(server.GetPort());
+      if (fd >= 0)
+        clients.push_back(fd);
+    }
+
+    // give the server time to accept everything before taking the measurement
+    state.PauseTiming();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    extraThreads += ReadProcessStatus("Threads") - threadsBefore;
+    extraMemory += ReadProcessStatus("VmRSS") - memoryBefore;
+    state.ResumeTiming();
+
+    int succeeded = 0;
+    for (int fd : clients)
+      SendAll(fd, server.GetRequest());
+    for (int fd : clients)
+    {
+      if (ReceiveOk(fd))
+        ++succeeded;
+      close(fd);
+    }
+
+    if (succeeded != CONCURRENT_CLIENTS)
+    {
+      state.SkipWithError("not every client got an answer");
+      break;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * CONCURRENT_CLIENTS);
+  state.counters["threads"] = benchmark::Counter(static_cast<double>(extraThreads),
+                                                 benchmark::Counter::kAvgIterations);
+  state.counters["rss_kb"] = benchmark::Counter(static_cast<double>(extraMemory),
+                                                benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_WebServer_ConcurrentClients)
+    ->ArgName("pool")
+    ->Arg(0)
+    ->Arg(4)
+    ->Arg(16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -19,16 +19,21 @@
 #include "network/WebServer.h"
 #include "network/httprequesthandler/HTTPJsonRpcHandler.h"
 #include "network/httprequesthandler/HTTPVfsHandler.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/MediaSourceSettings.h"
+#include "settings/SettingsComponent.h"
 #include "test/TestUtils.h"
 #include "utils/JSONVariantParser.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 
+#include <atomic>
 #include <errno.h>
 #include <random>
 #include <stdlib.h>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -573,6 +578,35 @@ TEST_F(TestWebServer, CanGetFile)
   CheckHtmlTestFileResponse(curl);
 }
 
+TEST_F(TestWebServer, CanGetFileConcurrentlyWithThreadPool)
+{
+  const std::shared_ptr<CAdvancedSettings> advancedSettings =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  const unsigned int threadPoolSize = advancedSettings->m_webServerThreadPoolSize;
+
+  // serve more clients than there are worker threads
+  webserver.Stop();
+  advancedSettings->m_webServerThreadPoolSize = 2;
+  ASSERT_TRUE(webserver.Start(webserverPort, "", ""));
+  advancedSettings->m_webServerThreadPoolSize = threadPoolSize;
+
+  std::atomic<int> succeeded{0};
+  std::vector<std::thread> clients;
+  for (int i = 0; i < 16; ++i)
+  {
+    clients.emplace_back([this, &succeeded]() {
+      std::string result;
+      CCurlFile curl;
+      if (curl.Get(GetUrlOfTestFile(TEST_FILES_HTML), result) && result == TEST_FILES_DATA)
+        ++succeeded;
+    });
+  }
+  for (auto& client : clients)
+    client.join();
+
+  EXPECT_EQ(16, succeeded);
+}
+
 TEST_F(TestWebServer, CanGetFileForcingNoCache)
 {
   // check non-cacheable HTML with Control-Cache: no-cache
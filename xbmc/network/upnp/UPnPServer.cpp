@@ -51,7 +51,9 @@
 #include "video/VideoThumbLoader.h"
 #include "view/GUIViewState.h"
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 
 #include <Platinum/Source/Platinum/Platinum.h>
 
@@ -80,6 +82,12 @@ const char* video_containers[] = {
     "library://video/movies/titles.xml/", "library://video/tvshows/titles.xml/",
     "videodb://recentlyaddedmovies/", "videodb://recentlyaddedepisodes/"};
 
+// clients page through a container in quick succession, afterwards the listing is dropped
+constexpr auto BROWSE_CACHE_TIMEOUT = std::chrono::minutes(5);
+constexpr size_t BROWSE_CACHE_MAX_ENTRIES = 8;
+// different filters and kinds of clients paging through the same container
+constexpr size_t BROWSE_CACHE_MAX_DIDL_KEYS = 4;
+
 /*----------------------------------------------------------------------
 |   CUPnPServer::CUPnPServer
 +---------------------------------------------------------------------*/
@@ -520,6 +528,9 @@ void CUPnPServer::Announce(AnnouncementFlag flag,
       message != "OnScanFinished")
     return;
 
+  // a single change may show up in any number of listings
+  ClearBrowseCache();
+
   if (data.isNull())
   {
     if (message == "OnScanStarted" || message == "OnCleanStarted")
@@ -778,7 +789,6 @@ NPT_Result CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference& action,
                                                const char* sort_criteria,
                                                const PLT_HttpRequestContext& context)
 {
-  CFileItemList items;
   const NPT_String decodedObjectId = DecodeObjectId(object_id);
   m_logger->info("Received Browse DirectChildren request for encoded object '{}' (plain value: "
                  "'{}'), with sort criteria {}",
@@ -792,8 +802,42 @@ NPT_Result CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference& action,
     return NPT_FAILURE;
   }
 
-  items.SetPath(static_cast<const char*>(parent_id));
+  std::shared_ptr<CFileItemList> items;
+  unsigned int generation;
+  std::shared_ptr<CBrowseCacheEntry> cache_entry =
+      GetBrowseCacheEntry(static_cast<const char*>(parent_id), generation);
+  if (cache_entry)
+  {
+    m_logger->debug("Using cached listing of '{}'", parent_id.GetChars());
+    items = cache_entry->items;
+  }
+  else
+  {
+    items = std::make_shared<CFileItemList>(static_cast<const char*>(parent_id));
+    BuildDirectChildren(parent_id, *items);
+    cache_entry = AddBrowseCacheEntry(static_cast<const char*>(parent_id), items, generation);
+  }
+
+  // the items and their DIDL-Lite in the cache are updated while building the response
+  std::unique_lock<CCriticalSection> lock;
+  if (cache_entry)
+    lock = std::unique_lock(cache_entry->critSection);
 
+  // Don't pass parent_id if action is Search not BrowseDirectChildren, as
+  // we want the engine to determine the best parent id, not necessarily the one
+  // passed
+  NPT_String action_name = action->GetActionDesc().GetName();
+  return BuildResponse(action, *items, filter, starting_index, requested_count, sort_criteria,
+                       context,
+                       (action_name.Compare("Search", true) == 0) ? NULL : parent_id.GetChars(),
+                       cache_entry.get());
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::BuildDirectChildren
++---------------------------------------------------------------------*/
+void CUPnPServer::BuildDirectChildren(const NPT_String& parent_id, CFileItemList& items)
+{
   // guard against loading while saving to the same cache file
   // as CArchive currently performs no locking itself
   bool load;
@@ -866,14 +910,70 @@ NPT_Result CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference& action,
       items.Add(mvideos);
     }
   }
+}
 
-  // Don't pass parent_id if action is Search not BrowseDirectChildren, as
-  // we want the engine to determine the best parent id, not necessarily the one
-  // passed
-  NPT_String action_name = action->GetActionDesc().GetName();
-  return BuildResponse(action, items, filter, starting_index, requested_count, sort_criteria,
-                       context,
-                       (action_name.Compare("Search", true) == 0) ? NULL : parent_id.GetChars());
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetBrowseCacheEntry
++---------------------------------------------------------------------*/
+std::shared_ptr<CUPnPServer::CBrowseCacheEntry> CUPnPServer::GetBrowseCacheEntry(
+    const std::string& path, unsigned int& generation)
+{
+  const auto now = std::chrono::steady_clock::now();
+
+  std::unique_lock lock(m_BrowseCacheSection);
+  generation = m_BrowseCacheGeneration;
+  std::erase_if(m_BrowseCache, [now](const auto& entry)
+                { return now - entry.second->lastUsed > BROWSE_CACHE_TIMEOUT; });
+
+  const auto it = m_BrowseCache.find(path);
+  if (it == m_BrowseCache.end())
+    return nullptr;
+
+  it->second->lastUsed = now;
+  return it->second;
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::AddBrowseCacheEntry
++---------------------------------------------------------------------*/
+std::shared_ptr<CUPnPServer::CBrowseCacheEntry> CUPnPServer::AddBrowseCacheEntry(
+    const std::string& path,
+    const std::shared_ptr<CFileItemList>& items,
+    unsigned int generation)
+{
+  // only library listings, anything else may change without an announcement
+  if (!URIUtils::IsVideoDb(path) && !URIUtils::IsMusicDb(path) &&
+      !StringUtils::StartsWith(path, "library://video/"))
+    return nullptr;
+
+  auto entry = std::make_shared<CBrowseCacheEntry>();
+  entry->items = items;
+  entry->lastUsed = std::chrono::steady_clock::now();
+
+  std::unique_lock lock(m_BrowseCacheSection);
+  // the library changed while the listing was built, it may already be out of date
+  if (generation != m_BrowseCacheGeneration)
+    return nullptr;
+
+  if (m_BrowseCache.size() >= BROWSE_CACHE_MAX_ENTRIES && !m_BrowseCache.contains(path))
+  {
+    m_BrowseCache.erase(std::ranges::min_element(
+        m_BrowseCache, {}, [](const auto& cached) { return cached.second->lastUsed; }));
+  }
+
+  m_BrowseCache[path] = entry;
+  return entry;
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::ClearBrowseCache
++---------------------------------------------------------------------*/
+void CUPnPServer::ClearBrowseCache()
+{
+  // responses being built from an entry keep it alive until they are done
+  std::unique_lock lock(m_BrowseCacheSection);
+  m_BrowseCache.clear();
+  ++m_BrowseCacheGeneration;
 }
 
 /*----------------------------------------------------------------------
@@ -886,7 +986,8 @@ NPT_Result CUPnPServer::BuildResponse(PLT_ActionReference& action,
                                       NPT_UInt32 requested_count,
                                       const char* sort_criteria,
                                       const PLT_HttpRequestContext& context,
-                                      const char* parent_id /* = NULL */)
+                                      const char* parent_id /* = NULL */,
+                                      CBrowseCacheEntry* cache_entry /* = nullptr */)
 {
   NPT_COMPILER_UNUSED(sort_criteria);
 
@@ -933,23 +1034,56 @@ NPT_Result CUPnPServer::BuildResponse(PLT_ActionReference& action,
   NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count),
                                    (unsigned long)items.Size()); // don't return more than we can
 
+  // the DIDL-Lite depends on the filter, the address the client talks to and its quirks
+  std::vector<std::optional<NPT_String>>* cached_didl = nullptr;
+  if (cache_entry)
+  {
+    const std::string key = StringUtils::Format(
+        "{}|{}|{}|{}", filter, context.GetLocalAddress().ToString().GetChars(),
+        static_cast<int>(GetClientQuirks(&context)), parent_id ? parent_id : "");
+    auto& fragments = cache_entry->didl;
+    if (fragments.size() >= BROWSE_CACHE_MAX_DIDL_KEYS && !fragments.contains(key))
+    {
+      // forget the DIDL-Lite used least recently
+      fragments.erase(std::ranges::min_element(fragments, {}, [](const auto& entry)
+                                               { return entry.second.lastUsed; }));
+    }
+
+    CDidlFragments& didl_fragments = fragments[key];
+    didl_fragments.lastUsed = std::chrono::steady_clock::now();
+    cached_didl = &didl_fragments.items;
+    if (cached_didl->size() != static_cast<size_t>(items.Size()))
+      cached_didl->assign(items.Size(), std::nullopt);
+  }
+
   NPT_Cardinal count = 0;
   NPT_Cardinal total = items.Size();
   NPT_String didl = didl_header;
   PLT_MediaObjectReference object;
   for (unsigned long i = starting_index; i < stop_index; ++i)
   {
-    object = Build(items[i], true, context, thumb_loader, parent_id);
-    if (object.IsNull())
+    NPT_String tmp;
+    if (cached_didl && (*cached_didl)[i])
+    {
+      tmp = *(*cached_didl)[i];
+    }
+    else
+    {
+      object = Build(items[i], true, context, thumb_loader, parent_id);
+      if (!object.IsNull())
+        NPT_CHECK(PLT_Didl::ToDidl(*object.AsPointer(), filter, tmp));
+
+      if (cached_didl)
+        (*cached_didl)[i] = tmp;
+    }
+
+    if (tmp.IsEmpty())
     {
       // don't tell the client this item ever existed
       --total;
       continue;
     }
 
-    NPT_String tmp;
-    NPT_CHECK(PLT_Didl::ToDidl(*object.AsPointer(), filter, tmp));
-
     // Neptunes string growing is dead slow for small additions
     if (didl.GetCapacity() < tmp.GetLength() + didl.GetLength())
     {
@@ -9,12 +9,16 @@
 #pragma once
 
 #include "interfaces/IAnnouncer.h"
+#include "threads/CriticalSection.h"
 #include "utils/logtypes.h"
 
+#include <chrono>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <Platinum/Source/Devices/MediaConnect/PltMediaConnect.h>
 
@@ -109,6 +113,38 @@ public:
 
 
   private:
+    /*!
+     \brief A library listing kept in memory while clients page through it.
+
+     Building a listing means querying the whole container from the database, so without the
+     cache every page of a large container would cost as much as the container itself. The DIDL-Lite
+     of the items is cached as well, separately for every filter and kind of client as both
+     affect it. The cache is cleared on every library announcement.
+     */
+    struct CDidlFragments
+    {
+      //! DIDL-Lite of every item once built, empty if the item is hidden from clients
+      std::vector<std::optional<NPT_String>> items;
+      std::chrono::steady_clock::time_point lastUsed;
+    };
+
+    struct CBrowseCacheEntry
+    {
+      std::shared_ptr<CFileItemList> items;
+      std::chrono::steady_clock::time_point lastUsed;
+      std::map<std::string, CDidlFragments> didl; //!< by filter and kind of client
+      CCriticalSection critSection; //!< held while building a response from the entry
+    };
+
+    std::shared_ptr<CBrowseCacheEntry> GetBrowseCacheEntry(const std::string& path,
+                                                           unsigned int& generation);
+    std::shared_ptr<CBrowseCacheEntry> AddBrowseCacheEntry(
+        const std::string& path,
+        const std::shared_ptr<CFileItemList>& items,
+        unsigned int generation);
+    void ClearBrowseCache();
+    void BuildDirectChildren(const NPT_String& parent_id, CFileItemList& items);
+
     void OnScanCompleted(int type);
     void UpdateContainer(const std::string& id);
     void PropagateUpdates();
@@ -125,7 +161,8 @@ public:
                              NPT_UInt32                    requested_count,
                              const char*                   sort_criteria,
                              const PLT_HttpRequestContext& context,
-                             const char*                   parent_id /* = NULL */);
+                             const char*                   parent_id /* = NULL */,
+                             CBrowseCacheEntry*            cache_entry = nullptr);
 
     // class methods
     static void DefaultSortItems(CFileItemList& items);
@@ -142,6 +179,10 @@ public:
 
     NPT_Mutex m_CacheMutex;
 
+    CCriticalSection m_BrowseCacheSection;
+    std::map<std::string, std::shared_ptr<CBrowseCacheEntry>> m_BrowseCache;
+    unsigned int m_BrowseCacheGeneration = 0; //!< bumped whenever the cache is cleared
+
     NPT_Mutex m_FileMutex;
     NPT_Map<NPT_String, NPT_String> m_FileMap;
 
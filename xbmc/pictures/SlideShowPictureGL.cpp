@@ -9,6 +9,7 @@
 #include "SlideShowPictureGL.h"
 
 #include "ServiceBroker.h"
+#include "guilib/GUITextureGL.h"
 #include "guilib/Texture.h"
 #include "rendering/gl/RenderSystemGL.h"
 #include "utils/GLUtils.h"
@@ -23,6 +24,10 @@ std::unique_ptr<CSlideShowPic> CSlideShowPic::CreateSlideShowPicture()
 void CSlideShowPicGL::Render(float* x, float* y, CTexture* pTexture, Color color)
 {
   CRenderSystemGL* renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
+
+  // Draw queued GUI quads before the texture and blend state below are set
+  CGUITextureGL::FlushBatch();
+
   if (pTexture)
   {
     pTexture->LoadToGPU();
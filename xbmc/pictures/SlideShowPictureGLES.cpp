@@ -9,6 +9,7 @@
 #include "SlideShowPictureGLES.h"
 
 #include "ServiceBroker.h"
+#include "guilib/GUITextureGLES.h"
 #include "guilib/Texture.h"
 #include "rendering/gles/RenderSystemGLES.h"
 #include "utils/GLUtils.h"
@@ -26,6 +27,10 @@ void CSlideShowPicGLES::Render(float* x,
 {
   CRenderSystemGLES* renderSystem =
       dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+
+  // Draw queued GUI quads before the texture and blend state below are set
+  CGUITextureGLES::FlushBatch();
+
   if (pTexture)
   {
     pTexture->LoadToGPU();
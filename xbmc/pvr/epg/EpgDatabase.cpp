@@ -14,16 +14,17 @@
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/epg/EpgSearchData.h"
 #include "pvr/epg/EpgSearchFilter.h"
+#include "pvr/epg/EpgSearchTermConverter.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
 #include <chrono>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
-#include <string_view>
 #include <vector>
 
 using namespace dbiplus;
@@ -32,8 +33,15 @@ using namespace PVR;
 bool CPVREpgDatabase::Open()
 {
   std::unique_lock lock(m_critSection);
-  return CDatabase::Open(
-      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databaseEpg);
+  if (!CDatabase::Open(
+          CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databaseEpg))
+    return false;
+
+  m_bHasFullTextIndex =
+      m_sqlite && !GetSingleValue("SELECT name FROM sqlite_master "
+                                  "WHERE type = 'table' AND name = 'epgtags_fts'")
+                       .empty();
+  return true;
 }
 
 void CPVREpgDatabase::Close()
@@ -98,7 +106,8 @@ void CPVREpgDatabase::CreateTables()
               "sParentalRatingCode varchar(64),"
               "sParentalRatingIcon varchar(512),"
               "sParentalRatingSource varchar(128),"
-              "sTitleExtraInfo varchar(128)"
+              "sTitleExtraInfo varchar(128),"
+              "iContentHash    integer"
               ")");
 
   CLog::LogFC(LOGDEBUG, LOGEPG, "Creating table 'lastepgscan'");
@@ -144,6 +153,64 @@ void CPVREpgDatabase::CreateAnalytics()
   std::unique_lock lock(m_critSection);
   m_pDS->exec("CREATE UNIQUE INDEX idx_epg_idEpg_iStartTime on epgtags(idEpg, iStartTime desc);");
   m_pDS->exec("CREATE INDEX idx_epg_iEndTime on epgtags(iEndTime);");
+
+  if (m_sqlite)
+    CreateFullTextIndex();
+}
+
+void CPVREpgDatabase::CreateFullTextIndex()
+{
+  // The trigram tokenizer matches any substring of at least three characters, case
+  // insensitive, which is what the LIKE based search does. It needs SQLite 3.34 or newer, so
+  // failing here is not fatal. Searches just keep using LIKE then.
+  try
+  {
+    m_pDS->exec("CREATE VIRTUAL TABLE IF NOT EXISTS epgtags_fts USING fts5("
+                "sTitle, sPlotOutline, sPlot, "
+                "content='epgtags', content_rowid='idBroadcast', tokenize='trigram');");
+
+    // Tags are persisted with REPLACE INTO, which does not fire delete triggers for the rows
+    // it replaces. Remove those from the index before the insert instead.
+    m_pDS->exec("CREATE TRIGGER epgtags_fts_replace BEFORE INSERT ON epgtags BEGIN "
+                "INSERT INTO epgtags_fts(epgtags_fts, rowid, sTitle, sPlotOutline, sPlot) "
+                "SELECT 'delete', idBroadcast, sTitle, sPlotOutline, sPlot FROM epgtags "
+                "WHERE idBroadcast = new.idBroadcast "
+                "OR (idEpg = new.idEpg AND iStartTime = new.iStartTime); "
+                "END;");
+    m_pDS->exec("CREATE TRIGGER epgtags_fts_insert AFTER INSERT ON epgtags BEGIN "
+                "INSERT INTO epgtags_fts(rowid, sTitle, sPlotOutline, sPlot) "
+                "VALUES (new.idBroadcast, new.sTitle, new.sPlotOutline, new.sPlot); "
+                "END;");
+    m_pDS->exec("CREATE TRIGGER epgtags_fts_delete AFTER DELETE ON epgtags BEGIN "
+                "INSERT INTO epgtags_fts(epgtags_fts, rowid, sTitle, sPlotOutline, sPlot) "
+                "VALUES ('delete', old.idBroadcast, old.sTitle, old.sPlotOutline, old.sPlot); "
+                "END;");
+    m_pDS->exec("CREATE TRIGGER epgtags_fts_update AFTER UPDATE ON epgtags BEGIN "
+                "INSERT INTO epgtags_fts(epgtags_fts, rowid, sTitle, sPlotOutline, sPlot) "
+                "VALUES ('delete', old.idBroadcast, old.sTitle, old.sPlotOutline, old.sPlot); "
+                "INSERT INTO epgtags_fts(rowid, sTitle, sPlotOutline, sPlot) "
+                "VALUES (new.idBroadcast, new.sTitle, new.sPlotOutline, new.sPlot); "
+                "END;");
+
+    // the triggers are dropped and recreated with every schema update, resync the index
+    m_pDS->exec("INSERT INTO epgtags_fts(epgtags_fts) VALUES ('rebuild');");
+  }
+  catch (...)
+  {
+    CLog::Log(LOGWARNING, "Unable to create the EPG full-text index, searches will be slower");
+
+    try
+    {
+      m_pDS->exec("DROP TRIGGER IF EXISTS epgtags_fts_replace;");
+      m_pDS->exec("DROP TRIGGER IF EXISTS epgtags_fts_insert;");
+      m_pDS->exec("DROP TRIGGER IF EXISTS epgtags_fts_delete;");
+      m_pDS->exec("DROP TRIGGER IF EXISTS epgtags_fts_update;");
+      m_pDS->exec("DROP TABLE IF EXISTS epgtags_fts;");
+    }
+    catch (...)
+    {
+    }
+  }
 }
 
 void CPVREpgDatabase::UpdateTables(int iVersion)
@@ -347,6 +414,9 @@ void CPVREpgDatabase::UpdateTables(int iVersion)
     m_pDS->exec("ALTER TABLE epgtags ADD sTitleExtraInfo varchar(128);");
     m_pDS->exec("UPDATE epgtags SET sTitleExtraInfo = ''");
   }
+
+  if (iVersion < 22)
+    m_pDS->exec("ALTER TABLE epgtags ADD iContentHash integer;");
 }
 
 bool CPVREpgDatabase::DeleteEpg()
@@ -563,133 +633,6 @@ CDateTime CPVREpgDatabase::GetMaxEndTime(int iEpgID, const CDateTime& maxEnd) co
   return {};
 }
 
-namespace
-{
-
-class CSearchTermConverter
-{
-public:
-  explicit CSearchTermConverter(const std::string& strSearchTerm) { Parse(strSearchTerm); }
-
-  bool HasSearchTerm() const { return !m_fragments.empty(); }
-
-  std::string ToSQL(std::string_view strFieldName) const
-  {
-    std::string result = "(";
-
-    for (auto it = m_fragments.cbegin(); it != m_fragments.cend();)
-    {
-      result += (*it);
-
-      ++it;
-      if (it != m_fragments.cend())
-        result += strFieldName;
-    }
-
-    StringUtils::TrimRight(result);
-    result += ")";
-    return result;
-  }
-
-private:
-  void Parse(const std::string& strSearchTerm)
-  {
-    std::string strParsedSearchTerm(strSearchTerm);
-    StringUtils::Trim(strParsedSearchTerm);
-
-    std::string strFragment;
-
-    bool bNextOR = false;
-    while (!strParsedSearchTerm.empty())
-    {
-      StringUtils::TrimLeft(strParsedSearchTerm);
-
-      if (StringUtils::StartsWith(strParsedSearchTerm, "!") ||
-          StringUtils::StartsWithNoCase(strParsedSearchTerm, "not"))
-      {
-        std::string strDummy;
-        GetAndCutNextTerm(strParsedSearchTerm, strDummy);
-        strFragment += " NOT ";
-        bNextOR = false;
-      }
-      else if (StringUtils::StartsWith(strParsedSearchTerm, "+") ||
-               StringUtils::StartsWithNoCase(strParsedSearchTerm, "and"))
-      {
-        std::string strDummy;
-        GetAndCutNextTerm(strParsedSearchTerm, strDummy);
-        strFragment += " AND ";
-        bNextOR = false;
-      }
-      else if (StringUtils::StartsWith(strParsedSearchTerm, "|") ||
-               StringUtils::StartsWithNoCase(strParsedSearchTerm, "or"))
-      {
-        std::string strDummy;
-        GetAndCutNextTerm(strParsedSearchTerm, strDummy);
-        strFragment += " OR ";
-        bNextOR = false;
-      }
-      else
-      {
-        std::string strTerm;
-        GetAndCutNextTerm(strParsedSearchTerm, strTerm);
-        if (!strTerm.empty())
-        {
-          if (bNextOR && !m_fragments.empty())
-            strFragment += " OR "; // default operator
-
-          strFragment += "(UPPER(";
-
-          m_fragments.emplace_back(strFragment);
-          strFragment.clear();
-
-          strFragment += ") LIKE UPPER('%";
-          StringUtils::Replace(strTerm, "'", "''"); // escape '
-          strFragment += strTerm;
-          strFragment += "%')) ";
-
-          bNextOR = true;
-        }
-        else
-        {
-          break;
-        }
-      }
-
-      StringUtils::TrimLeft(strParsedSearchTerm);
-    }
-
-    if (!strFragment.empty())
-      m_fragments.emplace_back(strFragment);
-  }
-
-  static void GetAndCutNextTerm(std::string& strSearchTerm, std::string& strNextTerm)
-  {
-    std::string strFindNext(" ");
-
-    if (StringUtils::EndsWith(strSearchTerm, "\""))
-    {
-      strSearchTerm.erase(0, 1);
-      strFindNext = "\"";
-    }
-
-    const size_t iNextPos = strSearchTerm.find(strFindNext);
-    if (iNextPos != std::string::npos)
-    {
-      strNextTerm = strSearchTerm.substr(0, iNextPos);
-      strSearchTerm.erase(0, iNextPos + 1);
-    }
-    else
-    {
-      strNextTerm = strSearchTerm;
-      strSearchTerm.clear();
-    }
-  }
-
-  std::vector<std::string> m_fragments;
-};
-
-} // unnamed namespace
-
 std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
     const PVREpgSearchData& searchData) const
 {
@@ -793,8 +736,24 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(
   // search term
   /////////////////////////////////////////////////////////////////////////////////////////////
 
-  const CSearchTermConverter conv{searchData.m_strSearchTerm};
-  if (conv.HasSearchTerm())
+  const CPVREpgSearchTermConverter conv{searchData.m_strSearchTerm};
+  if (conv.HasSearchTerm() && m_bHasFullTextIndex && conv.CanUseFullTextIndex())
+  {
+    std::string strMatch = conv.ToFullTextQuery("sTitle");
+    strMatch += " OR ";
+    strMatch += conv.ToFullTextQuery("sPlotOutline");
+
+    if (searchData.m_bSearchInDescription)
+    {
+      strMatch += " OR ";
+      strMatch += conv.ToFullTextQuery("sPlot");
+    }
+
+    filter.AppendWhere(PrepareSQL(
+        "idBroadcast IN (SELECT rowid FROM epgtags_fts WHERE epgtags_fts MATCH '%s')",
+        strMatch.c_str()));
+  }
+  else if (conv.HasSearchTerm())
   {
     // title
     std::string strWhere = conv.ToSQL("sTitle");
@@ -1064,6 +1023,52 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTagsByMinEnd
   return {};
 }
 
+std::map<CDateTime, CPVREpgDatabase::EpgTagContentHash> CPVREpgDatabase::
+    GetEpgTagContentHashesByMinEndMaxStartTime(int iEpgID,
+                                               const CDateTime& minEndTime,
+                                               const CDateTime& maxStartTime) const
+{
+  time_t minEnd;
+  minEndTime.GetAsTime(minEnd);
+
+  time_t maxStart;
+  maxStartTime.GetAsTime(maxStart);
+
+  std::unique_lock lock(m_critSection);
+  const std::string strQuery =
+      PrepareSQL("SELECT idBroadcast, iStartTime, iContentHash "
+                 "FROM epgtags "
+                 "WHERE idEpg = %u AND iEndTime >= %u AND iStartTime <= %u;",
+                 iEpgID, static_cast<unsigned int>(minEnd), static_cast<unsigned int>(maxStart));
+
+  std::map<CDateTime, EpgTagContentHash> hashes;
+  if (ResultQuery(strQuery))
+  {
+    try
+    {
+      while (!m_pDS->eof())
+      {
+        const CDateTime startTime(static_cast<time_t>(m_pDS->fv("iStartTime").get_asInt()));
+        const auto iContentHash{static_cast<uint32_t>(m_pDS->fv("iContentHash").get_asInt())};
+        hashes.try_emplace(startTime,
+                           EpgTagContentHash{m_pDS->fv("idBroadcast").get_asInt(), iContentHash});
+        m_pDS->next();
+      }
+      m_pDS->close();
+    }
+    catch (...)
+    {
+      CLog::LogF(LOGERROR,
+                 "Could not load tag hashes with min end time ({}) and max start time ({}) for "
+                 "EPG ({})",
+                 minEndTime.GetAsDBDateTime(), maxStartTime.GetAsDBDateTime(), iEpgID);
+      hashes.clear();
+    }
+  }
+
+  return hashes;
+}
+
 bool CPVREpgDatabase::QueueDeleteEpgTagsByMinEndMaxStartTimeQuery(int iEpgID,
                                                                   const CDateTime& minEndTime,
                                                                   const CDateTime& maxStartTime)
@@ -1297,6 +1302,8 @@ bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
     sFirstAired = tag.FirstAired().GetAsW3CDate();
 
   int iBroadcastId = tag.DatabaseID();
+  // stored signed, integer columns are 32 bit on MySQL
+  const int iContentHash = static_cast<int>(tag.ContentHash());
   std::string strQuery;
 
   std::unique_lock lock(m_critSection);
@@ -1310,9 +1317,10 @@ bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
         "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, "
         "iSeriesId, "
         "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, sParentalRatingCode, "
-        "iBroadcastUid, sParentalRatingIcon, sParentalRatingSource, sTitleExtraInfo) "
+        "iBroadcastUid, sParentalRatingIcon, sParentalRatingSource, sTitleExtraInfo, "
+        "iContentHash) "
         "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, "
-        "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i, '%s', '%s', '%s');",
+        "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i, '%s', '%s', '%s', %i);",
         tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
         tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
         tag.OriginalTitle().c_str(), CPVREpgInfoTag::DeTokenize(tag.Cast()).c_str(),
@@ -1323,7 +1331,7 @@ bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
         tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(),
         tag.Flags(), tag.SeriesLink().c_str(), tag.ParentalRatingCode().c_str(),
         tag.UniqueBroadcastID(), tag.ClientParentalRatingIconPath().c_str(),
-        tag.ParentalRatingSource().c_str(), tag.TitleExtraInfo().c_str());
+        tag.ParentalRatingSource().c_str(), tag.TitleExtraInfo().c_str(), iContentHash);
   }
   else
   {
@@ -1334,9 +1342,10 @@ bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
         "sIconPath, iGenreType, iGenreSubType, sGenre, sFirstAired, iParentalRating, iStarRating, "
         "iSeriesId, "
         "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, sParentalRatingCode, "
-        "iBroadcastUid, idBroadcast, sParentalRatingIcon, sParentalRatingSource, sTitleExtraInfo) "
+        "iBroadcastUid, idBroadcast, sParentalRatingIcon, sParentalRatingSource, sTitleExtraInfo, "
+        "iContentHash) "
         "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, "
-        "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i, %i, '%s', '%s', '%s');",
+        "'%s', '%s', %i, %i, %i, %i, %i, '%s', %i, '%s', '%s', %i, %i, '%s', '%s', '%s', %i);",
         tag.EpgID(), static_cast<unsigned int>(iStartTime), static_cast<unsigned int>(iEndTime),
         tag.Title().c_str(), tag.PlotOutline().c_str(), tag.Plot().c_str(),
         tag.OriginalTitle().c_str(), CPVREpgInfoTag::DeTokenize(tag.Cast()).c_str(),
@@ -1347,7 +1356,7 @@ bool CPVREpgDatabase::QueuePersistQuery(const CPVREpgInfoTag& tag)
         tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(),
         tag.Flags(), tag.SeriesLink().c_str(), tag.ParentalRatingCode().c_str(),
         tag.UniqueBroadcastID(), iBroadcastId, tag.ClientParentalRatingIconPath().c_str(),
-        tag.ParentalRatingSource().c_str(), tag.TitleExtraInfo().c_str());
+        tag.ParentalRatingSource().c_str(), tag.TitleExtraInfo().c_str(), iContentHash);
   }
 
   QueueInsertQuery(strQuery);
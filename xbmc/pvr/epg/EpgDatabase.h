@@ -11,6 +11,8 @@
 #include "dbwrappers/Database.h"
 #include "threads/CriticalSection.h"
 
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -66,7 +68,7 @@ public:
    * @brief Get the minimal database version that is required to operate correctly.
    * @return The minimal database version.
    */
-  int GetSchemaVersion() const override { return 20; }
+  int GetSchemaVersion() const override { return 22; }
 
   /*!
    * @brief Get the default sqlite database filename.
@@ -192,8 +194,8 @@ public:
    * @param startTime The start time for the tag to get.
    * @return The tag or nullptr, if not found.
    */
-  std::shared_ptr<CPVREpgInfoTag> GetEpgTagByStartTime(int iEpgID,
-                                                       const CDateTime& startTime) const;
+  virtual std::shared_ptr<CPVREpgInfoTag> GetEpgTagByStartTime(int iEpgID,
+                                                               const CDateTime& startTime) const;
 
   /*!
    * @brief Get the next EPG tag matching the given EPG id and min start time.
@@ -233,6 +235,26 @@ public:
   std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEpgTagsByMinEndMaxStartTime(
       int iEpgID, const CDateTime& minEndTime, const CDateTime& maxStartTime) const;
 
+  /*!
+   * @brief Database id and content hash of a stored EPG tag.
+   */
+  struct EpgTagContentHash
+  {
+    int iDatabaseID;
+    uint32_t iContentHash;
+  };
+
+  /*!
+   * @brief Get database ids and content hashes of all EPG tags matching the given EPG id, min end
+   * time and max start time, without loading the tags themselves.
+   * @param iEpgID The ID of the EPG for the tags to get.
+   * @param minEndTime The min end time for the tags to get.
+   * @param maxStartTime The max start time for the tags to get.
+   * @return The ids and hashes by tag start time or empty map, if no tags were found.
+   */
+  virtual std::map<CDateTime, EpgTagContentHash> GetEpgTagContentHashesByMinEndMaxStartTime(
+      int iEpgID, const CDateTime& minEndTime, const CDateTime& maxStartTime) const;
+
   /*!
    * @brief Write the query to delete all EPG tags in range of given EPG id, min end time and max
    * start time to db query queue. .
@@ -370,6 +392,11 @@ private:
    */
   void CreateAnalytics() override;
 
+  /*!
+   * @brief Create the full-text index used to search EPG tags, if supported by the database.
+   */
+  void CreateFullTextIndex();
+
   /*!
    * @brief Update an old version of the database.
    * @param version The version to update the database from.
@@ -384,5 +411,6 @@ private:
                                                              dbiplus::Dataset& ds) const;
 
   mutable CCriticalSection m_critSection;
+  bool m_bHasFullTextIndex = false;
 };
 } // namespace PVR
@@ -19,6 +19,7 @@
 #include "pvr/epg/EpgGuidePath.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
+#include "utils/Crc32.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -302,6 +303,11 @@ int CPVREpgInfoTag::DatabaseID() const
   return m_iDatabaseID;
 }
 
+void CPVREpgInfoTag::SetDatabaseID(int iDatabaseID)
+{
+  m_iDatabaseID = iDatabaseID;
+}
+
 int CPVREpgInfoTag::UniqueChannelID() const
 {
   std::unique_lock lock(m_critSection);
@@ -545,6 +551,60 @@ bool CPVREpgInfoTag::Update(const CPVREpgInfoTag& tag, bool bUpdateBroadcastId /
   return bChanged;
 }
 
+uint32_t CPVREpgInfoTag::ContentHash() const
+{
+  Crc32 crc;
+  const auto addString = [&crc](const std::string& value)
+  { crc.Compute(value.c_str(), value.size() + 1); }; // including the terminator as separator
+  const auto addStrings = [&addString](const std::vector<std::string>& values)
+  {
+    for (const auto& value : values)
+      addString(value);
+    addString("");
+  };
+  const auto addInt = [&crc](int64_t value)
+  { crc.Compute(reinterpret_cast<const char*>(&value), sizeof(value)); };
+  const auto addTime = [&addInt](const CDateTime& value)
+  {
+    time_t time{0};
+    if (value.IsValid())
+      value.GetAsTime(time);
+    addInt(static_cast<int64_t>(time));
+  };
+
+  std::unique_lock lock(m_critSection);
+  addString(m_strTitle);
+  addString(m_titleExtraInfo);
+  addString(m_strPlotOutline);
+  addString(m_strPlot);
+  addString(m_strOriginalTitle);
+  addStrings(m_cast);
+  addStrings(m_directors);
+  addStrings(m_writers);
+  addInt(m_iYear);
+  addString(m_strIMDBNumber);
+  addTime(m_startTime);
+  addTime(m_endTime);
+  addInt(m_iGenreType);
+  addInt(m_iGenreSubType);
+  addString(m_strGenreDescription);
+  addTime(m_firstAired);
+  addInt(m_parentalRating);
+  addString(m_parentalRatingCode);
+  addString(m_parentalRatingIcon.GetClientImage());
+  addString(m_parentalRatingSource);
+  addInt(m_iStarRating);
+  addInt(m_iEpisodeNumber);
+  addInt(m_iEpisodePart);
+  addInt(m_iSeriesNumber);
+  addString(m_strEpisodeName);
+  addInt(m_iUniqueBroadcastID);
+  addString(m_iconPath.GetClientImage());
+  addInt(m_iFlags);
+  addString(m_strSeriesLink);
+  return crc;
+}
+
 bool CPVREpgInfoTag::QueuePersistQuery(const std::shared_ptr<CPVREpgDatabase>& database) const
 {
   if (!database)
@@ -13,6 +13,7 @@
 #include "threads/CriticalSection.h"
 #include "utils/ISerializable.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -150,6 +151,12 @@ public:
    */
   int DatabaseID() const;
 
+  /*!
+   * @brief Set the event's database ID.
+   * @param iDatabaseID The database ID.
+   */
+  void SetDatabaseID(int iDatabaseID);
+
   /*!
    * @brief Get the unique ID of the channel associated with this event.
    * @return The unique channel ID.
@@ -427,6 +434,12 @@ public:
    */
   bool Update(const CPVREpgInfoTag& tag, bool bUpdateBroadcastId = true);
 
+  /*!
+   * @brief Get a hash over the data of this event that is stored in the database.
+   * @return The hash. EPG id and channel data are not part of it.
+   */
+  uint32_t ContentHash() const;
+
   /*!
    * @brief Retrieve the edit decision list (EDL) of an EPG tag.
    * @return The edit decision list (empty on error)
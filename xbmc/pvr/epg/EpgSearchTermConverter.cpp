@@ -0,0 +1,195 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgSearchTermConverter.h"
+
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+
+using namespace PVR;
+
+CPVREpgSearchTermConverter::CPVREpgSearchTermConverter(const std::string& strSearchTerm)
+{
+  Parse(strSearchTerm);
+}
+
+std::string CPVREpgSearchTermConverter::ToFullTextQuery(std::string_view strFieldName) const
+{
+  return StringUtils::Format("{} : ({})", strFieldName, m_fullText);
+}
+
+std::string CPVREpgSearchTermConverter::ToSQL(std::string_view strFieldName) const
+{
+  std::string result = "(";
+
+  for (auto it = m_fragments.cbegin(); it != m_fragments.cend();)
+  {
+    result += (*it);
+
+    ++it;
+    if (it != m_fragments.cend())
+      result += strFieldName;
+  }
+
+  StringUtils::TrimRight(result);
+  result += ")";
+  return result;
+}
+
+void CPVREpgSearchTermConverter::Parse(const std::string& strSearchTerm)
+{
+  std::string strParsedSearchTerm(strSearchTerm);
+  StringUtils::Trim(strParsedSearchTerm);
+
+  std::string strFragment;
+
+  bool bNextOR = false;
+  while (!strParsedSearchTerm.empty())
+  {
+    StringUtils::TrimLeft(strParsedSearchTerm);
+
+    if (StringUtils::StartsWith(strParsedSearchTerm, "!") ||
+        StringUtils::StartsWithNoCase(strParsedSearchTerm, "not"))
+    {
+      std::string strDummy;
+      GetAndCutNextTerm(strParsedSearchTerm, strDummy);
+      strFragment += " NOT ";
+      AddFullTextOperator(FullTextOperator::NOT);
+      bNextOR = false;
+    }
+    else if (StringUtils::StartsWith(strParsedSearchTerm, "+") ||
+             StringUtils::StartsWithNoCase(strParsedSearchTerm, "and"))
+    {
+      std::string strDummy;
+      GetAndCutNextTerm(strParsedSearchTerm, strDummy);
+      strFragment += " AND ";
+      AddFullTextOperator(FullTextOperator::AND);
+      bNextOR = false;
+    }
+    else if (StringUtils::StartsWith(strParsedSearchTerm, "|") ||
+             StringUtils::StartsWithNoCase(strParsedSearchTerm, "or"))
+    {
+      std::string strDummy;
+      GetAndCutNextTerm(strParsedSearchTerm, strDummy);
+      strFragment += " OR ";
+      AddFullTextOperator(FullTextOperator::OR);
+      bNextOR = false;
+    }
+    else
+    {
+      std::string strTerm;
+      GetAndCutNextTerm(strParsedSearchTerm, strTerm);
+      if (!strTerm.empty())
+      {
+        AddFullTextTerm(strTerm);
+
+        if (bNextOR && !m_fragments.empty())
+          strFragment += " OR "; // default operator
+
+        strFragment += "(UPPER(";
+
+        m_fragments.emplace_back(strFragment);
+        strFragment.clear();
+
+        strFragment += ") LIKE UPPER('%";
+        StringUtils::Replace(strTerm, "'", "''"); // escape '
+        strFragment += strTerm;
+        strFragment += "%')) ";
+
+        bNextOR = true;
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    StringUtils::TrimLeft(strParsedSearchTerm);
+  }
+
+  if (!strFragment.empty())
+    m_fragments.emplace_back(strFragment);
+
+  if (m_fullTextOperator != FullTextOperator::NONE)
+    m_bFullTextUsable = false; // dangling operator
+}
+
+void CPVREpgSearchTermConverter::AddFullTextOperator(FullTextOperator op)
+{
+  if (m_fullTextOperator == FullTextOperator::NONE)
+    m_fullTextOperator = op;
+  else if (m_fullTextOperator == FullTextOperator::AND && op == FullTextOperator::NOT)
+    m_fullTextOperator = FullTextOperator::AND_NOT;
+  else
+    m_bFullTextUsable = false;
+}
+
+void CPVREpgSearchTermConverter::AddFullTextTerm(const std::string& strTerm)
+{
+  // trigrams cannot match anything shorter than three characters
+  const auto chars = std::ranges::count_if(strTerm, [](char c) { return (c & 0xC0) != 0x80; });
+  if (chars < 3)
+    m_bFullTextUsable = false;
+
+  if (m_fullText.empty())
+  {
+    // FTS5 has no unary NOT
+    if (m_fullTextOperator != FullTextOperator::NONE)
+      m_bFullTextUsable = false;
+  }
+  else
+  {
+    switch (m_fullTextOperator)
+    {
+      case FullTextOperator::NONE:
+      case FullTextOperator::OR:
+        m_fullText += " OR ";
+        break;
+      case FullTextOperator::AND:
+        m_fullText += " AND ";
+        break;
+      case FullTextOperator::AND_NOT:
+        m_fullText += " NOT "; // binary in FTS5: "a AND NOT b" is "a NOT b"
+        break;
+      case FullTextOperator::NOT:
+        m_bFullTextUsable = false;
+        break;
+    }
+  }
+
+  // terms are matched as quoted strings, so operators and special characters are taken literally
+  std::string strQuoted{strTerm};
+  StringUtils::Replace(strQuoted, "\"", "\"\"");
+  m_fullText += "\"" + strQuoted + "\"";
+  m_fullTextOperator = FullTextOperator::NONE;
+}
+
+void CPVREpgSearchTermConverter::GetAndCutNextTerm(std::string& strSearchTerm,
+                                                   std::string& strNextTerm)
+{
+  std::string strFindNext(" ");
+
+  if (StringUtils::StartsWith(strSearchTerm, "\""))
+  {
+    strSearchTerm.erase(0, 1);
+    strFindNext = "\"";
+  }
+
+  const size_t iNextPos = strSearchTerm.find(strFindNext);
+  if (iNextPos != std::string::npos)
+  {
+    strNextTerm = strSearchTerm.substr(0, iNextPos);
+    strSearchTerm.erase(0, iNextPos + 1);
+  }
+  else
+  {
+    strNextTerm = strSearchTerm;
+    strSearchTerm.clear();
+  }
+}
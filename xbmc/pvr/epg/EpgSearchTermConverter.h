@@ -0,0 +1,58 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PVR
+{
+/*!
+ * @brief Converts an EPG search term ("a b", "a AND NOT b", "a | \"b c\"", ...) to a SQL LIKE
+ * condition and, where possible, to an FTS5 query for the epgtags full-text index.
+ */
+class CPVREpgSearchTermConverter
+{
+public:
+  explicit CPVREpgSearchTermConverter(const std::string& strSearchTerm);
+
+  bool HasSearchTerm() const { return !m_fragments.empty(); }
+
+  /*!
+   * @brief Check whether the term can be answered from the trigram FTS5 index.
+   * @return False for terms shorter than three characters, a leading NOT, "OR NOT" and dangling
+   * operators. Those have to use ToSQL().
+   */
+  bool CanUseFullTextIndex() const { return m_bFullTextUsable && !m_fullText.empty(); }
+
+  std::string ToFullTextQuery(std::string_view strFieldName) const;
+  std::string ToSQL(std::string_view strFieldName) const;
+
+private:
+  enum class FullTextOperator
+  {
+    NONE,
+    AND,
+    OR,
+    NOT,
+    AND_NOT,
+  };
+
+  void Parse(const std::string& strSearchTerm);
+  void AddFullTextOperator(FullTextOperator op);
+  void AddFullTextTerm(const std::string& strTerm);
+  static void GetAndCutNextTerm(std::string& strSearchTerm, std::string& strNextTerm);
+
+  std::vector<std::string> m_fragments;
+  std::string m_fullText;
+  FullTextOperator m_fullTextOperator{FullTextOperator::NONE};
+  bool m_bFullTextUsable{true};
+};
+} // namespace PVR
@@ -141,53 +141,77 @@ bool CPVREpgTagsContainer::UpdateEntries(const CPVREpgTagsContainer& tags)
     const CDateTime minEventEnd = (*tags.m_changedTags.cbegin()).second->StartAsUTC() + ONE_SECOND;
     const CDateTime maxEventStart = (*tags.m_changedTags.crbegin()).second->EndAsUTC();
 
-    std::vector<std::shared_ptr<CPVREpgInfoTag>> existingTags =
-        m_database->GetEpgTagsByMinEndMaxStartTime(m_iEpgID, minEventEnd, maxEventStart);
-
-    if (!m_changedTags.empty())
-    {
-      // Fix data inconsistencies
-      for (const auto& [_, tag] : m_changedTags)
-      {
-        if (tag->EndAsUTC() > minEventEnd && tag->StartAsUTC() < maxEventStart)
-        {
-          // tag is in queried range, thus it could cause inconsistencies...
-          ResolveConflictingTags(tag, existingTags);
-        }
-      }
-    }
-
-    bool bResetCache = false;
-    for (const auto& [_, tag] : tags.m_changedTags)
+    // Ids and content hashes are enough to find out what changed, loading the stored tags is much
+    // more expensive.
+    const std::map<CDateTime, CPVREpgDatabase::EpgTagContentHash> storedTags =
+        m_database->GetEpgTagContentHashesByMinEndMaxStartTime(m_iEpgID, minEventEnd,
+                                                               maxEventStart);
+
+    unsigned int iNew = 0;
+    unsigned int iChanged = 0;
+    unsigned int iUnchanged = 0;
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> unchangedTags;
+    for (const auto& [startTime, tag] : tags.m_changedTags)
     {
       tag->SetChannelData(m_channelData);
       tag->SetEpgID(m_iEpgID);
 
-      const auto it = std::ranges::find_if(existingTags, [&tag](const auto& t)
-                                           { return t->StartAsUTC() == tag->StartAsUTC(); });
-
-      if (it != existingTags.cend())
+      const auto changedIt = m_changedTags.find(startTime);
+      if (changedIt != m_changedTags.cend())
       {
-        const std::shared_ptr<CPVREpgInfoTag>& existingTag = *it;
+        // not yet persisted; the stored tag, if any, is outdated anyway
+        if (changedIt->second->Update(*tag, false))
+          iChanged++;
+        else
+          iUnchanged++;
 
-        existingTag->SetChannelData(m_channelData);
-        existingTag->SetEpgID(m_iEpgID);
+        continue;
+      }
 
-        if (existingTag->Update(*tag, false))
-        {
-          // tag differs from existing tag and must be persisted
-          m_changedTags.try_emplace(existingTag->StartAsUTC(), existingTag);
-          bResetCache = true;
-        }
+      const auto storedIt = storedTags.find(startTime);
+      if (storedIt == storedTags.cend())
+      {
+        // new tags must always be persisted
+        m_changedTags.try_emplace(startTime, tag);
+        iNew++;
       }
       else
       {
-        // new tags must always be persisted
-        m_changedTags.try_emplace(tag->StartAsUTC(), tag);
-        bResetCache = true;
+        tag->SetDatabaseID(storedIt->second.iDatabaseID);
+        if (storedIt->second.iContentHash != tag->ContentHash())
+        {
+          // tag differs from stored tag and must be persisted
+          m_changedTags.try_emplace(startTime, tag);
+          iChanged++;
+        }
+        else
+        {
+          unchangedTags.emplace_back(tag);
+        }
       }
     }
 
+    // Persisting a changed tag deletes the stored tags it overlaps, so those must be persisted,
+    // too. Only checked now that all changed tags are known, they may start after this one.
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> overlappingTags;
+    for (const auto& tag : unchangedTags)
+    {
+      if (OverlapsChangedTag(*tag))
+        overlappingTags.emplace_back(tag);
+      else
+        iUnchanged++;
+    }
+    for (const auto& tag : overlappingTags)
+    {
+      m_changedTags.try_emplace(tag->StartAsUTC(), tag);
+      iChanged++;
+    }
+
+    CLog::LogFC(LOGDEBUG, LOGEPG,
+                "EPG Tags Container: Update of EPG {}: {} new, {} changed, {} unchanged events",
+                m_iEpgID, iNew, iChanged, iUnchanged);
+
+    const bool bResetCache = (iNew + iChanged) > 0;
     if (bResetCache)
       m_tagsCache->Reset();
   }
@@ -290,6 +314,17 @@ bool CPVREpgTagsContainer::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& ta
   return true;
 }
 
+bool CPVREpgTagsContainer::OverlapsChangedTag(const CPVREpgInfoTag& tag) const
+{
+  // the last changed tag starting before the given one ends
+  auto it = m_changedTags.lower_bound(tag.EndAsUTC());
+  if (it == m_changedTags.cbegin())
+    return false;
+
+  --it;
+  return it->second->EndAsUTC() > tag.StartAsUTC();
+}
+
 bool CPVREpgTagsContainer::DeleteEntry(const std::shared_ptr<CPVREpgInfoTag>& tag)
 {
   m_changedTags.erase(tag->StartAsUTC());
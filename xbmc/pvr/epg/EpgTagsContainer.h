@@ -175,6 +175,13 @@ public:
   void QueueDelete();
 
 private:
+  /*!
+   * @brief Check whether the given tag overlaps one of the changed tags.
+   * @param tag The tag to check.
+   * @return True if it overlaps a changed tag, false otherwise.
+   */
+  bool OverlapsChangedTag(const CPVREpgInfoTag& tag) const;
+
   /*!
    * @brief Complete the instance data for the given tags.
    * @param tags The tags to complete.
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/epg/EpgSearchTermConverter.h"
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+TEST(TestEpgSearchTermConverter, Empty)
+{
+  const CPVREpgSearchTermConverter conv("  ");
+
+  EXPECT_FALSE(conv.HasSearchTerm());
+  EXPECT_FALSE(conv.CanUseFullTextIndex());
+}
+
+TEST(TestEpgSearchTermConverter, SingleTerm)
+{
+  const CPVREpgSearchTermConverter conv("Simpsons");
+
+  EXPECT_TRUE(conv.HasSearchTerm());
+  EXPECT_TRUE(conv.CanUseFullTextIndex());
+  EXPECT_EQ(conv.ToFullTextQuery("sTitle"), "sTitle : (\"Simpsons\")");
+  EXPECT_EQ(conv.ToSQL("sTitle"), "((UPPER(sTitle) LIKE UPPER('%Simpsons%')))");
+}
+
+TEST(TestEpgSearchTermConverter, DefaultOperatorIsOr)
+{
+  const CPVREpgSearchTermConverter conv("foo bar");
+
+  EXPECT_TRUE(conv.CanUseFullTextIndex());
+  EXPECT_EQ(conv.ToFullTextQuery("sTitle"), "sTitle : (\"foo\" OR \"bar\")");
+  EXPECT_EQ(conv.ToSQL("sTitle"),
+            "((UPPER(sTitle) LIKE UPPER('%foo%'))  OR (UPPER(sTitle) LIKE UPPER('%bar%')))");
+}
+
+TEST(TestEpgSearchTermConverter, Operators)
+{
+  EXPECT_EQ(CPVREpgSearchTermConverter("foo AND bar").ToFullTextQuery("sTitle"),
+            "sTitle : (\"foo\" AND \"bar\")");
+  EXPECT_EQ(CPVREpgSearchTermConverter("foo + bar").ToFullTextQuery("sTitle"),
+            "sTitle : (\"foo\" AND \"bar\")");
+  EXPECT_EQ(CPVREpgSearchTermConverter("foo OR bar").ToFullTextQuery("sTitle"),
+            "sTitle : (\"foo\" OR \"bar\")");
+  EXPECT_EQ(CPVREpgSearchTermConverter("foo | bar").ToFullTextQuery("sTitle"),
+            "sTitle : (\"foo\" OR \"bar\")");
+}
+
+TEST(TestEpgSearchTermConverter, AndNotIsBinaryNot)
+{
+  const CPVREpgSearchTermConverter conv("foo AND NOT bar");
+
+  EXPECT_TRUE(conv.CanUseFullTextIndex());
+  EXPECT_EQ(conv.ToFullTextQuery("sTitle"), "sTitle : (\"foo\" NOT \"bar\")");
+  EXPECT_EQ(conv.ToSQL("sTitle"),
+            "((UPPER(sTitle) LIKE UPPER('%foo%'))  AND  NOT (UPPER(sTitle) LIKE UPPER('%bar%')))");
+}
+
+TEST(TestEpgSearchTermConverter, UnsupportedOperatorsFallBackToLike)
+{
+  // FTS5 has neither a unary NOT nor OR NOT
+  EXPECT_FALSE(CPVREpgSearchTermConverter("NOT foo").CanUseFullTextIndex());
+  EXPECT_FALSE(CPVREpgSearchTermConverter("! foo").CanUseFullTextIndex());
+  EXPECT_FALSE(CPVREpgSearchTermConverter("foo OR NOT bar").CanUseFullTextIndex());
+
+  // dangling operator
+  const CPVREpgSearchTermConverter conv("foo AND");
+  EXPECT_TRUE(conv.HasSearchTerm());
+  EXPECT_FALSE(conv.CanUseFullTextIndex());
+}
+
+TEST(TestEpgSearchTermConverter, ShortTermsFallBackToLike)
+{
+  // trigrams can't match anything shorter than three characters
+  EXPECT_FALSE(CPVREpgSearchTermConverter("ab").CanUseFullTextIndex());
+  EXPECT_FALSE(CPVREpgSearchTermConverter("foo ab").CanUseFullTextIndex());
+  EXPECT_EQ(CPVREpgSearchTermConverter("ab").ToSQL("sTitle"),
+            "((UPPER(sTitle) LIKE UPPER('%ab%')))");
+
+  // characters are counted, not bytes
+  EXPECT_FALSE(CPVREpgSearchTermConverter("\xC3\xA4\xC3\xB6").CanUseFullTextIndex());
+  EXPECT_TRUE(CPVREpgSearchTermConverter("\xC3\xA4\xC3\xB6\xC3\xBC").CanUseFullTextIndex());
+}
+
+TEST(TestEpgSearchTermConverter, QuotedPhrase)
+{
+  const CPVREpgSearchTermConverter conv("foo \"bar baz\"");
+
+  EXPECT_TRUE(conv.CanUseFullTextIndex());
+  EXPECT_EQ(conv.ToFullTextQuery("sTitle"), "sTitle : (\"foo\" OR \"bar baz\")");
+  EXPECT_EQ(conv.ToSQL("sTitle"),
+            "((UPPER(sTitle) LIKE UPPER('%foo%'))  OR (UPPER(sTitle) LIKE UPPER('%bar baz%')))");
+}
+
+TEST(TestEpgSearchTermConverter, QuotesAreEscaped)
+{
+  const CPVREpgSearchTermConverter doubleQuote("ab\"cd");
+  EXPECT_EQ(doubleQuote.ToFullTextQuery("sTitle"), "sTitle : (\"ab\"\"cd\")");
+  EXPECT_EQ(doubleQuote.ToSQL("sTitle"), "((UPPER(sTitle) LIKE UPPER('%ab\"cd%')))");
+
+  const CPVREpgSearchTermConverter singleQuote("O'Brien");
+  EXPECT_EQ(singleQuote.ToFullTextQuery("sTitle"), "sTitle : (\"O'Brien\")");
+  EXPECT_EQ(singleQuote.ToSQL("sTitle"), "((UPPER(sTitle) LIKE UPPER('%O''Brien%')))");
+}
+
+TEST(TestEpgSearchTermConverter, WildcardsAndSyntaxAreLiteral)
+{
+  // FTS5 prefix queries and functions must not be interpreted, LIKE doesn't either
+  EXPECT_EQ(CPVREpgSearchTermConverter("star*").ToFullTextQuery("sTitle"),
+            "sTitle : (\"star*\")");
+  EXPECT_EQ(CPVREpgSearchTermConverter("NEAR(foo bar)").ToFullTextQuery("sTitle"),
+            "sTitle : (\"NEAR(foo\" OR \"bar)\")");
+}
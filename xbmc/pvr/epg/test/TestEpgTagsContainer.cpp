@@ -0,0 +1,157 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XBDateTime.h"
+#include "addons/kodi-dev-kit/include/kodi/c-api/addon-instance/pvr/pvr_epg.h"
+#include "pvr/epg/EpgDatabase.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgTagsContainer.h"
+
+#include <map>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+constexpr int EPG_ID = 1;
+constexpr time_t START = 1700000000;
+constexpr time_t HOUR = 60 * 60;
+
+std::shared_ptr<CPVREpgInfoTag> CreateTag(time_t start, time_t end, const char* title)
+{
+  EPG_TAG data{};
+  data.iUniqueBroadcastId = static_cast<unsigned int>(start);
+  data.strTitle = title;
+  data.startTime = start;
+  data.endTime = end;
+  return std::make_shared<CPVREpgInfoTag>(data, -1, nullptr, EPG_ID);
+}
+
+// Knows only ids and content hashes of its tags, like a database that was never opened
+class CTestEpgDatabase : public CPVREpgDatabase
+{
+public:
+  void AddStoredTag(const std::shared_ptr<CPVREpgInfoTag>& tag, int iDatabaseID)
+  {
+    m_storedTags.try_emplace(tag->StartAsUTC(), EpgTagContentHash{iDatabaseID, tag->ContentHash()});
+  }
+
+  std::map<CDateTime, EpgTagContentHash> GetEpgTagContentHashesByMinEndMaxStartTime(
+      int iEpgID, const CDateTime& minEndTime, const CDateTime& maxStartTime) const override
+  {
+    return m_storedTags;
+  }
+
+  std::shared_ptr<CPVREpgInfoTag> GetEpgTagByStartTime(int iEpgID,
+                                                       const CDateTime& startTime) const override
+  {
+    return {};
+  }
+
+private:
+  std::map<CDateTime, EpgTagContentHash> m_storedTags;
+};
+
+class TestEpgTagsContainer : public testing::Test
+{
+protected:
+  TestEpgTagsContainer()
+    : m_database(std::make_shared<CTestEpgDatabase>()),
+      m_container(EPG_ID, nullptr, m_database),
+      m_update(EPG_ID, nullptr, nullptr)
+  {
+    // stored: 0-1 "A" (id 1), 1-2 "B" (id 2), 2-3 "C" (id 3)
+    m_database->AddStoredTag(CreateTag(START, START + HOUR, "A"), 1);
+    m_database->AddStoredTag(CreateTag(START + HOUR, START + 2 * HOUR, "B"), 2);
+    m_database->AddStoredTag(CreateTag(START + 2 * HOUR, START + 3 * HOUR, "C"), 3);
+  }
+
+  //! whether the update queued the tag starting at the given time for persisting
+  bool IsQueued(time_t start) const { return m_container.GetTag(CDateTime(start)) != nullptr; }
+
+  std::shared_ptr<CTestEpgDatabase> m_database;
+  CPVREpgTagsContainer m_container;
+  CPVREpgTagsContainer m_update;
+};
+} // namespace
+
+TEST(TestEpgInfoTag, ContentHash)
+{
+  const auto tag = CreateTag(START, START + HOUR, "A");
+
+  EXPECT_EQ(tag->ContentHash(), CreateTag(START, START + HOUR, "A")->ContentHash());
+  EXPECT_NE(tag->ContentHash(), CreateTag(START, START + HOUR, "B")->ContentHash());
+  EXPECT_NE(tag->ContentHash(), CreateTag(START, START + 2 * HOUR, "A")->ContentHash());
+
+  // not part of the persisted data
+  const uint32_t hash = tag->ContentHash();
+  tag->SetDatabaseID(42);
+  EXPECT_EQ(hash, tag->ContentHash());
+}
+
+TEST_F(TestEpgTagsContainer, UnchangedTagsAreSkipped)
+{
+  m_update.UpdateEntry(CreateTag(START, START + HOUR, "A"));
+  m_update.UpdateEntry(CreateTag(START + HOUR, START + 2 * HOUR, "B"));
+  m_update.UpdateEntry(CreateTag(START + 2 * HOUR, START + 3 * HOUR, "C"));
+
+  EXPECT_TRUE(m_container.UpdateEntries(m_update));
+  EXPECT_FALSE(m_container.NeedsSave());
+}
+
+TEST_F(TestEpgTagsContainer, ChangedAndNewTagsArePersisted)
+{
+  m_update.UpdateEntry(CreateTag(START, START + HOUR, "A"));
+  m_update.UpdateEntry(CreateTag(START + HOUR, START + 2 * HOUR, "B changed"));
+  m_update.UpdateEntry(CreateTag(START + 2 * HOUR, START + 3 * HOUR, "C"));
+  m_update.UpdateEntry(CreateTag(START + 3 * HOUR, START + 4 * HOUR, "D"));
+
+  EXPECT_TRUE(m_container.UpdateEntries(m_update));
+
+  EXPECT_FALSE(IsQueued(START));
+  ASSERT_TRUE(IsQueued(START + HOUR));
+  EXPECT_FALSE(IsQueued(START + 2 * HOUR));
+  ASSERT_TRUE(IsQueued(START + 3 * HOUR));
+
+  // a changed tag replaces the stored one
+  EXPECT_EQ(m_container.GetTag(CDateTime(START + HOUR))->DatabaseID(), 2);
+  EXPECT_EQ(m_container.GetTag(CDateTime(START + 3 * HOUR))->DatabaseID(), -1);
+}
+
+TEST_F(TestEpgTagsContainer, UnchangedTagOverlappingLaterChangedTagIsPersisted)
+{
+  // "A" is unchanged, but the new "X" starting within it will delete it when persisted
+  m_update.UpdateEntry(CreateTag(START, START + HOUR, "A"));
+  m_update.UpdateEntry(CreateTag(START + HOUR / 2, START + 2 * HOUR, "X"));
+  m_update.UpdateEntry(CreateTag(START + 2 * HOUR, START + 3 * HOUR, "C"));
+
+  EXPECT_TRUE(m_container.UpdateEntries(m_update));
+
+  ASSERT_TRUE(IsQueued(START));
+  EXPECT_EQ(m_container.GetTag(CDateTime(START))->DatabaseID(), 1);
+  EXPECT_TRUE(IsQueued(START + HOUR / 2));
+  EXPECT_FALSE(IsQueued(START + 2 * HOUR));
+}
+
+TEST_F(TestEpgTagsContainer, UnchangedTagOverlappingEarlierChangedTagIsPersisted)
+{
+  // "A" now ends within "B", which is unchanged
+  m_update.UpdateEntry(CreateTag(START, START + HOUR + HOUR / 2, "A"));
+  m_update.UpdateEntry(CreateTag(START + HOUR, START + 2 * HOUR, "B"));
+  m_update.UpdateEntry(CreateTag(START + 2 * HOUR, START + 3 * HOUR, "C"));
+
+  EXPECT_TRUE(m_container.UpdateEntries(m_update));
+
+  EXPECT_TRUE(IsQueued(START));
+  ASSERT_TRUE(IsQueued(START + HOUR));
+  EXPECT_EQ(m_container.GetTag(CDateTime(START + HOUR))->DatabaseID(), 2);
+  EXPECT_FALSE(IsQueued(START + 2 * HOUR));
+}
@@ -17,12 +17,14 @@
 #include "pvr/epg/EpgChannelData.h"
 #include "pvr/epg/EpgContainer.h"
 #include "pvr/epg/EpgInfoTag.h"
+#include "jobs/JobManager.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
 #include <algorithm>
 #include <cmath>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 using namespace PVR;
@@ -41,7 +43,10 @@ void CGUIEPGGridContainerModel::SetInvalid() const
   for (const auto& channel : m_channelItems)
     channel->SetInvalid();
   for (const auto& ruler : m_rulerItems)
-    ruler->SetInvalid();
+  {
+    if (ruler)
+      ruler->SetInvalid();
+  }
 }
 
 std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateGapItem(int iChannel) const
@@ -52,23 +57,124 @@ std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateGapItem(int iChannel
   return std::make_shared<CFileItem>(gapTag);
 }
 
-std::vector<std::shared_ptr<CPVREpgInfoTag>> CGUIEPGGridContainerModel::GetEPGTimeline(
-    int iChannel, const CDateTime& minEventEnd, const CDateTime& maxEventStart) const
+void CGUIEPGGridContainerModel::GetEPGTimelineRange(const CDateTime& minEventEnd,
+                                                    const CDateTime& maxEventStart,
+                                                    CDateTime& min,
+                                                    CDateTime& max) const
 {
-  CDateTime min =
-      minEventEnd - CDateTimeSpan(0, 0, m_minutesPerBlock, 0) + CDateTimeSpan(0, 0, 0, 1);
-  CDateTime max = maxEventStart + CDateTimeSpan(0, 0, m_minutesPerBlock, 0);
+  min = minEventEnd - CDateTimeSpan(0, 0, m_minutesPerBlock, 0) + CDateTimeSpan(0, 0, 0, 1);
+  max = maxEventStart + CDateTimeSpan(0, 0, m_minutesPerBlock, 0);
 
   if (min < m_gridStart)
     min = m_gridStart;
 
   if (max > m_gridEnd)
     max = m_gridEnd;
+}
+
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CGUIEPGGridContainerModel::GetEPGTimeline(
+    int iChannel, const CDateTime& minEventEnd, const CDateTime& maxEventStart) const
+{
+  CDateTime min;
+  CDateTime max;
+  GetEPGTimelineRange(minEventEnd, maxEventStart, min, max);
+
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+  if (GetPrefetchedEPGTimeline(iChannel, min, max, tags))
+    return tags;
 
   return m_channelItems[iChannel]->GetPVRChannelInfoTag()->GetEPGTimeline(m_gridStart, m_gridEnd,
                                                                           min, max);
 }
 
+bool CGUIEPGGridContainerModel::GetPrefetchedEPGTimeline(
+    int iChannel,
+    const CDateTime& min,
+    const CDateTime& max,
+    std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const
+{
+  std::unique_lock lock(m_prefetch->critSection);
+
+  const auto it = m_prefetch->timelines.find(iChannel);
+  if (it == m_prefetch->timelines.cend())
+    return false;
+
+  const PrefetchedTimeline& timeline = (*it).second;
+  if (timeline.min > min || timeline.max < max)
+    return false;
+
+  // Gap tags span from event to event, not from the boundaries of the requested range. Thus,
+  // the part of a wider timeline is the same as the timeline fetched for that part.
+  std::ranges::copy_if(timeline.tags, std::back_inserter(tags), [&min, &max](const auto& tag)
+                       { return tag->EndAsUTC() >= min && tag->StartAsUTC() <= max; });
+  return !tags.empty();
+}
+
+void CGUIEPGGridContainerModel::Prefetch(int firstChannel,
+                                         int lastChannel,
+                                         int firstBlock,
+                                         int lastBlock) const
+{
+  if (m_channelItems.empty())
+    return;
+
+  // Prefetch one page in every direction. Align the range to pages, so that it does not change
+  // (and does not need to be fetched again) with every channel or block scrolled.
+  const int channelsPerPage = std::max(lastChannel - firstChannel + 1, 1);
+  const int blocksPerPage = std::max(lastBlock - firstBlock + 1, 1);
+
+  const int pageChannel = (firstChannel / channelsPerPage) * channelsPerPage;
+  firstChannel = std::max(pageChannel - channelsPerPage, 0);
+  lastChannel = std::min(pageChannel + 2 * channelsPerPage - 1, GetLastChannel());
+
+  const int pageBlock = (firstBlock / blocksPerPage) * blocksPerPage;
+  firstBlock = std::max(pageBlock - blocksPerPage, 0);
+  lastBlock = std::min(pageBlock + 2 * blocksPerPage - 1, GetLastBlock());
+
+  CDateTime min;
+  CDateTime max;
+  GetEPGTimelineRange(GetStartTimeForBlock(firstBlock), GetStartTimeForBlock(lastBlock), min, max);
+
+  std::vector<std::pair<int, std::shared_ptr<const CPVRChannel>>> channels;
+  unsigned int generation = 0;
+  {
+    std::unique_lock lock(m_prefetch->critSection);
+
+    std::erase_if(m_prefetch->timelines,
+                  [firstChannel, lastChannel](const auto& entry)
+                  { return entry.first < firstChannel || entry.first > lastChannel; });
+
+    for (int i = firstChannel; i <= lastChannel; ++i)
+    {
+      const auto it = m_prefetch->timelines.find(i);
+      if (it == m_prefetch->timelines.cend() || (*it).second.min > min || (*it).second.max < max)
+        channels.emplace_back(i, m_channelItems[i]->GetPVRChannelInfoTag());
+    }
+
+    if (channels.empty())
+      return;
+
+    generation = ++m_prefetch->generation;
+  }
+
+  CServiceBroker::GetJobManager()->Submit(
+      [prefetch = m_prefetch, generation, channels = std::move(channels),
+       gridStart = m_gridStart, gridEnd = m_gridEnd, min, max]()
+      {
+        for (const auto& [iChannel, channel] : channels)
+        {
+          auto tags = channel->GetEPGTimeline(gridStart, gridEnd, min, max);
+
+          std::unique_lock lock(prefetch->critSection);
+          if (prefetch->generation != generation)
+            return; // superseded by a newer request
+
+          prefetch->timelines.insert_or_assign(iChannel,
+                                               PrefetchedTimeline{std::move(tags), min, max});
+        }
+      });
+}
+
 void CGUIEPGGridContainerModel::Initialize(const CFileItemList& items,
                                            const CDateTime& gridStart,
                                            const CDateTime& gridEnd,
@@ -86,6 +192,7 @@ void CGUIEPGGridContainerModel::Initialize(const CFileItemList& items,
   }
 
   m_fBlockSize = fBlockSize;
+  m_blocksPerRulerItem = blocksPerRulerItem;
 
   ////////////////////////////////////////////////////////////////////////
   // Create channel items
@@ -136,21 +243,41 @@ void CGUIEPGGridContainerModel::Initialize(const CFileItemList& items,
   rulerDateItem->SetProperty("DateLabel", true);
   m_rulerItems.emplace_back(std::move(rulerDateItem));
 
-  // 2) ruler time items
-  const CDateTimeSpan unit(0, 0, blocksPerRulerItem * m_minutesPerBlock, 0);
-  CDateTime rulerLocal;
-  for (CDateTime rulerUTC = m_gridStart; rulerUTC < m_gridEnd; rulerUTC += unit)
-  {
-    rulerLocal.SetFromUTCDateTime(rulerUTC);
-    auto rulerItem{std::make_shared<CFileItem>(rulerLocal.GetAsLocalizedTime("", false))};
-    rulerItem->SetLabel2(rulerLocal.GetAsLocalizedDate(true));
-    m_rulerItems.emplace_back(std::move(rulerItem));
-  }
+  // 2) ruler time items, created on demand
+  const int rulerItemMinutes = blocksPerRulerItem * static_cast<int>(m_minutesPerBlock);
+  const int gridMinutes = (m_gridEnd - m_gridStart).GetSecondsTotal() / 60;
+  m_rulerItems.resize(1 + (gridMinutes + rulerItemMinutes - 1) / rulerItemMinutes);
 
   m_firstActiveChannel = iFirstChannel;
   m_lastActiveChannel = iFirstChannel + iChannelsPerPage - 1;
   m_firstActiveBlock = iFirstBlock;
   m_lastActiveBlock = iFirstBlock + iBlocksPerPage - 1;
+
+  ////////////////////////////////////////////////////////////////////////
+  // Fetch the EPG of the first page. The model is usually initialized by the timeline refresh
+  // thread, so this does not have to be done by the GUI thread while rendering.
+  const int lastChannel = std::min(m_lastActiveChannel, GetLastChannel());
+  const int lastBlock = std::min(m_lastActiveBlock, GetLastBlock());
+  for (int i = m_firstActiveChannel; i <= lastChannel; ++i)
+    FetchEpgTags(m_epgItems[i], i, m_firstActiveBlock, lastBlock);
+
+  Prefetch(m_firstActiveChannel, lastChannel, m_firstActiveBlock, lastBlock);
+}
+
+std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::GetRulerItem(int iIndex) const
+{
+  std::shared_ptr<CFileItem>& item = m_rulerItems[iIndex];
+  if (!item)
+  {
+    const CDateTime rulerUTC =
+        m_gridStart +
+        CDateTimeSpan(0, 0, (iIndex - 1) * m_blocksPerRulerItem * m_minutesPerBlock, 0);
+    CDateTime rulerLocal;
+    rulerLocal.SetFromUTCDateTime(rulerUTC);
+    item = std::make_shared<CFileItem>(rulerLocal.GetAsLocalizedTime("", false));
+    item->SetLabel2(rulerLocal.GetAsLocalizedDate(true));
+  }
+  return item;
 }
 
 std::shared_ptr<CFileItem> CGUIEPGGridContainerModel::CreateEpgTags(int iChannel, int iBlock) const
@@ -542,9 +669,6 @@ bool CGUIEPGGridContainerModel::FreeProgrammeMemory(int firstChannel,
   if (blocksChanged || newChannels)
   {
     // clear and refetch epg tags for active channels
-    const CDateTime maxEnd = GetStartTimeForBlock(firstBlock);
-    const CDateTime minStart = GetStartTimeForBlock(lastBlock);
-    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
     for (int i = firstChannel; i <= lastChannel; ++i)
     {
       auto it = m_epgItems.find(i);
@@ -552,28 +676,7 @@ bool CGUIEPGGridContainerModel::FreeProgrammeMemory(int firstChannel,
         it = m_epgItems.try_emplace(i).first;
 
       if (blocksChanged || i < m_firstActiveChannel || i > m_lastActiveChannel)
-      {
-        EpgTags& epgTags = (*it).second;
-
-        (*it).second.tags.clear();
-
-        tags = GetEPGTimeline(i, maxEnd, minStart);
-        const int firstResultBlock = GetFirstEventBlock(tags.front());
-        const int lastResultBlock = GetLastEventBlock(tags.back());
-        if (firstResultBlock > lastResultBlock)
-          continue;
-
-        epgTags.firstBlock = firstResultBlock;
-        epgTags.lastBlock = lastResultBlock;
-
-        for (const auto& tag : tags)
-        {
-          if (GetFirstEventBlock(tag) > GetLastEventBlock(tag))
-            continue;
-
-          epgTags.tags.emplace_back(std::make_shared<CFileItem>(tag));
-        }
-      }
+        FetchEpgTags((*it).second, i, firstBlock, lastBlock);
     }
   }
 
@@ -582,18 +685,46 @@ bool CGUIEPGGridContainerModel::FreeProgrammeMemory(int firstChannel,
   m_firstActiveBlock = firstBlock;
   m_lastActiveBlock = lastBlock;
 
+  Prefetch(firstChannel, lastChannel, firstBlock, lastBlock);
+
   return true;
 }
 
+void CGUIEPGGridContainerModel::FetchEpgTags(EpgTags& epgTags,
+                                             int iChannel,
+                                             int firstBlock,
+                                             int lastBlock) const
+{
+  epgTags.tags.clear();
+
+  const auto tags =
+      GetEPGTimeline(iChannel, GetStartTimeForBlock(firstBlock), GetStartTimeForBlock(lastBlock));
+  const int firstResultBlock = GetFirstEventBlock(tags.front());
+  const int lastResultBlock = GetLastEventBlock(tags.back());
+  if (firstResultBlock > lastResultBlock)
+    return;
+
+  epgTags.firstBlock = firstResultBlock;
+  epgTags.lastBlock = lastResultBlock;
+
+  for (const auto& tag : tags)
+  {
+    if (GetFirstEventBlock(tag) > GetLastEventBlock(tag))
+      continue;
+
+    epgTags.tags.emplace_back(std::make_shared<CFileItem>(tag));
+  }
+}
+
 void CGUIEPGGridContainerModel::FreeRulerMemory(int keepStart, int keepEnd)
 {
   if (keepStart < keepEnd)
   {
-    // remove before keepStart and after keepEnd
+    // remove before keepStart and after keepEnd. they will be recreated on demand.
     for (int i = 1; i < keepStart && i < RulerItemsSize(); ++i)
-      m_rulerItems[i]->FreeMemory();
+      m_rulerItems[i].reset();
     for (int i = keepEnd + 1; i < RulerItemsSize(); ++i)
-      m_rulerItems[i]->FreeMemory();
+      m_rulerItems[i].reset();
   }
   else
   {
@@ -603,7 +734,7 @@ void CGUIEPGGridContainerModel::FreeRulerMemory(int keepStart, int keepEnd)
       if (i == 0)
         continue;
 
-      m_rulerItems[i]->FreeMemory();
+      m_rulerItems[i].reset();
     }
   }
 }
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "XBDateTime.h"
+#include "threads/CriticalSection.h"
 
 #include <functional>
 #include <map>
@@ -45,6 +46,7 @@ struct GridItem
   int endBlock = 0;
 };
 
+class CPVRChannel;
 class CPVREpgInfoTag;
 
 class CGUIEPGGridContainerModel
@@ -83,7 +85,7 @@ public:
     return m_channelItems.empty() ? -1 : static_cast<int>(m_channelItems.size()) - 1;
   }
 
-  std::shared_ptr<CFileItem> GetRulerItem(int iIndex) const { return m_rulerItems[iIndex]; }
+  std::shared_ptr<CFileItem> GetRulerItem(int iIndex) const;
   int RulerItemsSize() const { return static_cast<int>(m_rulerItems.size()); }
 
   int GridItemsSize() const { return m_blocks; }
@@ -124,6 +126,16 @@ private:
                                                               const CDateTime& minEventEnd,
                                                               const CDateTime& maxEventStart) const;
 
+  void GetEPGTimelineRange(const CDateTime& minEventEnd,
+                           const CDateTime& maxEventStart,
+                           CDateTime& min,
+                           CDateTime& max) const;
+  bool GetPrefetchedEPGTimeline(int iChannel,
+                                const CDateTime& min,
+                                const CDateTime& max,
+                                std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const;
+  void Prefetch(int firstChannel, int lastChannel, int firstBlock, int lastBlock) const;
+
   struct EpgTags
   {
     std::vector<std::shared_ptr<CFileItem>> tags;
@@ -139,6 +151,7 @@ private:
                                         int iBlock) const;
   std::shared_ptr<CFileItem> GetEpgTagsBefore(EpgTags& epgTags, int iChannel, int iBlock) const;
   std::shared_ptr<CFileItem> GetEpgTagsAfter(EpgTags& epgTags, int iChannel, int iBlock) const;
+  void FetchEpgTags(EpgTags& epgTags, int iChannel, int firstBlock, int lastBlock) const;
 
   mutable EpgTagsMap m_epgItems;
 
@@ -146,7 +159,25 @@ private:
   CDateTime m_gridEnd;
 
   std::vector<std::shared_ptr<CFileItem>> m_channelItems;
-  std::vector<std::shared_ptr<CFileItem>> m_rulerItems;
+  mutable std::vector<std::shared_ptr<CFileItem>> m_rulerItems; // created on demand
+  int m_blocksPerRulerItem = 1;
+
+  // EPG timelines of the channels and blocks around the active ones, fetched in the background
+  struct PrefetchedTimeline
+  {
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+    CDateTime min;
+    CDateTime max;
+  };
+
+  struct PrefetchState
+  {
+    CCriticalSection critSection;
+    unsigned int generation = 0;
+    std::unordered_map<int, PrefetchedTimeline> timelines;
+  };
+
+  std::shared_ptr<PrefetchState> m_prefetch{std::make_shared<PrefetchState>()};
 
   struct GridCoordinates
   {
@@ -246,6 +246,7 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
 
 bool CRenderSystemGL::DestroyRenderSystem()
 {
+  CGUITextureGL::DestroyStaticBuffers();
   if (m_vertexArray != GL_NONE)
   {
     glDeleteVertexArrays(1, &m_vertexArray);
@@ -276,6 +277,7 @@ bool CRenderSystemGL::BeginRender()
 
 bool CRenderSystemGL::EndRender()
 {
+  CGUITextureGL::FlushBatch();
   if (!m_bRenderCreated)
     return false;
 
@@ -284,6 +286,7 @@ bool CRenderSystemGL::EndRender()
 
 void CRenderSystemGL::InvalidateColorBuffer()
 {
+  CGUITextureGL::FlushBatch();
   if (!m_bRenderCreated)
     return;
 
@@ -308,6 +311,7 @@ void CRenderSystemGL::InvalidateColorBuffer()
 
 bool CRenderSystemGL::ClearBuffers(KODI::UTILS::COLOR::Color color)
 {
+  CGUITextureGL::FlushBatch();
   if (!m_bRenderCreated)
     return false;
 
@@ -398,6 +402,7 @@ void CRenderSystemGL::SetVSync(bool enable)
 
 void CRenderSystemGL::CaptureStateBlock()
 {
+  CGUITextureGL::FlushBatch();
   if (!m_bRenderCreated)
     return;
 
@@ -411,6 +416,7 @@ void CRenderSystemGL::CaptureStateBlock()
 
 void CRenderSystemGL::ApplyStateBlock()
 {
+  CGUITextureGL::FlushBatch();
   if (!m_bRenderCreated)
     return;
 
@@ -429,6 +435,7 @@ void CRenderSystemGL::ApplyStateBlock()
 
 void CRenderSystemGL::SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor)
 {
+  CGUITextureGL::FlushBatch();
   if (!m_bRenderCreated)
     return;
 
@@ -504,6 +511,7 @@ void CRenderSystemGL::GetViewPort(CRect& viewPort)
 
 void CRenderSystemGL::SetViewPort(const CRect& viewPort)
 {
+  CGUITextureGL::FlushBatch();
   if (!m_bRenderCreated)
     return;
 
@@ -539,6 +547,7 @@ CRect CRenderSystemGL::ClipRectToScissorRect(const CRect &rect)
 
 void CRenderSystemGL::SetScissors(const CRect &rect)
 {
+  CGUITextureGL::FlushBatch();
   if (!m_bRenderCreated)
     return;
   GLint x1 = MathUtils::round_int(static_cast<double>(rect.x1));
@@ -550,11 +559,13 @@ void CRenderSystemGL::SetScissors(const CRect &rect)
 
 void CRenderSystemGL::ResetScissors()
 {
+  CGUITextureGL::FlushBatch();
   SetScissors(CRect(0, 0, (float)m_width, (float)m_height));
 }
 
 void CRenderSystemGL::SetDepthCulling(DEPTH_CULLING culling)
 {
+  CGUITextureGL::FlushBatch();
   if (culling == DEPTH_CULLING_OFF)
   {
     glDisable(GL_DEPTH_TEST);
@@ -634,6 +645,7 @@ static const GLubyte stipple_3d[] = {
 
 void CRenderSystemGL::SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view)
 {
+  CGUITextureGL::FlushBatch();
   CRenderSystemBase::SetStereoMode(mode, view);
 
   glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -827,6 +839,7 @@ void CRenderSystemGL::ReleaseShaders()
 
 void CRenderSystemGL::EnableShader(ShaderMethodGL method)
 {
+  CGUITextureGL::FlushBatch();
   m_method = method;
   if (m_pShader[m_method])
   {
@@ -154,6 +154,7 @@ bool CRenderSystemGLES::ResetRenderSystem(int width, int height)
 
 bool CRenderSystemGLES::DestroyRenderSystem()
 {
+  CGUITextureGLES::DestroyStaticBuffers();
   ResetScissors();
   CDirtyRegionList dirtyRegions;
   CDirtyRegion dirtyWindow(CServiceBroker::GetWinSystem()->GetGfxContext().GetViewWindow());
@@ -192,6 +193,7 @@ bool CRenderSystemGLES::BeginRender()
 
 bool CRenderSystemGLES::EndRender()
 {
+  CGUITextureGLES::FlushBatch();
   if (!m_bRenderCreated)
     return false;
 
@@ -200,6 +202,7 @@ bool CRenderSystemGLES::EndRender()
 
 void CRenderSystemGLES::InvalidateColorBuffer()
 {
+  CGUITextureGLES::FlushBatch();
   if (!m_bRenderCreated)
     return;
 
@@ -217,6 +220,7 @@ void CRenderSystemGLES::InvalidateColorBuffer()
 
 bool CRenderSystemGLES::ClearBuffers(KODI::UTILS::COLOR::Color color)
 {
+  CGUITextureGLES::FlushBatch();
   if (!m_bRenderCreated)
     return false;
 
@@ -293,6 +297,7 @@ void CRenderSystemGLES::SetVSync(bool enable)
 
 void CRenderSystemGLES::CaptureStateBlock()
 {
+  CGUITextureGLES::FlushBatch();
   if (!m_bRenderCreated)
     return;
 
@@ -308,6 +313,7 @@ void CRenderSystemGLES::CaptureStateBlock()
 
 void CRenderSystemGLES::ApplyStateBlock()
 {
+  CGUITextureGLES::FlushBatch();
   if (!m_bRenderCreated)
     return;
 
@@ -322,6 +328,7 @@ void CRenderSystemGLES::ApplyStateBlock()
 
 void CRenderSystemGLES::SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor)
 {
+  CGUITextureGLES::FlushBatch();
   if (!m_bRenderCreated)
     return;
 
@@ -370,6 +377,7 @@ void CRenderSystemGLES::GetViewPort(CRect& viewPort)
 
 void CRenderSystemGLES::SetViewPort(const CRect& viewPort)
 {
+  CGUITextureGLES::FlushBatch();
   if (!m_bRenderCreated)
     return;
 
@@ -405,6 +413,7 @@ CRect CRenderSystemGLES::ClipRectToScissorRect(const CRect &rect)
 
 void CRenderSystemGLES::SetScissors(const CRect &rect)
 {
+  CGUITextureGLES::FlushBatch();
   if (!m_bRenderCreated)
     return;
   GLint x1 = MathUtils::round_int(static_cast<double>(rect.x1));
@@ -416,11 +425,13 @@ void CRenderSystemGLES::SetScissors(const CRect &rect)
 
 void CRenderSystemGLES::ResetScissors()
 {
+  CGUITextureGLES::FlushBatch();
   SetScissors(CRect(0, 0, (float)m_width, (float)m_height));
 }
 
 void CRenderSystemGLES::SetDepthCulling(DEPTH_CULLING culling)
 {
+  CGUITextureGLES::FlushBatch();
   if (culling == DEPTH_CULLING_OFF)
   {
     glDisable(GL_DEPTH_TEST);
@@ -688,6 +699,7 @@ void CRenderSystemGLES::ReleaseShaders()
 
 void CRenderSystemGLES::EnableGUIShader(ShaderMethodGLES method)
 {
+  CGUITextureGLES::FlushBatch();
   m_method = method;
   if (m_pShader[m_method])
   {
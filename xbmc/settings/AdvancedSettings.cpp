@@ -358,6 +358,7 @@ void CAdvancedSettings::Initialize()
   m_videoItemSeparator = " / ";
   m_iMusicLibraryDateAdded = 1; // prefer mtime over ctime and current time
   m_bMusicLibraryUseISODates = false;
+  m_musicLibraryTagReaderThreads = 4;
   m_bMusicLibraryArtistNavigatesToSongs = false;
 
   m_bVideoLibraryAllItemsOnBottom = false;
@@ -365,6 +366,7 @@ void CAdvancedSettings::Initialize()
   m_bVideoLibraryCleanOnUpdate = false;
   m_bVideoLibraryUseFastHash = true;
   m_bVideoScannerIgnoreErrors = false;
+  m_videoScannerPrefetchThreads = 4;
   m_iVideoLibraryDateAdded = 1; // prefer mtime over ctime and current time
   m_minimumEpisodePlaylistDuration = 5 * 60; // 5 minutes
   m_disableEpisodeRanges = false;
@@ -410,6 +412,7 @@ void CAdvancedSettings::Initialize()
   m_curlconnecttimeout = 30;
   m_curllowspeedtime = 20;
   m_curlretries = 2;
+  m_sparseFileCacheSize = 0; // off, every seekable stream would map a file this large
   m_curlKeepAliveInterval = 30;
   m_curlDisableIPV6 = false;      //Certain hardware/OS combinations have trouble
                                   //with ipv6.
@@ -457,6 +460,9 @@ void CAdvancedSettings::Initialize()
   m_jsonOutputCompact = true;
   m_jsonTcpPort = 9090;
 
+  m_webServerThreadPoolSize = 0;
+  m_webServerConnectionLimit = 512;
+
   m_enableMultimediaKeys = false;
 
   m_canWindowed = true;
@@ -848,6 +854,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
     XMLUtils::GetBoolean(pElement, "useisodates", m_bMusicLibraryUseISODates);
     XMLUtils::GetBoolean(pElement, "artistnavigatestosongs", m_bMusicLibraryArtistNavigatesToSongs);
+    XMLUtils::GetUInt(pElement, "tagreaderthreads", m_musicLibraryTagReaderThreads, 1, 16);
     //Music artist name separators
     TiXmlElement* separators = pElement->FirstChildElement("artistseparators");
     if (separators)
@@ -884,6 +891,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   if (pElement)
   {
     XMLUtils::GetBoolean(pElement, "ignoreerrors", m_bVideoScannerIgnoreErrors);
+    XMLUtils::GetUInt(pElement, "prefetchthreads", m_videoScannerPrefetchThreads, 0, 16);
   }
 
   // Backward-compatibility of ExternalPlayer config
@@ -906,6 +914,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "curlclienttimeout", m_curlconnecttimeout, 1, 1000);
     XMLUtils::GetInt(pElement, "curllowspeedtime", m_curllowspeedtime, 1, 1000);
     XMLUtils::GetInt(pElement, "curlretries", m_curlretries, 0, 10);
+    XMLUtils::GetInt(pElement, "sparsecachesize", m_sparseFileCacheSize, 0, 65536);
     XMLUtils::GetInt(pElement, "curlkeepaliveinterval", m_curlKeepAliveInterval, 0, 300);
     XMLUtils::GetBoolean(pElement, "disableipv6", m_curlDisableIPV6);
     XMLUtils::GetBoolean(pElement, "disablehttp2", m_curlDisableHTTP2);
@@ -919,6 +928,13 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "tcpport", m_jsonTcpPort);
   }
 
+  pElement = pRootElement->FirstChildElement("webserver");
+  if (pElement)
+  {
+    XMLUtils::GetUInt(pElement, "threadpoolsize", m_webServerThreadPoolSize, 0, 256);
+    XMLUtils::GetUInt(pElement, "connectionlimit", m_webServerConnectionLimit, 1, 65535);
+  }
+
   pElement = pRootElement->FirstChildElement("samba");
   if (pElement)
   {
@@ -258,6 +258,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bMusicLibraryArtistSortOnUpdate;
     bool m_bMusicLibraryUseISODates;
     bool m_bMusicLibraryArtistNavigatesToSongs;
+    unsigned int m_musicLibraryTagReaderThreads;
     std::string m_strMusicLibraryAlbumFormat;
     bool m_prioritiseAPEv2tags;
     std::string m_musicItemSeparator;
@@ -273,6 +274,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bVideoLibraryImportResumePoint{true};
 
     bool m_bVideoScannerIgnoreErrors;
+    unsigned int m_videoScannerPrefetchThreads;
     int m_iVideoLibraryDateAdded;
 
     bool m_caseSensitiveLocalArtMatch{true};
@@ -307,6 +309,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_curlKeepAliveInterval;    // seconds
     bool m_curlDisableIPV6;
     bool m_curlDisableHTTP2;
+    int m_sparseFileCacheSize;      // MBytes
 
     std::string m_caTrustFile;
 
@@ -359,6 +362,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
 
+    unsigned int m_webServerThreadPoolSize; // 0: one thread per connection
+    unsigned int m_webServerConnectionLimit;
+
     bool m_enableMultimediaKeys;
     std::vector<std::string> m_settingsFiles;
     void ParseSettingsFile(const std::string &file);
@@ -0,0 +1,35 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TestBasicEnvironment.h"
+#include "TestUtils.h"
+
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv)
+{
+  // Consumes all --benchmark_* arguments, including --benchmark_out and
+  // --benchmark_out_format=json for machine-readable results.
+  benchmark::Initialize(&argc, argv);
+  CXBMCTestUtils::Instance().ParseArgs(argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  // Same environment as the unit tests so services (settings, charset
+  // converter, directory cache, ...) are available to the benchmarks.
+  TestBasicEnvironment environment;
+  environment.SetUp();
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  environment.TearDown();
+
+  return 0;
+}
@@ -0,0 +1,305 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "JSONStreamWriter.h"
+
+#include "utils/Variant.h"
+
+#include <cmath>
+#include <iterator>
+
+#include <fmt/format.h>
+
+namespace
+{
+constexpr std::string_view REPLACEMENT_CHARACTER = "\xEF\xBF\xBD";
+
+// length of the UTF-8 sequence starting at data[0], 0 if it is invalid
+size_t GetUTF8SequenceLength(std::string_view data)
+{
+  const auto lead = static_cast<unsigned char>(data[0]);
+  size_t length;
+  uint32_t codepoint;
+  if (lead < 0x80)
+    return 1;
+  else if ((lead & 0xE0) == 0xC0)
+  {
+    length = 2;
+    codepoint = lead & 0x1F;
+  }
+  else if ((lead & 0xF0) == 0xE0)
+  {
+    length = 3;
+    codepoint = lead & 0x0F;
+  }
+  else if ((lead & 0xF8) == 0xF0)
+  {
+    length = 4;
+    codepoint = lead & 0x07;
+  }
+  else
+    return 0;
+
+  if (data.size() < length)
+    return 0;
+
+  for (size_t i = 1; i < length; i++)
+  {
+    const auto c = static_cast<unsigned char>(data[i]);
+    if ((c & 0xC0) != 0x80)
+      return 0;
+    codepoint = (codepoint << 6) | (c & 0x3F);
+  }
+
+  // reject overlong encodings, surrogates and values beyond U+10FFFF
+  static constexpr uint32_t minimum[] = {0, 0, 0x80, 0x800, 0x10000};
+  if (codepoint < minimum[length] || (codepoint >= 0xD800 && codepoint <= 0xDFFF) ||
+      codepoint > 0x10FFFF)
+    return 0;
+
+  return length;
+}
+} // namespace
+
+CJSONStreamWriter::CJSONStreamWriter(std::string& output,
+                                     bool compact /* = true */,
+                                     unsigned int depth /* = 0 */)
+  : m_output(output), m_compact(compact), m_depth(depth)
+{
+}
+
+void CJSONStreamWriter::StartObject()
+{
+  BeginValue();
+  m_output += '{';
+  m_empty.push_back(true);
+}
+
+void CJSONStreamWriter::EndObject()
+{
+  const bool empty = m_empty.back();
+  m_empty.pop_back();
+  if (!empty)
+    NewLine(m_empty.size());
+  m_output += '}';
+}
+
+void CJSONStreamWriter::StartArray()
+{
+  BeginValue();
+  m_output += '[';
+  m_empty.push_back(true);
+}
+
+void CJSONStreamWriter::EndArray()
+{
+  const bool empty = m_empty.back();
+  m_empty.pop_back();
+  if (!empty)
+    NewLine(m_empty.size());
+  m_output += ']';
+}
+
+void CJSONStreamWriter::Key(std::string_view key)
+{
+  BeginValue();
+  WriteString(key);
+  m_output += m_compact ? ":" : ": ";
+  m_afterKey = true;
+}
+
+void CJSONStreamWriter::Null()
+{
+  BeginValue();
+  m_output += "null";
+}
+
+void CJSONStreamWriter::Bool(bool value)
+{
+  BeginValue();
+  m_output += value ? "true" : "false";
+}
+
+void CJSONStreamWriter::Int(int64_t value)
+{
+  BeginValue();
+  fmt::format_to(std::back_inserter(m_output), "{}", value);
+}
+
+void CJSONStreamWriter::Uint(uint64_t value)
+{
+  BeginValue();
+  fmt::format_to(std::back_inserter(m_output), "{}", value);
+}
+
+void CJSONStreamWriter::Double(double value)
+{
+  BeginValue();
+  if (!std::isfinite(value))
+  {
+    m_output += "null";
+    return;
+  }
+
+  const size_t start = m_output.size();
+  fmt::format_to(std::back_inserter(m_output), "{}", value);
+  // keep doubles recognizable as such, 1.0 and not 1
+  if (m_output.find_first_of(".eE", start) == std::string::npos)
+    m_output += ".0";
+}
+
+void CJSONStreamWriter::String(std::string_view value)
+{
+  BeginValue();
+  WriteString(value);
+}
+
+void CJSONStreamWriter::Value(const CVariant& value)
+{
+  switch (value.type())
+  {
+    case CVariant::VariantTypeInteger:
+      Int(value.asInteger());
+      break;
+    case CVariant::VariantTypeUnsignedInteger:
+      Uint(value.asUnsignedInteger());
+      break;
+    case CVariant::VariantTypeDouble:
+      Double(value.asDouble());
+      break;
+    case CVariant::VariantTypeBoolean:
+      Bool(value.asBoolean());
+      break;
+    case CVariant::VariantTypeString:
+      String(std::string_view(value.c_str(), value.size()));
+      break;
+    case CVariant::VariantTypeArray:
+      StartArray();
+      for (auto it = value.begin_array(); it != value.end_array(); ++it)
+        Value(*it);
+      EndArray();
+      break;
+    case CVariant::VariantTypeObject:
+      StartObject();
+      for (auto it = value.begin_map(); it != value.end_map(); ++it)
+      {
+        Key(it->first);
+        Value(it->second);
+      }
+      EndObject();
+      break;
+    case CVariant::VariantTypeConstNull:
+    case CVariant::VariantTypeNull:
+    default:
+      Null();
+      break;
+  }
+}
+
+void CJSONStreamWriter::RawValue(std::string_view json)
+{
+  BeginValue();
+  m_output += json;
+}
+
+void CJSONStreamWriter::BeginValue()
+{
+  if (m_afterKey)
+  {
+    m_afterKey = false;
+    return;
+  }
+  if (m_empty.empty())
+    return;
+
+  if (!m_empty.back())
+    m_output += ',';
+  m_empty.back() = false;
+  NewLine(m_empty.size());
+}
+
+void CJSONStreamWriter::NewLine(size_t depth)
+{
+  if (m_compact)
+    return;
+  m_output += '\n';
+  m_output.append(m_depth + depth, '\t');
+}
+
+void CJSONStreamWriter::WriteString(std::string_view value)
+{
+  static constexpr char hex[] = "0123456789abcdef";
+
+  m_output += '"';
+  size_t pos = 0;
+  while (pos < value.size())
+  {
+    // copy runs of characters that don't need escaping in one go
+    size_t end = pos;
+    while (end < value.size())
+    {
+      const auto c = static_cast<unsigned char>(value[end]);
+      if (c < 0x20 || c == '"' || c == '\\' || c >= 0x80)
+        break;
+      end++;
+    }
+    m_output.append(value.data() + pos, end - pos);
+    pos = end;
+    if (pos == value.size())
+      break;
+
+    const auto c = static_cast<unsigned char>(value[pos]);
+    if (c >= 0x80)
+    {
+      const size_t length = GetUTF8SequenceLength(value.substr(pos));
+      if (length == 0)
+      {
+        m_output += REPLACEMENT_CHARACTER;
+        pos++;
+      }
+      else
+      {
+        m_output.append(value.data() + pos, length);
+        pos += length;
+      }
+      continue;
+    }
+
+    switch (c)
+    {
+      case '"':
+        m_output += "\\\"";
+        break;
+      case '\\':
+        m_output += "\\\\";
+        break;
+      case '\b':
+        m_output += "\\b";
+        break;
+      case '\f':
+        m_output += "\\f";
+        break;
+      case '\n':
+        m_output += "\\n";
+        break;
+      case '\r':
+        m_output += "\\r";
+        break;
+      case '\t':
+        m_output += "\\t";
+        break;
+      default:
+        m_output += "\\u00";
+        m_output += hex[c >> 4];
+        m_output += hex[c & 0xF];
+        break;
+    }
+    pos++;
+  }
+  m_output += '"';
+}
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CVariant;
+
+/*!
+ \brief Writes JSON text directly into a string.
+
+ Values are appended as they are written, so large results can be serialized
+ without building a CVariant (or any other) tree first. Separators and, unless
+ compact output is requested, line breaks and indentation are added automatically.
+ Invalid UTF-8 in strings is replaced by U+FFFD.
+ */
+class CJSONStreamWriter
+{
+public:
+  /*!
+   \param output string the JSON text is appended to
+   \param compact true to write without any whitespace
+   \param depth nesting level of the written value, used for the indentation of
+   values that are inserted into another document with RawValue()
+   */
+  explicit CJSONStreamWriter(std::string& output, bool compact = true, unsigned int depth = 0);
+
+  void StartObject();
+  void EndObject();
+  void StartArray();
+  void EndArray();
+
+  /*!
+   \brief Write the key of the next object member
+   */
+  void Key(std::string_view key);
+
+  void Null();
+  void Bool(bool value);
+  void Int(int64_t value);
+  void Uint(uint64_t value);
+  void Double(double value);
+  void String(std::string_view value);
+  void Value(const CVariant& value);
+
+  /*!
+   \brief Insert an already serialized JSON value as is
+   */
+  void RawValue(std::string_view json);
+
+  bool IsCompact() const { return m_compact; }
+
+private:
+  void BeginValue();
+  void NewLine(size_t depth);
+  void WriteString(std::string_view value);
+
+  std::string& m_output;
+  const bool m_compact;
+  const unsigned int m_depth;
+  std::vector<bool> m_empty; //!< per open container, true until the first element is written
+  bool m_afterKey = false;
+};
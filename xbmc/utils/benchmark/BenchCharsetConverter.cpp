@@ -0,0 +1,67 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/CharsetConverter.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+const std::string UTF8_STRING = "Ærøskøbing – Ça va? Привет мир, こんにちは世界 ♫";
+}
+
+static void BM_CharsetConverter_Utf8ToUtf32(benchmark::State& state)
+{
+  std::u32string utf32;
+  for (auto _ : state)
+  {
+    g_charsetConverter.utf8ToUtf32(UTF8_STRING, utf32);
+    benchmark::DoNotOptimize(utf32);
+  }
+  state.SetBytesProcessed(state.iterations() * UTF8_STRING.size());
+}
+BENCHMARK(BM_CharsetConverter_Utf8ToUtf32);
+
+static void BM_CharsetConverter_Utf32ToUtf8(benchmark::State& state)
+{
+  const std::u32string utf32 = g_charsetConverter.utf8ToUtf32(UTF8_STRING);
+  std::string utf8;
+  for (auto _ : state)
+  {
+    g_charsetConverter.utf32ToUtf8(utf32, utf8);
+    benchmark::DoNotOptimize(utf8);
+  }
+  state.SetBytesProcessed(state.iterations() * UTF8_STRING.size());
+}
+BENCHMARK(BM_CharsetConverter_Utf32ToUtf8);
+
+static void BM_CharsetConverter_Utf8ToW(benchmark::State& state)
+{
+  std::wstring wide;
+  for (auto _ : state)
+  {
+    g_charsetConverter.utf8ToW(UTF8_STRING, wide, false);
+    benchmark::DoNotOptimize(wide);
+  }
+  state.SetBytesProcessed(state.iterations() * UTF8_STRING.size());
+}
+BENCHMARK(BM_CharsetConverter_Utf8ToW);
+
+static void BM_CharsetConverter_Utf8ToUtf32Visual(benchmark::State& state)
+{
+  std::u32string utf32;
+  for (auto _ : state)
+  {
+    g_charsetConverter.utf8ToUtf32Visual(UTF8_STRING, utf32, true);
+    benchmark::DoNotOptimize(utf32);
+  }
+  state.SetBytesProcessed(state.iterations() * UTF8_STRING.size());
+}
+BENCHMARK(BM_CharsetConverter_Utf8ToUtf32Visual);
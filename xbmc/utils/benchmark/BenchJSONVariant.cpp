@@ -0,0 +1,66 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/Variant.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+CVariant CreateResponse(int items)
+{
+  CVariant result(CVariant::VariantTypeObject);
+  result["jsonrpc"] = "2.0";
+  result["id"] = 1;
+  CVariant& songs = result["result"]["songs"];
+  for (int i = 0; i < items; ++i)
+  {
+    CVariant song(CVariant::VariantTypeObject);
+    song["songid"] = i;
+    song["label"] = "Song " + std::to_string(i);
+    song["artist"].push_back("Artist");
+    song["duration"] = 240;
+    song["rating"] = 3.5;
+    songs.push_back(song);
+  }
+  result["result"]["limits"]["total"] = items;
+  return result;
+}
+} // namespace
+
+static void BM_JSONVariantWriter_Write(benchmark::State& state)
+{
+  const CVariant response = CreateResponse(static_cast<int>(state.range(0)));
+  std::string output;
+  for (auto _ : state)
+  {
+    output.clear();
+    CJSONVariantWriter::Write(response, output, true);
+    benchmark::DoNotOptimize(output);
+  }
+  state.SetBytesProcessed(state.iterations() * output.size());
+}
+BENCHMARK(BM_JSONVariantWriter_Write)->Range(8, 4096);
+
+static void BM_JSONVariantParser_Parse(benchmark::State& state)
+{
+  std::string json;
+  CJSONVariantWriter::Write(CreateResponse(static_cast<int>(state.range(0))), json, true);
+  for (auto _ : state)
+  {
+    CVariant data;
+    CJSONVariantParser::Parse(json, data);
+    benchmark::DoNotOptimize(data);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JSONVariantParser_Parse)->Range(8, 4096);
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "music/tags/MusicInfoTag.h"
+#include "utils/LabelFormatter.h"
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+std::shared_ptr<CFileItem> CreateSongItem()
+{
+  auto item = std::make_shared<CFileItem>("/music/Artist/Album/01 - Title.flac", false);
+  MUSIC_INFO::CMusicInfoTag& tag = *item->GetMusicInfoTag();
+  tag.SetTitle("Title");
+  tag.SetArtist("Artist");
+  tag.SetAlbum("Album");
+  tag.SetTrackNumber(1);
+  tag.SetDuration(245);
+  tag.SetYear(1999);
+  tag.SetLoaded(true);
+  return item;
+}
+} // namespace
+
+static void BM_LabelFormatter_Construct(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    CLabelFormatter formatter("[%N. ]%A - %T", "%D");
+    benchmark::DoNotOptimize(formatter);
+  }
+}
+BENCHMARK(BM_LabelFormatter_Construct);
+
+static void BM_LabelFormatter_FormatLabels(benchmark::State& state)
+{
+  const CLabelFormatter formatter("[%N. ]%A - %T", "%D");
+  const std::shared_ptr<CFileItem> item = CreateSongItem();
+  for (auto _ : state)
+    formatter.FormatLabels(item.get());
+}
+BENCHMARK(BM_LabelFormatter_FormatLabels);
@@ -0,0 +1,50 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/RegExp.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+const std::string EPISODE_REGEX = "[Ss]([0-9]+)[][ ._-]*[Ee]([0-9]+)([^\\\\/]*)$";
+const std::string TEST_FILE = "/media/TV/Some Show/Season 02/Some.Show.S02E05.720p.HDTV.x264.mkv";
+}
+
+static void BM_RegExp_Compile(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    CRegExp reg(true, CRegExp::autoUtf8);
+    benchmark::DoNotOptimize(reg.RegComp(EPISODE_REGEX));
+  }
+}
+BENCHMARK(BM_RegExp_Compile);
+
+static void BM_RegExp_Find(benchmark::State& state)
+{
+  CRegExp reg(true, CRegExp::autoUtf8);
+  reg.RegComp(EPISODE_REGEX, state.range(0) ? CRegExp::StudyWithJitComp : CRegExp::NoStudy);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(reg.RegFind(TEST_FILE));
+}
+BENCHMARK(BM_RegExp_Find)->Arg(0)->Arg(1);
+
+static void BM_RegExp_FindAndGetMatch(benchmark::State& state)
+{
+  CRegExp reg(true, CRegExp::autoUtf8);
+  reg.RegComp(EPISODE_REGEX);
+  for (auto _ : state)
+  {
+    if (reg.RegFind(TEST_FILE) >= 0)
+      benchmark::DoNotOptimize(reg.GetMatch(2));
+  }
+}
+BENCHMARK(BM_RegExp_FindAndGetMatch);
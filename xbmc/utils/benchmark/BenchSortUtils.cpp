@@ -0,0 +1,57 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/SortUtils.h"
+#include "utils/Variant.h"
+
+#include <random>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+SortItems CreateItems(int count)
+{
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(0, count);
+
+  SortItems items;
+  items.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    SortItemPtr item(new SortItem());
+    const int value = distribution(generator);
+    (*item)[FieldLabel] = "Label " + std::to_string(value);
+    (*item)[FieldTitle] = "The Title " + std::to_string(value);
+    (*item)[FieldArtist] = "Artist " + std::to_string(value % 100);
+    (*item)[FieldYear] = 1950 + value % 70;
+    items.push_back(item);
+  }
+  return items;
+}
+} // namespace
+
+static void BM_SortUtils_Sort(benchmark::State& state, SortBy sortBy, SortAttribute attributes)
+{
+  const SortItems source = CreateItems(static_cast<int>(state.range(0)));
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    SortItems items = source;
+    state.ResumeTiming();
+    SortUtils::Sort(sortBy, SortOrderAscending, attributes, items);
+    benchmark::DoNotOptimize(items);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_SortUtils_Sort, Label, SortByLabel, SortAttributeNone)->Range(64, 32768);
+BENCHMARK_CAPTURE(BM_SortUtils_Sort, TitleIgnoreArticle, SortByTitle, SortAttributeIgnoreArticle)
+    ->Range(64, 32768);
+BENCHMARK_CAPTURE(BM_SortUtils_Sort, Artist, SortByArtist, SortAttributeNone)->Range(64, 32768);
+BENCHMARK_CAPTURE(BM_SortUtils_Sort, Year, SortByYear, SortAttributeNone)->Range(64, 32768);
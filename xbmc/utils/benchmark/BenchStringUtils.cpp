@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/StringUtils.h"
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+const std::string TEST_STRING = "  The Quick Brown Fox Jumps Over The Lazy Dog, 1080p x264 DTS-HD  ";
+}
+
+static void BM_StringUtils_ToLower(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::ToLower(TEST_STRING));
+}
+BENCHMARK(BM_StringUtils_ToLower);
+
+static void BM_StringUtils_EqualsNoCase(benchmark::State& state)
+{
+  const std::string other = StringUtils::ToUpper(TEST_STRING);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::EqualsNoCase(TEST_STRING, other));
+}
+BENCHMARK(BM_StringUtils_EqualsNoCase);
+
+static void BM_StringUtils_Trim(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::string str = TEST_STRING;
+    benchmark::DoNotOptimize(StringUtils::Trim(str));
+  }
+}
+BENCHMARK(BM_StringUtils_Trim);
+
+static void BM_StringUtils_Replace(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::string str = TEST_STRING;
+    benchmark::DoNotOptimize(StringUtils::Replace(str, "The", "A"));
+  }
+}
+BENCHMARK(BM_StringUtils_Replace);
+
+static void BM_StringUtils_SplitJoin(benchmark::State& state)
+{
+  std::vector<std::string> parts(state.range(0), "genre");
+  const std::string joined = StringUtils::Join(parts, " / ");
+  for (auto _ : state)
+  {
+    const std::vector<std::string> split = StringUtils::Split(joined, " / ");
+    benchmark::DoNotOptimize(StringUtils::Join(split, " / "));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringUtils_SplitJoin)->Range(8, 512);
+
+static void BM_StringUtils_Format(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::Format("{}x{:02} - {} ({})", 3, 7, "Episode", 2024));
+}
+BENCHMARK(BM_StringUtils_Format);
+
+static void BM_StringUtils_AlphaNumericCompare(benchmark::State& state)
+{
+  const std::wstring left = L"Episode 9 - The Return";
+  const std::wstring right = L"Episode 10 - The Return";
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::AlphaNumericCompare(left, right));
+}
+BENCHMARK(BM_StringUtils_AlphaNumericCompare);
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/URIUtils.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+const std::string TEST_PATH = "smb://nas/media/Movies/Some Movie (2019)/Some.Movie.2019.2160p.mkv";
+}
+
+static void BM_URIUtils_GetExtension(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::GetExtension(TEST_PATH));
+}
+BENCHMARK(BM_URIUtils_GetExtension);
+
+static void BM_URIUtils_GetFileName(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::GetFileName(TEST_PATH));
+}
+BENCHMARK(BM_URIUtils_GetFileName);
+
+static void BM_URIUtils_GetParentPath(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::GetParentPath(TEST_PATH));
+}
+BENCHMARK(BM_URIUtils_GetParentPath);
+
+static void BM_URIUtils_AddFileToFolder(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::AddFileToFolder("smb://nas/media/Movies/", "movie.nfo"));
+}
+BENCHMARK(BM_URIUtils_AddFileToFolder);
+
+static void BM_URIUtils_HasExtension(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::HasExtension(TEST_PATH, ".avi|.mkv|.mp4|.ts|.m2ts"));
+}
+BENCHMARK(BM_URIUtils_HasExtension);
+
+static void BM_URIUtils_IsRemote(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::IsRemote(TEST_PATH));
+}
+BENCHMARK(BM_URIUtils_IsRemote);
+
+static void BM_URIUtils_URLEncodeDecode(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(URIUtils::URLDecode(URIUtils::URLEncode(TEST_PATH)));
+}
+BENCHMARK(BM_URIUtils_URLEncodeDecode);
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/Variant.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+CVariant CreateItem(int index)
+{
+  CVariant item(CVariant::VariantTypeObject);
+  item["songid"] = index;
+  item["title"] = "Title " + std::to_string(index);
+  item["artist"].push_back("Artist");
+  item["rating"] = 7.5;
+  item["playcount"] = 0;
+  return item;
+}
+} // namespace
+
+static void BM_Variant_BuildObject(benchmark::State& state)
+{
+  for (auto _ : state)
+    benchmark::DoNotOptimize(CreateItem(42));
+}
+BENCHMARK(BM_Variant_BuildObject);
+
+static void BM_Variant_BuildArray(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    CVariant array(CVariant::VariantTypeArray);
+    for (int i = 0; i < state.range(0); ++i)
+      array.push_back(CreateItem(i));
+    benchmark::DoNotOptimize(array);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Variant_BuildArray)->Range(8, 4096);
+
+static void BM_Variant_Copy(benchmark::State& state)
+{
+  CVariant array(CVariant::VariantTypeArray);
+  for (int i = 0; i < state.range(0); ++i)
+    array.push_back(CreateItem(i));
+
+  for (auto _ : state)
+  {
+    CVariant copy(array);
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Variant_Copy)->Range(8, 4096);
+
+static void BM_Variant_MemberLookup(benchmark::State& state)
+{
+  const CVariant item = CreateItem(42);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(item["title"].asString());
+}
+BENCHMARK(BM_Variant_MemberLookup);
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/JSONStreamWriter.h"
+#include "utils/Variant.h"
+
+#include <gtest/gtest.h>
+
+TEST(TestJSONStreamWriter, WritesCompactDocument)
+{
+  std::string str;
+  CJSONStreamWriter writer(str);
+  writer.StartObject();
+  writer.Key("limits");
+  writer.StartObject();
+  writer.Key("total");
+  writer.Int(2);
+  writer.EndObject();
+  writer.Key("songs");
+  writer.StartArray();
+  writer.Uint(1);
+  writer.Double(2.5);
+  writer.Null();
+  writer.EndArray();
+  writer.EndObject();
+
+  EXPECT_EQ("{\"limits\":{\"total\":2},\"songs\":[1,2.5,null]}", str);
+}
+
+TEST(TestJSONStreamWriter, EscapesStrings)
+{
+  std::string str;
+  CJSONStreamWriter writer(str);
+  writer.String("a\"b\\c\n\x01/\xC3\xA9");
+  EXPECT_EQ("\"a\\\"b\\\\c\\n\\u0001/\xC3\xA9\"", str);
+
+  // invalid UTF-8 is replaced
+  str.clear();
+  CJSONStreamWriter invalid(str);
+  invalid.String("a\xC3(b\xFF");
+  EXPECT_EQ("\"a\xEF\xBF\xBD(b\xEF\xBF\xBD\"", str);
+}
+
+TEST(TestJSONStreamWriter, InsertsRawValues)
+{
+  std::string songs;
+  CJSONStreamWriter songWriter(songs, false, 1);
+  songWriter.StartArray();
+  songWriter.Bool(true);
+  songWriter.EndArray();
+
+  std::string str;
+  CJSONStreamWriter writer(str, false);
+  writer.StartObject();
+  writer.Key("songs");
+  writer.RawValue(songs);
+  writer.EndObject();
+
+  CVariant variant;
+  variant["songs"].push_back(true);
+  std::string expected;
+  CJSONStreamWriter variantWriter(expected, false);
+  variantWriter.Value(variant);
+
+  EXPECT_EQ(expected, str);
+  EXPECT_EQ("{\n\t\"songs\": [\n\t\ttrue\n\t]\n}", str);
+}
@@ -654,8 +654,8 @@ int CVideoDatabase::GetPathId(const std::string& strPath)
 
     URIUtils::AddSlashAtEnd(strPath1);
 
-    strSQL=PrepareSQL("select idPath from path where strPath='%s'",strPath1.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "select idPath from path where strPath=?";
+    m_pDS->query(strSQL, {dbiplus::field_value(strPath1.c_str())});
     if (!m_pDS->eof())
       idPath = m_pDS->fv("path.idPath").get_asInt();
 
@@ -905,8 +905,7 @@ bool CVideoDatabase::GetPathHash(const std::string &path, std::string &hash)
     if (nullptr == m_pDS)
       return false;
 
-    std::string strSQL=PrepareSQL("select strHash from path where strPath='%s'", path.c_str());
-    m_pDS->query(strSQL);
+    m_pDS->query("select strHash from path where strPath=?", {dbiplus::field_value(path.c_str())});
     if (m_pDS->num_rows() == 0)
       return false;
     hash = m_pDS->fv("strHash").get_asString();
@@ -1229,8 +1228,7 @@ bool CVideoDatabase::GetLinksToTvShow(int idMovie, std::vector<int>& ids)
     if (nullptr == m_pDS)
       return false;
 
-    std::string strSQL=PrepareSQL("select * from movielinktvshow where idMovie=%i", idMovie);
-    m_pDS2->query(strSQL);
+    m_pDS2->query("select * from movielinktvshow where idMovie=?", {dbiplus::field_value(idMovie)});
     while (!m_pDS2->eof())
     {
       ids.emplace_back(m_pDS2->fv(1).get_asInt());
@@ -1265,9 +1263,8 @@ int CVideoDatabase::GetFileId(const std::string& strFilenameAndPath)
     int idPath = GetPathId(strPath);
     if (idPath >= 0)
     {
-      std::string strSQL;
-      strSQL=PrepareSQL("select idFile from files where strFileName='%s' and idPath=%i", strFileName.c_str(),idPath);
-      m_pDS->query(strSQL);
+      m_pDS->query("select idFile from files where strFileName=? and idPath=?",
+                   {dbiplus::field_value(strFileName.c_str()), dbiplus::field_value(idPath)});
       if (m_pDS->num_rows() > 0)
       {
         int idFile = m_pDS->fv("files.idFile").get_asInt();
@@ -4932,8 +4929,7 @@ bool CVideoDatabase::GetStreamDetails(CVideoInfoTag& tag)
   std::unique_ptr<Dataset> pDS(m_pDB->CreateDataset());
   try
   {
-    std::string strSQL = PrepareSQL("SELECT * FROM streamdetails WHERE idFile = %i", fileId);
-    pDS->query(strSQL);
+    pDS->query("SELECT * FROM streamdetails WHERE idFile = ?", {dbiplus::field_value(fileId)});
 
     while (!pDS->eof())
     {
@@ -5118,9 +5114,9 @@ CVideoInfoTag CVideoDatabase::GetDetailsForMovie(const dbiplus::sql_record* cons
       GetLinksToTvShow(idMovie, links);
       for (int link : links)
       {
-        std::string strSQL =
-            PrepareSQL("select c%02d from tvshow where idShow=%i", VIDEODB_ID_TV_TITLE, link);
-        m_pDS2->query(strSQL);
+        const std::string strSQL =
+            PrepareSQL("select c%02d from tvshow where idShow=?", VIDEODB_ID_TV_TITLE);
+        m_pDS2->query(strSQL, {dbiplus::field_value(link)});
         if (!m_pDS2->eof())
           details.m_showLink.emplace_back(m_pDS2->fv(0).get_asString());
       }
@@ -5397,19 +5393,19 @@ void CVideoDatabase::GetCast(int media_id, const std::string &media_type, std::v
     if (!m_pDS2)
       return;
 
-    std::string sql = PrepareSQL("SELECT actor.name,"
-                                 "  actor_link.role,"
-                                 "  actor_link.cast_order,"
-                                 "  actor.art_urls,"
-                                 "  art.url "
-                                 "FROM actor_link"
-                                 "  JOIN actor ON"
-                                 "    actor_link.actor_id=actor.actor_id"
-                                 "  LEFT JOIN art ON"
-                                 "    art.media_id=actor.actor_id AND art.media_type='actor' AND art.type='thumb' "
-                                 "WHERE actor_link.media_id=%i AND actor_link.media_type='%s'"
-                                 "ORDER BY actor_link.cast_order", media_id, media_type.c_str());
-    m_pDS2->query(sql);
+    const std::string sql = "SELECT actor.name,"
+                            "  actor_link.role,"
+                            "  actor_link.cast_order,"
+                            "  actor.art_urls,"
+                            "  art.url "
+                            "FROM actor_link"
+                            "  JOIN actor ON"
+                            "    actor_link.actor_id=actor.actor_id"
+                            "  LEFT JOIN art ON"
+                            "    art.media_id=actor.actor_id AND art.media_type='actor' AND art.type='thumb' "
+                            "WHERE actor_link.media_id=? AND actor_link.media_type=? "
+                            "ORDER BY actor_link.cast_order";
+    m_pDS2->query(sql, {dbiplus::field_value(media_id), dbiplus::field_value(media_type.c_str())});
     while (!m_pDS2->eof())
     {
       SActorInfo info;
@@ -5446,8 +5442,8 @@ void CVideoDatabase::GetTags(int media_id, const std::string &media_type, std::v
     if (!m_pDS2)
       return;
 
-    std::string sql = PrepareSQL("SELECT tag.name FROM tag INNER JOIN tag_link ON tag_link.tag_id = tag.tag_id WHERE tag_link.media_id = %i AND tag_link.media_type = '%s' ORDER BY tag.tag_id", media_id, media_type.c_str());
-    m_pDS2->query(sql);
+    const std::string sql = "SELECT tag.name FROM tag INNER JOIN tag_link ON tag_link.tag_id = tag.tag_id WHERE tag_link.media_id = ? AND tag_link.media_type = ? ORDER BY tag.tag_id";
+    m_pDS2->query(sql, {dbiplus::field_value(media_id), dbiplus::field_value(media_type.c_str())});
     while (!m_pDS2->eof())
     {
       tags.emplace_back(m_pDS2->fv(0).get_asString());
@@ -5470,8 +5466,8 @@ void CVideoDatabase::GetRatings(int media_id, const std::string &media_type, Rat
     if (!m_pDS2)
       return;
 
-    std::string sql = PrepareSQL("SELECT rating.rating_type, rating.rating, rating.votes FROM rating WHERE rating.media_id = %i AND rating.media_type = '%s'", media_id, media_type.c_str());
-    m_pDS2->query(sql);
+    const std::string sql = "SELECT rating.rating_type, rating.rating, rating.votes FROM rating WHERE rating.media_id = ? AND rating.media_type = ?";
+    m_pDS2->query(sql, {dbiplus::field_value(media_id), dbiplus::field_value(media_type.c_str())});
     while (!m_pDS2->eof())
     {
       ratings[m_pDS2->fv(0).get_asString()] = CRating(m_pDS2->fv(1).get_asFloat(), m_pDS2->fv(2).get_asInt());
@@ -5494,8 +5490,8 @@ void CVideoDatabase::GetUniqueIDs(int media_id, const std::string &media_type, C
     if (!m_pDS2)
       return;
 
-    std::string sql = PrepareSQL("SELECT type, value FROM uniqueid WHERE media_id = %i AND media_type = '%s'", media_id, media_type.c_str());
-    m_pDS2->query(sql);
+    const std::string sql = "SELECT type, value FROM uniqueid WHERE media_id = ? AND media_type = ?";
+    m_pDS2->query(sql, {dbiplus::field_value(media_id), dbiplus::field_value(media_type.c_str())});
     while (!m_pDS2->eof())
     {
       details.SetUniqueID(m_pDS2->fv(1).get_asString(), m_pDS2->fv(0).get_asString());
@@ -5732,9 +5728,9 @@ bool CVideoDatabase::GetArtForItem(int mediaId, const MediaType& mediaType, KODI
     if (nullptr == m_pDS2)
       return false; // using dataset 2 as we're likely called in loops on dataset 1
 
-    std::string sql = PrepareSQL("SELECT type,url FROM art WHERE media_id=%i AND media_type='%s'", mediaId, mediaType.c_str());
+    const std::string sql = "SELECT type,url FROM art WHERE media_id=? AND media_type=?";
 
-    m_pDS2->query(sql);
+    m_pDS2->query(sql, {dbiplus::field_value(mediaId), dbiplus::field_value(mediaType.c_str())});
     while (!m_pDS2->eof())
     {
       art.try_emplace(m_pDS2->fv(0).get_asString(), m_pDS2->fv(1).get_asString());
@@ -9127,30 +9123,8 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
 
     strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
-    int iRowsFound = RunQuery(strSQL);
-
-    // store the total value of items as a property
-    if (total < iRowsFound)
-      total = iRowsFound;
-    items.SetProperty("total", total);
-
-    if (iRowsFound <= 0)
-      return iRowsFound == 0;
-
-    DatabaseResults results;
-    results.reserve(iRowsFound);
-
-    if (!SortUtils::SortFromDataset(sortDescription, MediaTypeMovie, *m_pDS, results))
-      return false;
-
-    // get data from returned rows
-    items.Reserve(results.size());
-    const query_data &data = m_pDS->get_result_set().records;
-    for (const auto &i : results)
+    const auto addMovie = [&](const dbiplus::sql_record* record)
     {
-      const auto targetRow = static_cast<unsigned int>(i.at(FieldRow).asInteger());
-      const dbiplus::sql_record* const record = data.at(targetRow);
-
       CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
       if (m_profileManager.GetMasterProfile().getLockMode() == LockMode::EVERYONE ||
           g_passwordManager.bMasterUser ||
@@ -9203,6 +9177,53 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
                                                        : CGUIListItem::ICON_OVERLAY_UNWATCHED);
         items.Add(item);
       }
+    };
+
+    if (sortDescription.sortBy == SortByNone)
+    {
+      // rows are used in database order, create the items while the rows are fetched
+      const auto start = std::chrono::steady_clock::now();
+      if (!m_pDS->query_stream(strSQL))
+        return false;
+
+      for (; !m_pDS->eof(); m_pDS->next())
+        addMovie(m_pDS->get_sql_record());
+
+      const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start);
+      CLog::LogFC(LOGDEBUG, LOGDATABASE, "took {} ms for {} items streamed query: {}",
+                  duration.count(), m_pDS->num_rows(), strSQL);
+
+      // store the total value of items as a property
+      items.SetProperty("total", std::max(total, m_pDS->num_rows()));
+
+      m_pDS->close();
+      return true;
+    }
+
+    int iRowsFound = RunQuery(strSQL);
+
+    // store the total value of items as a property
+    if (total < iRowsFound)
+      total = iRowsFound;
+    items.SetProperty("total", total);
+
+    if (iRowsFound <= 0)
+      return iRowsFound == 0;
+
+    DatabaseResults results;
+    results.reserve(iRowsFound);
+
+    if (!SortUtils::SortFromDataset(sortDescription, MediaTypeMovie, *m_pDS, results))
+      return false;
+
+    // get data from returned rows
+    items.Reserve(results.size());
+    const query_data &data = m_pDS->get_result_set().records;
+    for (const auto &i : results)
+    {
+      const auto targetRow = static_cast<unsigned int>(i.at(FieldRow).asInteger());
+      addMovie(data.at(targetRow));
     }
 
     // cleanup
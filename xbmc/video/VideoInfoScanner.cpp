@@ -57,9 +57,12 @@
 #include "video/dialogs/GUIDialogVideoManagerVersions.h"
 
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <memory>
 #include <ranges>
 #include <set>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -241,6 +244,7 @@ CVideoInfoScanner::CVideoInfoScanner()
 
   m_ignoreVideoVersions = settings->GetBool(CSettings::SETTING_VIDEOLIBRARY_IGNOREVIDEOVERSIONS);
   m_ignoreVideoExtras = settings->GetBool(CSettings::SETTING_VIDEOLIBRARY_IGNOREVIDEOEXTRAS);
+  m_prefetchThreads = m_advancedSettings->m_videoScannerPrefetchThreads;
 }
 
 CVideoInfoScanner::~CVideoInfoScanner()
@@ -321,8 +325,17 @@ CVideoInfoScanner::~CVideoInfoScanner()
                     CURL::GetRedacted(directory), m_bClean ? " and clean" : "");
           m_pathsToScan.erase(m_pathsToScan.begin());
         }
-        else if (!DoScan(directory))
-          bCancelled = true;
+        else
+        {
+          const auto sourceStart = std::chrono::steady_clock::now();
+          if (!DoScan(directory))
+            bCancelled = true;
+
+          const auto sourceDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - sourceStart);
+          CLog::Log(LOGINFO, "VideoInfoScanner: Scanning '{}' took {} ms",
+                    CURL::GetRedacted(directory), sourceDuration.count());
+        }
       }
 
       if (!bCancelled)
@@ -351,6 +364,9 @@ CVideoInfoScanner::~CVideoInfoScanner()
       CLog::Log(LOGERROR, "VideoInfoScanner: Exception while scanning.");
     }
 
+    // wait for prefetches of folders that weren't scanned after all
+    m_prefetched.clear();
+
     m_bRunning = false;
     CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary,
                                                        "OnScanFinished");
@@ -420,6 +436,8 @@ CVideoInfoScanner::~CVideoInfoScanner()
     if (it != m_pathsToScan.end())
       m_pathsToScan.erase(it);
 
+    std::unique_ptr<PrefetchedDirectory> prefetched = TakePrefetchedDirectory(strDirectory);
+
     // load subfolder
     CFileItemList items;
     bool foundDirectly = false;
@@ -438,9 +456,13 @@ CVideoInfoScanner::~CVideoInfoScanner()
     if (CUtil::ExcludeFileOrFolder(strDirectory, regexps))
       return true;
 
-    if (HasNoMedia(strDirectory))
+    if (prefetched ? prefetched->noMedia : HasNoMedia(strDirectory))
       return true;
 
+    // the prefetch assumed the settings of the parent folder
+    if (prefetched && (prefetched->content != content || prefetched->excludes != regexps))
+      prefetched.reset();
+
     bool ignoreFolder = !m_scanAll && settings.noupdate;
     if (content == ContentType::NONE || ignoreFolder)
       return true;
@@ -464,32 +486,23 @@ CVideoInfoScanner::~CVideoInfoScanner()
       }
 
       std::string fastHash;
-      if (m_advancedSettings->m_bVideoLibraryUseFastHash && !URIUtils::IsPlugin(strDirectory))
+      if (prefetched)
+        fastHash = prefetched->fastHash;
+      else if (m_advancedSettings->m_bVideoLibraryUseFastHash && !URIUtils::IsPlugin(strDirectory))
         fastHash = GetFastHash(strDirectory, regexps);
 
       if (m_database.GetPathHash(strDirectory, dbHash) && !fastHash.empty() && StringUtils::EqualsNoCase(fastHash, dbHash))
       { // fast hashes match - no need to process anything
         hash = fastHash;
       }
+      else if (prefetched && prefetched->items)
+      { // the folder has been fetched already
+        items.Assign(*prefetched->items);
+        hash = prefetched->hash;
+      }
       else
       { // need to fetch the folder
-        CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
-                                 DIR_FLAG_DEFAULTS);
-        // do not consider inner folders with .nomedia
-        items.erase(std::remove_if(items.begin(), items.end(), [](const CFileItemPtr& item)
-                                   { return item->IsFolder() && HasNoMedia(item->GetPath()); }),
-                    items.end());
-        items.Stack();
-
-        // force sorting consistency to avoid hash mismatch between platforms
-        // sort by filename as always present for any files, but keep case sensitivity
-        items.Sort(SortByFile, SortOrderAscending, SortAttributeNone);
-
-        // check whether to re-use previously computed fast hash
-        if (!CanFastHash(items, regexps) || fastHash.empty())
-          GetPathHash(items, hash);
-        else
-          hash = fastHash;
+        GetDirectoryListing(strDirectory, regexps, fastHash, items, hash);
       }
 
       if (StringUtils::EqualsNoCase(hash, dbHash))
@@ -582,6 +595,30 @@ CVideoInfoScanner::~CVideoInfoScanner()
     if (m_handle)
       OnDirectoryScanned(strDirectory);
 
+    const auto isVideoExtras = [&](const CFileItem& item)
+    {
+      return foundSomething && content == ContentType::MOVIES && settings.parent_name &&
+             !m_ignoreVideoExtras && IsVideoExtrasFolder(item);
+    };
+
+    // do not recurse for tv shows - we have already looked recursively for episodes
+    const auto isRecursed = [&](const CFileItem& item)
+    {
+      return content != ContentType::TVSHOWS && settings.recurse > 0 && item.IsFolder() &&
+             !item.IsParentFolder() && !PLAYLIST::IsPlayList(item) && !isVideoExtras(item);
+    };
+
+    std::vector<std::string> folders;
+    if (m_prefetchThreads > 0)
+    {
+      for (const auto& item : items)
+      {
+        if (isRecursed(*item))
+          folders.emplace_back(item->GetPath());
+      }
+    }
+    size_t nextFolder = 0;
+
     for (int i = 0; i < items.Size(); ++i)
     {
       CFileItemPtr pItem = items[i];
@@ -590,8 +627,7 @@ CVideoInfoScanner::~CVideoInfoScanner()
         break;
 
       // add video extras to library
-      if (foundSomething && content == ContentType::MOVIES && settings.parent_name &&
-          !m_ignoreVideoExtras && IsVideoExtrasFolder(*pItem))
+      if (isVideoExtras(*pItem))
       {
         if (AddVideoExtras(items, content, pItem->GetPath()))
         {
@@ -604,10 +640,13 @@ CVideoInfoScanner::~CVideoInfoScanner()
       }
 
       // if we have a directory item (non-playlist) we then recurse into that folder
-      // do not recurse for tv shows - we have already looked recursively for episodes
-      if (content != ContentType::TVSHOWS && settings.recurse > 0 && pItem->IsFolder() &&
-          !pItem->IsParentFolder() && !PLAYLIST::IsPlayList(*pItem))
+      if (isRecursed(*pItem))
       {
+        // keep the folders after this one coming while it is scanned, this one is either
+        // prefetched already or listed by DoScan() itself
+        if (nextFolder < folders.size())
+          PrefetchDirectories(std::span(folders).subspan(++nextFolder), content, regexps);
+
         if (!DoScan(pItem->GetPath()))
         {
           m_bStop = true;
@@ -2655,6 +2694,91 @@ CVideoInfoScanner::~CVideoInfoScanner()
     return true;
   }
 
+  void CVideoInfoScanner::GetDirectoryListing(const std::string& directory,
+                                              const std::vector<std::string>& excludes,
+                                              const std::string& fastHash,
+                                              CFileItemList& items,
+                                              std::string& hash) const
+  {
+    CDirectory::GetDirectory(directory, items,
+                             CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
+                             DIR_FLAG_DEFAULTS);
+    // do not consider inner folders with .nomedia
+    items.erase(std::remove_if(items.begin(), items.end(), [](const CFileItemPtr& item)
+                               { return item->IsFolder() && HasNoMedia(item->GetPath()); }),
+                items.end());
+    items.Stack();
+
+    // force sorting consistency to avoid hash mismatch between platforms
+    // sort by filename as always present for any files, but keep case sensitivity
+    items.Sort(SortByFile, SortOrderAscending, SortAttributeNone);
+
+    // check whether to re-use previously computed fast hash
+    if (!CanFastHash(items, excludes) || fastHash.empty())
+      GetPathHash(items, hash);
+    else
+      hash = fastHash;
+  }
+
+  void CVideoInfoScanner::PrefetchDirectories(std::span<const std::string> folders,
+                                              ContentType content,
+                                              const std::vector<std::string>& excludes)
+  {
+    // only movies and music videos are listed by DoScan() itself
+    if (content != ContentType::MOVIES && content != ContentType::MUSICVIDEOS)
+      return;
+
+    const bool useFastHash = m_advancedSettings->m_bVideoLibraryUseFastHash;
+
+    for (const std::string& folder : folders)
+    {
+      if (m_prefetched.size() >= m_prefetchThreads)
+        break;
+
+      if (m_prefetched.contains(folder) || URIUtils::IsPlugin(folder))
+        continue;
+
+      // the database is only read here, the workers never touch it
+      std::string dbHash;
+      m_database.GetPathHash(folder, dbHash);
+
+      m_prefetched.emplace(
+          folder, std::async(std::launch::async,
+                             [this, folder, content, excludes, useFastHash, dbHash]()
+                             {
+                               auto result = std::make_unique<PrefetchedDirectory>();
+                               result->content = content;
+                               result->excludes = excludes;
+                               result->noMedia = HasNoMedia(folder);
+                               if (result->noMedia)
+                                 return result;
+
+                               if (useFastHash)
+                                 result->fastHash = GetFastHash(folder, excludes);
+                               if (!result->fastHash.empty() &&
+                                   StringUtils::EqualsNoCase(result->fastHash, dbHash))
+                                 return result;
+
+                               result->items = std::make_unique<CFileItemList>();
+                               GetDirectoryListing(folder, excludes, result->fastHash,
+                                                   *result->items, result->hash);
+                               return result;
+                             }));
+    }
+  }
+
+  std::unique_ptr<CVideoInfoScanner::PrefetchedDirectory> CVideoInfoScanner::
+      TakePrefetchedDirectory(const std::string& directory)
+  {
+    auto it = m_prefetched.find(directory);
+    if (it == m_prefetched.end())
+      return {};
+
+    std::unique_ptr<PrefetchedDirectory> result = it->second.get();
+    m_prefetched.erase(it);
+    return result;
+  }
+
   std::string CVideoInfoScanner::GetFastHash(const std::string &directory,
       const std::vector<std::string> &excludes) const
   {
@@ -14,7 +14,11 @@
 #include "guilib/GUIListItem.h"
 #include "utils/Artwork.h"
 
+#include <future>
+#include <map>
+#include <memory>
 #include <set>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -296,6 +300,51 @@ namespace KODI::VIDEO
      */
     bool CanFastHash(const CFileItemList &items, const std::vector<std::string> &excludes) const;
 
+    /*! \brief Fetch the listing of a movie or music video folder and hash it
+     Removes folders containing a .nomedia file, stacks and sorts the listing.
+     \param directory folder to list
+     \param excludes string array of exclude expressions
+     \param fastHash the "fast" hash of the folder, re-used when the listing allows it
+     \param items [out] the directory listing
+     \param hash [out] the hash of the listing
+     */
+    void GetDirectoryListing(const std::string& directory,
+                             const std::vector<std::string>& excludes,
+                             const std::string& fastHash,
+                             CFileItemList& items,
+                             std::string& hash) const;
+
+    /*! \brief Result of the file system work of DoScan() done ahead of time for a folder
+     */
+    struct PrefetchedDirectory
+    {
+      ADDON::ContentType content{ADDON::ContentType::NONE};
+      std::vector<std::string> excludes;
+      bool noMedia{false};
+      std::string fastHash;
+      std::unique_ptr<CFileItemList> items; //!< nullptr if the fast hash matched the database
+      std::string hash;
+    };
+
+    /*! \brief Start fetching the folders DoScan() will recurse into next
+     Lists and hashes up to m_prefetchThreads folders in the background while the current
+     folder is scraped. Only the file system is touched, the database is left to DoScan().
+     The .nfo lookup and the local art checks of the items are not prefetched: which files they
+     look for depends on the folder's scraper settings and on the tag read from the .nfo itself,
+     and the tag loaders have no way to take a result found elsewhere.
+     \param folders the folders, in the order they are going to be scanned
+     \param content the content of the parent folder, assumed to be inherited
+     \param excludes string array of exclude expressions
+     */
+    void PrefetchDirectories(std::span<const std::string> folders,
+                             ADDON::ContentType content,
+                             const std::vector<std::string>& excludes);
+
+    /*! \brief Take the prefetched result for a folder, waiting for it if necessary
+     \return the result or nullptr if the folder wasn't prefetched
+     */
+    std::unique_ptr<PrefetchedDirectory> TakePrefetchedDirectory(const std::string& directory);
+
     /*! \brief Process a series folder, filling in episode details and adding them to the database.
      @todo Ideally we would return InfoRet:HAVE_ALREADY if we don't have to update any episodes
      and we should return InfoRet::NOT_FOUND only if no information is found for any of
@@ -330,5 +379,7 @@ namespace KODI::VIDEO
     std::set<int> m_pathsToClean;
     std::shared_ptr<CAdvancedSettings> m_advancedSettings;
     CVideoDatabase::ScraperCache m_scraperCache;
+    unsigned int m_prefetchThreads{0};
+    std::map<std::string, std::future<std::unique_ptr<PrefetchedDirectory>>> m_prefetched;
   };
   } // namespace KODI::VIDEO